@@ -0,0 +1,65 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include "cache_reader.h"
+#include "corpus.h"
+#include "lmu_reader.h"
+#include "rpg_map.h"
+
+/**
+ * Map with large layers and many event commands.
+ */
+static Corpus::Options MapOptions(int size, int events) {
+	Corpus::Options options;
+	options.width = size;
+	options.height = size;
+	options.events = events;
+	options.pages = 2;
+	options.commands = 20;
+	return options;
+}
+
+template <class F>
+static double Best(int runs, F load) {
+	double best = 0.0;
+	for (int i = 0; i < runs; i++) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		load();
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		if (i == 0 || elapsed.count() < best)
+			best = elapsed.count();
+	}
+	return best;
+}
+
+int main(int argc, char** argv) {
+	int size = argc > 1 ? atoi(argv[1]) : 500;
+	int events = argc > 2 ? atoi(argv[2]) : 2000;
+	int runs = argc > 3 ? atoi(argv[3]) : 5;
+	const char* encoding = argc > 4 ? argv[4] : "932";
+	const char* filename = "bench_cache_read.lmu";
+	const char* cache = "bench_cache_read.cache";
+
+	{
+		Corpus::Options options = MapOptions(size, events);
+		options.japanese = true;
+		RPG::Map map;
+		Corpus::MakeMap(map, options);
+		LMU_Reader::Save(filename, map, encoding);
+		std::unique_ptr<RPG::Map> loaded = LMU_Reader::Load(filename, encoding);
+		Cache_Reader::SaveMap(cache, *loaded, filename);
+	}
+
+	double lmu = Best(runs, [&]() { LMU_Reader::Load(filename, encoding); });
+	double cached = Best(runs, [&]() { Cache_Reader::LoadMap(cache, filename); });
+
+	remove(filename);
+	remove(cache);
+
+	std::cout << size << "x" << size << " map, " << events << " events: "
+		<< "LMU_Reader::Load " << lmu * 1000.0 << " ms, "
+		<< "Cache_Reader::LoadMap " << cached * 1000.0 << " ms" << std::endl;
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,492 @@
+#ifndef LCF_BENCH_CORPUS_H
+#define LCF_BENCH_CORPUS_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "data.h"
+#include "rpg_database.h"
+#include "rpg_eventcommand.h"
+#include "rpg_map.h"
+#include "rpg_save.h"
+#include "rpg_treemap.h"
+
+/**
+ * Synthetic game data for benchmarks and stress tests.
+ *
+ * Everything is derived from a seed with a self-contained generator, so
+ * the same options produce byte-identical files on every platform.
+ */
+namespace Corpus {
+
+/**
+ * SplitMix64 random number generator.
+ */
+class Random {
+public:
+	explicit Random(unsigned long long seed) : state(seed) {}
+
+	uint32_t Next() {
+		state += 0x9E3779B97F4A7C15ULL;
+		unsigned long long z = state;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return (uint32_t) ((z ^ (z >> 31)) >> 32);
+	}
+
+	/** Uniform integer in [min, max]. */
+	int Range(int min, int max) {
+		return min + (int) (Next() % (uint32_t) (max - min + 1));
+	}
+
+	bool Chance(int percent) {
+		return (int) (Next() % 100) < percent;
+	}
+
+private:
+	unsigned long long state;
+};
+
+/**
+ * Size of the generated game.
+ */
+struct Options {
+	unsigned long long seed = 1;
+	/** Generate Japanese instead of English text. */
+	bool japanese = false;
+
+	// Database
+	int actors = 50;
+	int skills = 300;
+	int items = 300;
+	int enemies = 200;
+	int troops = 100;
+	int common_events = 200;
+	/** Commands per common event, troop page and event page. */
+	int commands = 50;
+
+	// Map tree and maps
+	int maps = 50;
+	int width = 100;
+	int height = 100;
+	int events = 200;
+	int pages = 2;
+
+	// Save
+	int pictures = 50;
+	int switches = 5000;
+	int variables = 5000;
+};
+
+static const char* const words_en[] = {
+	"the", "hero", "sword", "castle", "king", "dragon", "forest", "village",
+	"gold", "potion", "quest", "you", "must", "find", "ancient", "crystal",
+	"beyond", "mountains", "please", "help", "us", "thank", "welcome", "inn"
+};
+
+static const char* const words_ja[] = {
+	"\xe5\x8b\x87\xe8\x80\x85", "\xe5\x89\xa3", "\xe5\x9f\x8e", "\xe7\x8e\x8b",
+	"\xe3\x83\x89\xe3\x83\xa9\xe3\x82\xb4\xe3\x83\xb3", "\xe6\xa3\xae", "\xe6\x9d\x91",
+	"\xe3\x81\xaf", "\xe3\x82\x92", "\xe3\x81\xab", "\xe3\x81\xae", "\xe3\x81\xa7\xe3\x81\x99",
+	"\xe3\x81\x82\xe3\x82\x8a\xe3\x81\x8c\xe3\x81\xa8\xe3\x81\x86", "\xe3\x80\x82"
+};
+
+/**
+ * Generates a sentence.
+ */
+inline std::string Text(Random& rng, const Options& options, int min_words, int max_words) {
+	std::string text;
+	int count = rng.Range(min_words, max_words);
+	for (int i = 0; i < count; i++) {
+		if (options.japanese) {
+			text += words_ja[rng.Next() % (sizeof(words_ja) / sizeof(words_ja[0]))];
+		} else {
+			if (i > 0)
+				text += ' ';
+			text += words_en[rng.Next() % (sizeof(words_en) / sizeof(words_en[0]))];
+		}
+	}
+	return text;
+}
+
+/**
+ * Generates a name like "Item 12".
+ */
+inline std::string Name(const char* prefix, int id) {
+	return std::string(prefix) + " " + std::to_string(id);
+}
+
+inline void AddCommand(std::vector<RPG::EventCommand>& list, int code, int indent,
+		const std::string& string, const std::vector<int>& parameters) {
+	list.resize(list.size() + 1);
+	RPG::EventCommand& cmd = list.back();
+	cmd.code = code;
+	cmd.indent = indent;
+	cmd.string = string;
+	cmd.parameters = parameters;
+}
+
+/**
+ * Appends a block of commands with the nesting of the editor: every
+ * block body ends with an END command one level deeper.
+ */
+inline void AddCommands(std::vector<RPG::EventCommand>& list, Random& rng, const Options& options,
+		int indent, size_t target) {
+	typedef RPG::EventCommand::Code Cmd;
+
+	while (list.size() < target) {
+		int kind = rng.Range(0, 99);
+		if (kind < 30) {
+			AddCommand(list, Cmd::ShowMessage, indent, Text(rng, options, 3, 8), std::vector<int>());
+			int lines = rng.Range(0, 3);
+			for (int i = 0; i < lines; i++)
+				AddCommand(list, Cmd::ShowMessage_2, indent, Text(rng, options, 3, 8), std::vector<int>());
+		} else if (kind < 45) {
+			int id = rng.Range(1, options.switches);
+			AddCommand(list, Cmd::ControlSwitches, indent, "", { 0, id, id, rng.Range(0, 2) });
+		} else if (kind < 60) {
+			int id = rng.Range(1, options.variables);
+			AddCommand(list, Cmd::ControlVars, indent, "", { 0, id, id, rng.Range(0, 5), 0, rng.Range(-100, 100), 0 });
+		} else if (kind < 70 && indent < 3) {
+			bool has_else = rng.Chance(50);
+			AddCommand(list, Cmd::ConditionalBranch, indent, "", { 0, rng.Range(1, options.switches), 0, 0, 0, has_else ? 1 : 0 });
+			AddCommands(list, rng, options, indent + 1, list.size() + rng.Range(1, 4));
+			AddCommand(list, Cmd::END, indent + 1, "", std::vector<int>());
+			if (has_else) {
+				AddCommand(list, Cmd::ElseBranch, indent, "", std::vector<int>());
+				AddCommands(list, rng, options, indent + 1, list.size() + rng.Range(1, 3));
+				AddCommand(list, Cmd::END, indent + 1, "", std::vector<int>());
+			}
+			AddCommand(list, Cmd::EndBranch, indent, "", std::vector<int>());
+		} else if (kind < 74 && indent < 3) {
+			AddCommand(list, Cmd::ShowChoice, indent, "Yes/No", { 0 });
+			AddCommand(list, Cmd::ShowChoiceOption, indent, "Yes", { 0 });
+			AddCommands(list, rng, options, indent + 1, list.size() + rng.Range(1, 3));
+			AddCommand(list, Cmd::END, indent + 1, "", std::vector<int>());
+			AddCommand(list, Cmd::ShowChoiceOption, indent, "No", { 1 });
+			AddCommands(list, rng, options, indent + 1, list.size() + rng.Range(1, 3));
+			AddCommand(list, Cmd::END, indent + 1, "", std::vector<int>());
+			AddCommand(list, Cmd::ShowChoiceEnd, indent, "", std::vector<int>());
+		} else if (kind < 76 && indent < 3) {
+			AddCommand(list, Cmd::Loop, indent, "", std::vector<int>());
+			AddCommands(list, rng, options, indent + 1, list.size() + rng.Range(1, 3));
+			AddCommand(list, Cmd::BreakLoop, indent + 1, "", std::vector<int>());
+			AddCommand(list, Cmd::END, indent + 1, "", std::vector<int>());
+			AddCommand(list, Cmd::EndLoop, indent, "", std::vector<int>());
+		} else if (kind < 82) {
+			AddCommand(list, Cmd::Wait, indent, "", { rng.Range(1, 60) });
+		} else if (kind < 87) {
+			AddCommand(list, Cmd::PlaySound, indent, "Cursor1", { 100, 100, 50 });
+		} else if (kind < 91) {
+			AddCommand(list, Cmd::Teleport, indent, "", { rng.Range(1, options.maps), rng.Range(0, options.width - 1), rng.Range(0, options.height - 1), 0 });
+		} else if (kind < 95) {
+			std::vector<int> route = { 10005, rng.Range(1, 8), 0, 1 };
+			int steps = rng.Range(1, 10);
+			for (int i = 0; i < steps; i++)
+				route.push_back(rng.Range(0, 11));
+			AddCommand(list, Cmd::MoveEvent, indent, "", route);
+		} else {
+			AddCommand(list, Cmd::ChangeItems, indent, "", { 0, 0, rng.Range(1, options.items), 0, 0, rng.Range(1, 5) });
+		}
+	}
+}
+
+/**
+ * Generates an event command list that ends like the editor's lists.
+ */
+inline void MakeCommands(std::vector<RPG::EventCommand>& list, Random& rng, const Options& options, int count) {
+	list.clear();
+	AddCommands(list, rng, options, 0, count > 1 ? count - 1 : 0);
+	AddCommand(list, RPG::EventCommand::Code::END, 0, "", std::vector<int>());
+}
+
+/**
+ * Generates a database.
+ */
+inline void MakeDatabase(RPG::Database& db, const Options& options) {
+	Random rng(options.seed);
+	db = RPG::Database();
+
+	db.actors.resize(options.actors);
+	for (int i = 0; i < options.actors; i++) {
+		RPG::Actor& actor = db.actors[i];
+		actor.ID = i + 1;
+		actor.name = Name("Actor", i + 1);
+		actor.title = Text(rng, options, 1, 2);
+		actor.character_name = "Actor" + std::to_string(i % 4 + 1);
+		actor.character_index = i % 8;
+		actor.face_name = actor.character_name;
+		actor.face_index = i % 8;
+		actor.initial_level = rng.Range(1, 10);
+		actor.final_level = 99;
+		actor.exp_base = 300;
+		actor.exp_inflation = 300;
+		actor.parameters.Setup(actor.final_level);
+		actor.skills.resize(rng.Range(0, 10));
+		for (size_t j = 0; j < actor.skills.size(); j++) {
+			actor.skills[j].ID = j + 1;
+			actor.skills[j].level = rng.Range(1, 50);
+			actor.skills[j].skill_id = rng.Range(1, options.skills);
+		}
+	}
+
+	db.skills.resize(options.skills);
+	for (int i = 0; i < options.skills; i++) {
+		RPG::Skill& skill = db.skills[i];
+		skill.ID = i + 1;
+		skill.name = Name("Skill", i + 1);
+		skill.description = Text(rng, options, 4, 10);
+		skill.using_message1 = Text(rng, options, 2, 5);
+		skill.sp_cost = rng.Range(0, 50);
+		skill.power = rng.Range(0, 500);
+		skill.animation_id = rng.Range(1, 100);
+	}
+
+	db.items.resize(options.items);
+	for (int i = 0; i < options.items; i++) {
+		RPG::Item& item = db.items[i];
+		item.ID = i + 1;
+		item.name = Name("Item", i + 1);
+		item.description = Text(rng, options, 4, 10);
+		item.type = rng.Range(0, 10);
+		item.price = rng.Range(0, 9999);
+		item.recover_hp = rng.Range(0, 500);
+	}
+
+	db.enemies.resize(options.enemies);
+	for (int i = 0; i < options.enemies; i++) {
+		RPG::Enemy& enemy = db.enemies[i];
+		enemy.ID = i + 1;
+		enemy.name = Name("Enemy", i + 1);
+		enemy.battler_name = "Monster" + std::to_string(i % 20 + 1);
+		enemy.max_hp = rng.Range(10, 9999);
+		enemy.exp = rng.Range(0, 1000);
+		enemy.gold = rng.Range(0, 1000);
+	}
+
+	db.troops.resize(options.troops);
+	for (int i = 0; i < options.troops; i++) {
+		RPG::Troop& troop = db.troops[i];
+		troop.ID = i + 1;
+		troop.name = Name("Troop", i + 1);
+		troop.members.resize(rng.Range(1, 4));
+		for (size_t j = 0; j < troop.members.size(); j++) {
+			troop.members[j].ID = j + 1;
+			troop.members[j].enemy_id = rng.Range(1, options.enemies > 0 ? options.enemies : 1);
+			troop.members[j].x = rng.Range(0, 320);
+			troop.members[j].y = rng.Range(0, 160);
+		}
+		troop.pages.resize(rng.Range(0, 2));
+		for (size_t j = 0; j < troop.pages.size(); j++) {
+			troop.pages[j].ID = j + 1;
+			MakeCommands(troop.pages[j].event_commands, rng, options, options.commands / 4 + 1);
+		}
+	}
+
+	db.commonevents.resize(options.common_events);
+	for (int i = 0; i < options.common_events; i++) {
+		RPG::CommonEvent& event = db.commonevents[i];
+		event.ID = i + 1;
+		event.name = Name("Common", i + 1);
+		event.trigger = rng.Chance(20) ? 4 : 5;
+		MakeCommands(event.event_commands, rng, options, options.commands);
+	}
+
+	db.switches.resize(options.switches);
+	for (int i = 0; i < options.switches; i++) {
+		db.switches[i].ID = i + 1;
+		if (rng.Chance(30))
+			db.switches[i].name = Text(rng, options, 1, 3);
+	}
+	db.variables.resize(options.variables);
+	for (int i = 0; i < options.variables; i++) {
+		db.variables[i].ID = i + 1;
+		if (rng.Chance(30))
+			db.variables[i].name = Text(rng, options, 1, 3);
+	}
+
+	db.chipsets.resize(4);
+	for (size_t i = 0; i < db.chipsets.size(); i++) {
+		db.chipsets[i].ID = i + 1;
+		db.chipsets[i].name = Name("Chipset", i + 1);
+		db.chipsets[i].chipset_name = "World" + std::to_string(i + 1);
+	}
+
+	db.terms.gold = "G";
+	db.system.title_name = "Title";
+	db.system.system_name = "System";
+}
+
+/**
+ * Generates a map tree: maps attached at random to earlier maps, with
+ * an area below some of them.
+ */
+inline void MakeTreeMap(RPG::TreeMap& treemap, const Options& options) {
+	Random rng(options.seed + 1);
+	treemap = RPG::TreeMap();
+
+	RPG::MapInfo root;
+	root.ID = 0;
+	root.name = "Game";
+	root.type = 0;
+	treemap.maps.push_back(root);
+	treemap.tree_order.push_back(0);
+
+	int id = 1;
+	for (int i = 0; i < options.maps; i++) {
+		RPG::MapInfo info;
+		info.ID = id++;
+		info.name = Name("Map", info.ID);
+		info.type = 1;
+		info.parent_map = i == 0 ? 0 : rng.Range(0, i);
+		info.music_type = rng.Range(0, 2);
+		info.music.name = info.music_type == 2 ? "Field1" : "(OFF)";
+		info.teleport = rng.Range(0, 2);
+		info.escape = rng.Range(0, 2);
+		info.save = rng.Range(0, 2);
+		info.encounter_steps = rng.Range(0, 50);
+		treemap.maps.push_back(info);
+		treemap.tree_order.push_back(info.ID);
+
+		if (rng.Chance(30)) {
+			RPG::MapInfo area;
+			area.ID = id++;
+			area.name = Name("Area", area.ID);
+			area.type = 2;
+			area.parent_map = info.ID;
+			area.area_rect.l = rng.Range(0, options.width / 2);
+			area.area_rect.t = rng.Range(0, options.height / 2);
+			area.area_rect.r = area.area_rect.l + rng.Range(1, options.width / 2);
+			area.area_rect.b = area.area_rect.t + rng.Range(1, options.height / 2);
+			treemap.maps.push_back(area);
+			treemap.tree_order.push_back(area.ID);
+		}
+	}
+}
+
+/**
+ * Generates a map. Different ids give different maps of the same size.
+ */
+inline void MakeMap(RPG::Map& map, const Options& options, int id = 1) {
+	Random rng(options.seed * 1000003ULL + (unsigned long long) id);
+	map = RPG::Map();
+	map.chipset_id = rng.Range(1, 4);
+	map.width = options.width;
+	map.height = options.height;
+
+	// Patches of terrain over a grass floor
+	size_t tiles = (size_t) options.width * options.height;
+	map.lower_layer.assign(tiles, 5000);
+	map.upper_layer.assign(tiles, 10000);
+	for (size_t i = 0; i < tiles; i++) {
+		int kind = rng.Range(0, 99);
+		if (kind < 10)
+			map.lower_layer[i] = (int16_t) (rng.Range(0, 2) * 1000 + rng.Range(0, 49));
+		else if (kind < 20)
+			map.lower_layer[i] = (int16_t) (4000 + rng.Range(0, 11) * 50 + rng.Range(0, 46));
+		else if (kind < 50)
+			map.lower_layer[i] = (int16_t) (5000 + rng.Range(0, 143));
+		if (rng.Chance(15))
+			map.upper_layer[i] = (int16_t) (10000 + rng.Range(1, 143));
+	}
+
+	map.events.resize(options.events);
+	for (int i = 0; i < options.events; i++) {
+		RPG::Event& event = map.events[i];
+		event.ID = i + 1;
+		char name[16];
+		snprintf(name, sizeof(name), "EV%04d", i + 1);
+		event.name = name;
+		event.x = rng.Range(0, options.width - 1);
+		event.y = rng.Range(0, options.height - 1);
+		event.pages.resize(options.pages);
+		for (int p = 0; p < options.pages; p++) {
+			RPG::EventPage& page = event.pages[p];
+			page.ID = p + 1;
+			page.character_name = "Chara" + std::to_string(rng.Range(1, 8));
+			page.character_index = rng.Range(0, 7);
+			page.trigger = rng.Range(0, 4);
+			if (p > 0) {
+				page.condition.flags.switch_a = true;
+				page.condition.switch_a_id = rng.Range(1, options.switches);
+			}
+			if (rng.Chance(20)) {
+				page.move_type = 6;
+				int steps = rng.Range(1, 8);
+				for (int s = 0; s < steps; s++) {
+					RPG::MoveCommand move;
+					move.command_id = rng.Range(0, 11);
+					page.move_route.move_commands.push_back(move);
+				}
+			}
+			MakeCommands(page.event_commands, rng, options, options.commands);
+		}
+	}
+}
+
+/**
+ * Generates a save game.
+ */
+inline void MakeSave(RPG::Save& save, const Options& options) {
+	Random rng(options.seed + 2);
+	save = RPG::Save();
+
+	save.title.hero_name = "Actor 1";
+	save.system.switches.resize(options.switches);
+	for (int i = 0; i < options.switches; i++)
+		save.system.switches[i] = rng.Chance(50);
+	save.system.switches_size = options.switches;
+	save.system.variables.resize(options.variables);
+	for (int i = 0; i < options.variables; i++)
+		save.system.variables[i] = rng.Chance(50) ? 0 : rng.Range(-9999, 9999);
+	save.system.variables_size = options.variables;
+
+	save.pictures.resize(options.pictures);
+	for (int i = 0; i < options.pictures; i++) {
+		RPG::SavePicture& picture = save.pictures[i];
+		picture.ID = i + 1;
+		picture.name = "Picture" + std::to_string(rng.Range(1, 100));
+		picture.start_x = picture.current_x = picture.finish_x = rng.Range(0, 320);
+		picture.start_y = picture.current_y = picture.finish_y = rng.Range(0, 240);
+		picture.current_magnify = 100.0;
+	}
+
+	save.actors.resize(options.actors < 8 ? options.actors : 8);
+	for (size_t i = 0; i < save.actors.size(); i++) {
+		save.actors[i].ID = i + 1;
+		save.actors[i].name = Name("Actor", i + 1);
+		save.actors[i].level = rng.Range(1, 99);
+		save.actors[i].exp = rng.Range(0, 999999);
+	}
+
+	save.inventory.party.push_back(1);
+	save.inventory.party_size = 1;
+	int items = options.items < 100 ? options.items : 100;
+	for (int i = 0; i < items; i++) {
+		save.inventory.item_ids.push_back((int16_t) (i + 1));
+		save.inventory.item_counts.push_back((uint8_t) rng.Range(1, 99));
+		save.inventory.item_usage.push_back(0);
+	}
+	save.inventory.items_size = items;
+	save.inventory.gold = rng.Range(0, 99999);
+
+	save.map_info.events.resize(options.events);
+	for (int i = 0; i < options.events; i++) {
+		RPG::SaveMapEvent& event = save.map_info.events[i];
+		event.ID = i + 1;
+		event.position_x = rng.Range(0, options.width - 1);
+		event.position_y = rng.Range(0, options.height - 1);
+	}
+}
+
+/**
+ * Fills the global Data with a generated database and map tree.
+ */
+inline void MakeData(const Options& options) {
+	MakeDatabase(Data::data, options);
+	MakeTreeMap(Data::treemap, options);
+}
+
+}
+
+#endif
@@ -0,0 +1,141 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "corpus.h"
+#include "ldb_reader.h"
+#include "lmt_reader.h"
+#include "lmu_reader.h"
+#include "reader_lcf.h"
+#include "reader_struct.h"
+#include "writer_lcf.h"
+
+/*
+ * Writes a synthetic game for stress tests and benchmarks.
+ *
+ * Usage: bench_gen_corpus [options] [directory]
+ *
+ * Writes RPG_RT.ldb, RPG_RT.lmt, MapNNNN.lmu for every map and
+ * Save01.lsd to the directory (default: current directory). The same
+ * options always produce the same files.
+ */
+
+struct Option {
+	const char* name;
+	int Corpus::Options::*value;
+	/**
+	 * Smallest accepted value. Counts used as ID ranges need at least
+	 * one entry, map areas need a map of at least 2x2 tiles.
+	 */
+	int min;
+};
+
+static const Option int_options[] = {
+	{ "--actors", &Corpus::Options::actors, 0 },
+	{ "--skills", &Corpus::Options::skills, 1 },
+	{ "--items", &Corpus::Options::items, 1 },
+	{ "--enemies", &Corpus::Options::enemies, 0 },
+	{ "--troops", &Corpus::Options::troops, 0 },
+	{ "--common-events", &Corpus::Options::common_events, 0 },
+	{ "--commands", &Corpus::Options::commands, 0 },
+	{ "--maps", &Corpus::Options::maps, 1 },
+	{ "--width", &Corpus::Options::width, 2 },
+	{ "--height", &Corpus::Options::height, 2 },
+	{ "--events", &Corpus::Options::events, 0 },
+	{ "--pages", &Corpus::Options::pages, 0 },
+	{ "--pictures", &Corpus::Options::pictures, 0 },
+	{ "--switches", &Corpus::Options::switches, 1 },
+	{ "--variables", &Corpus::Options::variables, 1 }
+};
+
+static void Usage() {
+	std::cerr << "Usage: bench_gen_corpus [--seed N] [--japanese] [--encoding E]";
+	for (size_t i = 0; i < sizeof(int_options) / sizeof(int_options[0]); i++)
+		std::cerr << " [" << int_options[i].name << " N]";
+	std::cerr << " [directory]" << std::endl;
+}
+
+static bool Fail() {
+	std::cerr << LcfReader::GetError();
+	return false;
+}
+
+static bool Generate(const Corpus::Options& options, const std::string& dir, const std::string& encoding) {
+	Corpus::MakeData(options);
+	if (!LDB_Reader::Save(dir + "RPG_RT.ldb", encoding))
+		return Fail();
+	if (!LMT_Reader::Save(dir + "RPG_RT.lmt", encoding))
+		return Fail();
+
+	RPG::Map map;
+	for (int i = 1; i <= options.maps; i++) {
+		char name[32];
+		snprintf(name, sizeof(name), "Map%04d.lmu", i);
+		Corpus::MakeMap(map, options, i);
+		if (!LMU_Reader::Save(dir + name, map, encoding))
+			return Fail();
+	}
+
+	// LSD_Reader::Save stamps the current time, which would make the
+	// output differ between runs
+	RPG::Save save;
+	Corpus::MakeSave(save, options);
+	LcfWriter writer(dir + "Save01.lsd", encoding);
+	if (!writer.IsOk()) {
+		LcfReader::SetError("Couldn't find %sSave01.lsd save file.\n", dir.c_str());
+		return Fail();
+	}
+	const std::string header("LcfSaveData");
+	writer.WriteInt(header.size());
+	writer.Write(header);
+	Struct<RPG::Save>::WriteLcf(save, writer);
+	return true;
+}
+
+int main(int argc, char** argv) {
+	Corpus::Options options;
+	std::string encoding;
+	std::string dir;
+
+	for (int i = 1; i < argc; i++) {
+		bool has_value = i + 1 < argc;
+		bool found = false;
+		for (size_t j = 0; j < sizeof(int_options) / sizeof(int_options[0]); j++) {
+			if (strcmp(argv[i], int_options[j].name) == 0 && has_value) {
+				int value = atoi(argv[++i]);
+				if (value < int_options[j].min) {
+					std::cerr << int_options[j].name << " must be at least " << int_options[j].min << std::endl;
+					Usage();
+					return EXIT_FAILURE;
+				}
+				options.*int_options[j].value = value;
+				found = true;
+				break;
+			}
+		}
+		if (found)
+			continue;
+
+		if (strcmp(argv[i], "--seed") == 0 && has_value)
+			options.seed = strtoull(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "--japanese") == 0)
+			options.japanese = true;
+		else if (strcmp(argv[i], "--encoding") == 0 && has_value)
+			encoding = argv[++i];
+		else if (argv[i][0] == '-') {
+			Usage();
+			return EXIT_FAILURE;
+		} else
+			dir = argv[i];
+	}
+
+	if (!dir.empty() && dir[dir.size() - 1] != '/')
+		dir += '/';
+
+	if (!Generate(options, dir, encoding))
+		return EXIT_FAILURE;
+
+	std::cout << "Wrote " << options.maps << " maps to " << (dir.empty() ? "./" : dir) << std::endl;
+	return EXIT_SUCCESS;
+}
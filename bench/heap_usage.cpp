@@ -0,0 +1,92 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "corpus.h"
+#include "data.h"
+#include "heap_usage.h"
+#include "ldb_reader.h"
+#include "lmu_reader.h"
+#include "reader_lcf.h"
+
+/*
+ * Reports the heap memory of a loaded database and map per section and
+ * per struct type.
+ *
+ * Usage: bench_heap_usage [--encoding E] [RPG_RT.ldb [MapNNNN.lmu]]
+ *
+ * Without files a synthetic game is measured.
+ */
+
+static void PrintSections(const char* title, const std::vector<HeapUsage::Entry>& sections) {
+	unsigned long long total = 0;
+	for (size_t i = 0; i < sections.size(); i++)
+		total += sections[i].bytes;
+
+	std::cout << title << " sections" << std::endl;
+	char line[256];
+	for (size_t i = 0; i < sections.size(); i++) {
+		const HeapUsage::Entry& e = sections[i];
+		if (e.bytes == 0)
+			continue;
+		snprintf(line, sizeof(line), "  %-24s %12llu B %6.2f %% %10lu allocs %12llu B strings",
+			e.name.c_str(), e.bytes, total > 0 ? 100.0 * e.bytes / total : 0.0,
+			(unsigned long) e.allocations, e.string_bytes);
+		std::cout << line << std::endl;
+	}
+	snprintf(line, sizeof(line), "  %-24s %12llu B", "total", total);
+	std::cout << line << std::endl;
+}
+
+static void PrintTypes(const char* title, const HeapUsage& usage) {
+	std::cout << title << " types" << std::endl;
+	std::vector<HeapUsage::Entry> types = usage.Get();
+	char line[256];
+	for (size_t i = 0; i < types.size() && i < 15; i++) {
+		const HeapUsage::Entry& e = types[i];
+		snprintf(line, sizeof(line), "  %-24s %12llu B %10lu objects %10lu allocs %12llu B strings",
+			e.name.c_str(), e.bytes, (unsigned long) e.objects,
+			(unsigned long) e.allocations, e.string_bytes);
+		std::cout << line << std::endl;
+	}
+}
+
+int main(int argc, char** argv) {
+	std::string encoding;
+	std::vector<std::string> files;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--encoding") == 0 && i + 1 < argc)
+			encoding = argv[++i];
+		else
+			files.push_back(argv[i]);
+	}
+
+	std::unique_ptr<RPG::Map> map(new RPG::Map());
+	if (files.empty()) {
+		Corpus::Options options;
+		Corpus::MakeData(options);
+		Corpus::MakeMap(*map, options);
+	} else {
+		if (!LDB_Reader::Load(files[0], encoding)) {
+			std::cerr << LcfReader::GetError();
+			return EXIT_FAILURE;
+		}
+		if (files.size() > 1) {
+			map = LMU_Reader::Load(files[1], encoding);
+			if (!map) {
+				std::cerr << LcfReader::GetError();
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	PrintSections("Database", HeapUsage::Sections(Data::data));
+	PrintTypes("Database", HeapUsage::Of(Data::data));
+	PrintSections("Map", HeapUsage::Sections(*map));
+	PrintTypes("Map", HeapUsage::Of(*map));
+
+	return EXIT_SUCCESS;
+}
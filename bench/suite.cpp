@@ -0,0 +1,330 @@
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include "corpus.h"
+#include "data.h"
+#include "ldb_reader.h"
+#include "lmt_reader.h"
+#include "lmu_reader.h"
+#include "lsd_reader.h"
+#include "reader_stats.h"
+#include "reader_struct.h"
+#include "rpg_map.h"
+#include "rpg_save.h"
+
+/*
+ * Times load, save, LcfSize, XML export and XML import of LDB, LMT, LMU
+ * and LSD files.
+ *
+ * Usage: bench_suite [--json] [--runs N] [--encoding E] [--trace F] [files...]
+ *
+ * Without files a small synthetic game is written and measured.
+ * With --json every phase is printed as one JSON object per line.
+ * With --trace a Chrome trace of all runs is written to F, this needs
+ * liblcf built with LCF_INSTRUMENT.
+ */
+
+// Allocation counting
+
+static size_t alloc_count = 0;
+static size_t alloc_bytes = 0;
+
+void* operator new(size_t size) {
+	alloc_count++;
+	alloc_bytes += size;
+	void* p = malloc(size == 0 ? 1 : size);
+	if (p == NULL)
+		throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void* p) noexcept {
+	free(p);
+}
+
+static void CountAllocations(unsigned long long& count, unsigned long long& bytes) {
+	count = alloc_count;
+	bytes = alloc_bytes;
+}
+
+// Measurement
+
+struct Result {
+	std::string file;
+	std::string kind;
+	std::string phase;
+	long bytes;
+	double best_ms;
+	double mean_ms;
+	size_t allocs;
+	size_t alloc_bytes;
+};
+
+static long FileSize(const std::string& filename) {
+	FILE* f = fopen(filename.c_str(), "rb");
+	if (f == NULL)
+		return 0;
+	fseek(f, 0, SEEK_END);
+	long size = ftell(f);
+	fclose(f);
+	return size;
+}
+
+/**
+ * Runs a phase several times. Allocations are counted for one run.
+ */
+static Result Measure(const std::string& file, const std::string& kind, const std::string& phase,
+		int runs, const std::function<void()>& setup, const std::function<void()>& run) {
+	Result result;
+	result.file = file;
+	result.kind = kind;
+	result.phase = phase;
+	result.bytes = 0;
+	result.best_ms = 0.0;
+	result.mean_ms = 0.0;
+	result.allocs = 0;
+	result.alloc_bytes = 0;
+
+	for (int i = 0; i < runs; i++) {
+		setup();
+		size_t count = alloc_count;
+		size_t bytes = alloc_bytes;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		run();
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		if (i == 0) {
+			result.allocs = alloc_count - count;
+			result.alloc_bytes = alloc_bytes - bytes;
+		}
+		if (i == 0 || elapsed.count() < result.best_ms)
+			result.best_ms = elapsed.count();
+		result.mean_ms += elapsed.count() / runs;
+	}
+	return result;
+}
+
+static std::string JsonEscape(const std::string& str) {
+	std::string result;
+	for (size_t i = 0; i < str.size(); i++) {
+		if (str[i] == '"' || str[i] == '\\')
+			result += '\\';
+		result += str[i];
+	}
+	return result;
+}
+
+static void Print(const Result& r, bool json) {
+	double mb_s = r.best_ms > 0.0 ? r.bytes / (r.best_ms / 1000.0) / (1024.0 * 1024.0) : 0.0;
+	char line[512];
+	if (json) {
+		snprintf(line, sizeof(line),
+			"{\"file\":\"%s\",\"kind\":\"%s\",\"phase\":\"%s\",\"bytes\":%ld,"
+			"\"best_ms\":%.3f,\"mean_ms\":%.3f,\"mb_s\":%.2f,\"allocs\":%lu,\"alloc_bytes\":%lu}",
+			JsonEscape(r.file).c_str(), r.kind.c_str(), r.phase.c_str(), r.bytes,
+			r.best_ms, r.mean_ms, mb_s, (unsigned long) r.allocs, (unsigned long) r.alloc_bytes);
+	} else {
+		snprintf(line, sizeof(line), "%-28s %-4s %-10s %10ld B %9.3f ms %9.3f ms %9.2f MB/s %9lu allocs %11lu B",
+			r.file.c_str(), r.kind.c_str(), r.phase.c_str(), r.bytes,
+			r.best_ms, r.mean_ms, mb_s, (unsigned long) r.allocs, (unsigned long) r.alloc_bytes);
+	}
+	std::cout << line << std::endl;
+}
+
+// Phases per file type
+
+static const char* const out_lcf = "bench_suite.out";
+static const char* const out_xml = "bench_suite.xml";
+
+static void NoSetup() {}
+
+static void BenchDatabase(const std::string& file, const std::string& encoding, int runs, std::vector<Result>& results) {
+	Data::Clear();
+	LDB_Reader::Load(file, encoding);
+	long size = FileSize(file);
+
+	results.push_back(Measure(file, "LDB", "load", runs, Data::Clear, [&]() { LDB_Reader::Load(file, encoding); }));
+	results.back().bytes = size;
+	results.push_back(Measure(file, "LDB", "save", runs, NoSetup, [&]() { LDB_Reader::Save(out_lcf, encoding); }));
+	results.back().bytes = FileSize(out_lcf);
+	results.push_back(Measure(file, "LDB", "lcfsize", runs, NoSetup, [&]() {
+		LcfWriter writer(out_lcf, encoding);
+		TypeReader<RPG::Database>::LcfSize(Data::data, writer);
+	}));
+	results.back().bytes = size;
+	results.push_back(Measure(file, "LDB", "xml_export", runs, NoSetup, [&]() { LDB_Reader::SaveXml(out_xml); }));
+	results.back().bytes = FileSize(out_xml);
+	results.push_back(Measure(file, "LDB", "xml_import", runs, Data::Clear, [&]() { LDB_Reader::LoadXml(out_xml); }));
+	results.back().bytes = FileSize(out_xml);
+}
+
+static void BenchTreeMap(const std::string& file, const std::string& encoding, int runs, std::vector<Result>& results) {
+	std::function<void()> clear = []() { Data::treemap = RPG::TreeMap(); };
+	clear();
+	LMT_Reader::Load(file, encoding);
+	long size = FileSize(file);
+
+	results.push_back(Measure(file, "LMT", "load", runs, clear, [&]() { LMT_Reader::Load(file, encoding); }));
+	results.back().bytes = size;
+	results.push_back(Measure(file, "LMT", "save", runs, NoSetup, [&]() { LMT_Reader::Save(out_lcf, encoding); }));
+	results.back().bytes = FileSize(out_lcf);
+	results.push_back(Measure(file, "LMT", "lcfsize", runs, NoSetup, [&]() {
+		LcfWriter writer(out_lcf, encoding);
+		TypeReader<RPG::TreeMap>::LcfSize(Data::treemap, writer);
+	}));
+	results.back().bytes = size;
+	results.push_back(Measure(file, "LMT", "xml_export", runs, NoSetup, [&]() { LMT_Reader::SaveXml(out_xml); }));
+	results.back().bytes = FileSize(out_xml);
+	results.push_back(Measure(file, "LMT", "xml_import", runs, clear, [&]() { LMT_Reader::LoadXml(out_xml); }));
+	results.back().bytes = FileSize(out_xml);
+}
+
+static void BenchMap(const std::string& file, const std::string& encoding, int runs, std::vector<Result>& results) {
+	std::unique_ptr<RPG::Map> map = LMU_Reader::Load(file, encoding);
+	if (!map) {
+		std::cerr << LcfReader::GetError();
+		return;
+	}
+	long size = FileSize(file);
+
+	results.push_back(Measure(file, "LMU", "load", runs, NoSetup, [&]() { LMU_Reader::Load(file, encoding); }));
+	results.back().bytes = size;
+	results.push_back(Measure(file, "LMU", "save", runs, NoSetup, [&]() { LMU_Reader::Save(out_lcf, *map, encoding); }));
+	results.back().bytes = FileSize(out_lcf);
+	results.push_back(Measure(file, "LMU", "lcfsize", runs, NoSetup, [&]() {
+		LcfWriter writer(out_lcf, encoding);
+		Struct<RPG::Map>::LcfSize(*map, writer);
+	}));
+	results.back().bytes = size;
+	results.push_back(Measure(file, "LMU", "xml_export", runs, NoSetup, [&]() { LMU_Reader::SaveXml(out_xml, *map); }));
+	results.back().bytes = FileSize(out_xml);
+	results.push_back(Measure(file, "LMU", "xml_import", runs, NoSetup, [&]() { LMU_Reader::LoadXml(out_xml); }));
+	results.back().bytes = FileSize(out_xml);
+}
+
+static void BenchSave(const std::string& file, const std::string& encoding, int runs, std::vector<Result>& results) {
+	std::unique_ptr<RPG::Save> save = LSD_Reader::Load(file, encoding);
+	if (!save) {
+		std::cerr << LcfReader::GetError();
+		return;
+	}
+	long size = FileSize(file);
+
+	results.push_back(Measure(file, "LSD", "load", runs, NoSetup, [&]() { LSD_Reader::Load(file, encoding); }));
+	results.back().bytes = size;
+	results.push_back(Measure(file, "LSD", "save", runs, NoSetup, [&]() { LSD_Reader::Save(out_lcf, *save, encoding); }));
+	results.back().bytes = FileSize(out_lcf);
+	results.push_back(Measure(file, "LSD", "lcfsize", runs, NoSetup, [&]() {
+		LcfWriter writer(out_lcf, encoding);
+		Struct<RPG::Save>::LcfSize(*save, writer);
+	}));
+	results.back().bytes = size;
+	results.push_back(Measure(file, "LSD", "xml_export", runs, NoSetup, [&]() { LSD_Reader::SaveXml(out_xml, *save); }));
+	results.back().bytes = FileSize(out_xml);
+	results.push_back(Measure(file, "LSD", "xml_import", runs, NoSetup, [&]() { LSD_Reader::LoadXml(out_xml); }));
+	results.back().bytes = FileSize(out_xml);
+}
+
+// Synthetic game for runs without input files
+
+static void MakeGame(const std::string& ldb, const std::string& lmt, const std::string& lmu, const std::string& lsd) {
+	Corpus::Options options;
+	options.maps = 300;
+	options.width = 200;
+	options.height = 200;
+	options.events = 300;
+	options.switches = 1000;
+	options.variables = 1000;
+
+	Corpus::MakeData(options);
+	LDB_Reader::Save(ldb, "");
+	LMT_Reader::Save(lmt, "");
+
+	RPG::Map map;
+	Corpus::MakeMap(map, options);
+	LMU_Reader::Save(lmu, map, "");
+
+	RPG::Save save;
+	Corpus::MakeSave(save, options);
+	LSD_Reader::Save(lsd, save, "");
+}
+
+static std::string Extension(const std::string& file) {
+	size_t dot = file.find_last_of('.');
+	std::string ext = dot == std::string::npos ? "" : file.substr(dot + 1);
+	std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+	return ext;
+}
+
+int main(int argc, char** argv) {
+	bool json = false;
+	int runs = 5;
+	std::string encoding;
+	std::string trace;
+	std::vector<std::string> files;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--json") == 0)
+			json = true;
+		else if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc)
+			runs = std::max(1, atoi(argv[++i]));
+		else if (strcmp(argv[i], "--encoding") == 0 && i + 1 < argc)
+			encoding = argv[++i];
+		else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+			trace = argv[++i];
+		else
+			files.push_back(argv[i]);
+	}
+
+	bool synthetic = files.empty();
+	if (synthetic) {
+		files.push_back("bench_suite.ldb");
+		files.push_back("bench_suite.lmt");
+		files.push_back("bench_suite.lmu");
+		files.push_back("bench_suite.lsd");
+		MakeGame(files[0], files[1], files[2], files[3]);
+	}
+
+	if (!trace.empty() && !ReaderStats::IsEnabled())
+		std::cerr << "liblcf was built without LCF_INSTRUMENT, the trace will be empty" << std::endl;
+	ReaderStats::Reset();
+	ReaderStats::SetAllocationCounter(CountAllocations);
+
+	std::vector<Result> results;
+	for (size_t i = 0; i < files.size(); i++) {
+		const std::string ext = Extension(files[i]);
+		if (ext == "ldb")
+			BenchDatabase(files[i], encoding, runs, results);
+		else if (ext == "lmt")
+			BenchTreeMap(files[i], encoding, runs, results);
+		else if (ext == "lmu")
+			BenchMap(files[i], encoding, runs, results);
+		else if (ext == "lsd")
+			BenchSave(files[i], encoding, runs, results);
+		else
+			std::cerr << "Skipping " << files[i] << ": unknown file type" << std::endl;
+	}
+
+	for (size_t i = 0; i < results.size(); i++)
+		Print(results[i], json);
+
+	if (!trace.empty() && !ReaderStats::WriteTrace(trace))
+		std::cerr << "Couldn't write " << trace << std::endl;
+
+	remove(out_lcf);
+	remove(out_xml);
+	if (synthetic) {
+		for (size_t i = 0; i < files.size(); i++)
+			remove(files[i].c_str());
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,56 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include "corpus.h"
+#include "lmu_reader.h"
+#include "rpg_map.h"
+
+/**
+ * Map with large layers and many event commands.
+ */
+static Corpus::Options MapOptions(int size, int events) {
+	Corpus::Options options;
+	options.width = size;
+	options.height = size;
+	options.events = events;
+	options.pages = 2;
+	options.commands = 20;
+	return options;
+}
+
+int main(int argc, char** argv) {
+	int size = argc > 1 ? atoi(argv[1]) : 500;
+	int events = argc > 2 ? atoi(argv[2]) : 2000;
+	int runs = argc > 3 ? atoi(argv[3]) : 5;
+	const char* filename = "bench_xml_read.emu";
+
+	{
+		RPG::Map map;
+		Corpus::MakeMap(map, MapOptions(size, events));
+		LMU_Reader::SaveXml(filename, map);
+	}
+
+	double best = 0.0;
+	size_t tiles = 0;
+	for (int i = 0; i < runs; i++) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::unique_ptr<RPG::Map> map = LMU_Reader::LoadXml(filename);
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		if (i == 0 || elapsed.count() < best)
+			best = elapsed.count();
+		tiles = map->lower_layer.size();
+	}
+
+	FILE* f = fopen(filename, "rb");
+	fseek(f, 0, SEEK_END);
+	long bytes = ftell(f);
+	fclose(f);
+	remove(filename);
+
+	std::cout << "LoadXml " << size << "x" << size << " map, " << events << " events: "
+		<< tiles << " tiles, " << bytes << " bytes, " << best * 1000.0 << " ms, "
+		<< bytes / best / (1024.0 * 1024.0) << " MB/s" << std::endl;
+
+	return EXIT_SUCCESS;
+}
@@ -51,6 +51,7 @@ cpp_types = {
     'UInt32': 'uint32_t',
     'Int16': 'int16_t',
     'String': 'std::string',
+    'SharedString': 'SharedString',
     }
 
 def flags_def(struct_name):
@@ -61,6 +62,10 @@ def cpp_type(ty, prefix = True, expand_flags = None):
     if ty in cpp_types:
         return cpp_types[ty]
 
+    m = re.match(r'SmallVector<(.*):(.*)>', ty)
+    if m:
+        return 'SmallVector<%s, %s>' % (cpp_type(m.group(1), prefix, expand_flags), m.group(2))
+
     m = re.match(r'Array<(.*):(.*)>', ty)
     if m:
         return 'std::vector<%s>' % cpp_type(m.group(1), prefix, expand_flags)
@@ -107,6 +112,9 @@ def struct_headers(ty, header_map):
     if ty == 'String':
         return ['<string>']
 
+    if ty == 'SharedString':
+        return ['"shared_string.h"']
+
     if ty in int_types:
         return ['"reader_types.h"']
 
@@ -126,6 +134,10 @@ def struct_headers(ty, header_map):
     if re.match(r'(.*)_Flags$', ty):
         return []
 
+    m = re.match(r'SmallVector<(.*):(.*)>', ty)
+    if m:
+        return ['"small_vector.h"'] + struct_headers(m.group(1), header_map)
+
     m = re.match(r'Array<(.*):(.*)>', ty)
     if m:
         return ['<vector>'] + struct_headers(m.group(1), header_map)
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <utility>
+#include "area_index.h"
+
+namespace {
+	/** Tiles per cell side. */
+	const int cell_size = 8;
+	/** Maps are at most 500 tiles wide, rects beyond go to the last cell. */
+	const int max_extent = 512;
+	/** MapInfo type of areas. */
+	const int area_type = 2;
+}
+
+static int CellOf(uint32_t tile) {
+	return (int) std::min<uint32_t>(tile, max_extent - 1) / cell_size;
+}
+
+static bool Contains(const RPG::Rect& rect, int x, int y) {
+	return x >= 0 && y >= 0 &&
+		(uint32_t) x >= rect.l && (uint32_t) x < rect.r &&
+		(uint32_t) y >= rect.t && (uint32_t) y < rect.b;
+}
+
+AreaIndex::AreaIndex() : treemap(NULL) {
+}
+
+AreaIndex::AreaIndex(const RPG::TreeMap& treemap) : treemap(NULL) {
+	Build(treemap);
+}
+
+void AreaIndex::Build(const RPG::TreeMap& treemap) {
+	this->treemap = &treemap;
+	const std::vector<RPG::MapInfo>& maps = treemap.maps;
+
+	positions.clear();
+	for (int i = 0; i < (int) maps.size(); i++)
+		positions.insert(std::make_pair(maps[i].ID, i));
+
+	// Areas per parent map, empty rects can't contain a tile
+	std::unordered_map<int, std::vector<int> > areas;
+	for (int i = 0; i < (int) maps.size(); i++) {
+		const RPG::MapInfo& info = maps[i];
+		if (info.type != area_type || info.area_rect.r <= info.area_rect.l || info.area_rect.b <= info.area_rect.t)
+			continue;
+		areas[info.parent_map].push_back(i);
+	}
+
+	grids.clear();
+	std::unordered_map<int, std::vector<int> >::const_iterator it;
+	for (it = areas.begin(); it != areas.end(); ++it) {
+		const std::vector<int>& list = it->second;
+		Grid& grid = grids[it->first];
+
+		grid.columns = 1;
+		grid.rows = 1;
+		for (size_t i = 0; i < list.size(); i++) {
+			const RPG::Rect& rect = maps[list[i]].area_rect;
+			grid.columns = std::max(grid.columns, CellOf(rect.r - 1) + 1);
+			grid.rows = std::max(grid.rows, CellOf(rect.b - 1) + 1);
+		}
+
+		// Count, then fill the ranges of each cell
+		const int cells = grid.columns * grid.rows;
+		grid.offsets.assign(cells + 1, 0);
+		for (int pass = 0; pass < 2; pass++) {
+			for (size_t i = 0; i < list.size(); i++) {
+				const RPG::Rect& rect = maps[list[i]].area_rect;
+				for (int y = CellOf(rect.t); y <= CellOf(rect.b - 1); y++) {
+					for (int x = CellOf(rect.l); x <= CellOf(rect.r - 1); x++) {
+						int cell = y * grid.columns + x;
+						if (pass == 0)
+							grid.offsets[cell + 1]++;
+						else
+							grid.areas[grid.offsets[cell]++] = list[i];
+					}
+				}
+			}
+			if (pass == 0) {
+				for (int cell = 0; cell < cells; cell++)
+					grid.offsets[cell + 1] += grid.offsets[cell];
+				grid.areas.resize(grid.offsets[cells]);
+			} else {
+				// Filling moved every start to the next cell
+				for (int cell = cells; cell > 0; cell--)
+					grid.offsets[cell] = grid.offsets[cell - 1];
+				grid.offsets[0] = 0;
+			}
+		}
+	}
+}
+
+void AreaIndex::GetAreas(int map_id, int x, int y, std::vector<const RPG::MapInfo*>& areas) const {
+	areas.clear();
+	if (x < 0 || y < 0)
+		return;
+	std::unordered_map<int, Grid>::const_iterator it = grids.find(map_id);
+	if (it == grids.end())
+		return;
+
+	const Grid& grid = it->second;
+	int column = CellOf(x);
+	int row = CellOf(y);
+	if (column >= grid.columns || row >= grid.rows)
+		return;
+
+	int cell = row * grid.columns + column;
+	for (uint32_t i = grid.offsets[cell]; i < grid.offsets[cell + 1]; i++) {
+		const RPG::MapInfo& area = treemap->maps[grid.areas[i]];
+		if (Contains(area.area_rect, x, y))
+			areas.push_back(&area);
+	}
+}
+
+void AreaIndex::GetTroops(int map_id, int x, int y, std::vector<int>& troops) const {
+	troops.clear();
+	std::unordered_map<int, int>::const_iterator it = positions.find(map_id);
+	if (it == positions.end())
+		return;
+
+	const std::vector<RPG::Encounter>& encounters = treemap->maps[it->second].encounters;
+	for (size_t i = 0; i < encounters.size(); i++)
+		troops.push_back(encounters[i].troop_id);
+
+	std::vector<const RPG::MapInfo*> areas;
+	GetAreas(map_id, x, y, areas);
+	for (size_t i = 0; i < areas.size(); i++) {
+		for (size_t j = 0; j < areas[i]->encounters.size(); j++)
+			troops.push_back(areas[i]->encounters[j].troop_id);
+	}
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#ifndef LCF_AREA_INDEX_H
+#define LCF_AREA_INDEX_H
+
+#include <unordered_map>
+#include <vector>
+#include "reader_types.h"
+#include "rpg_treemap.h"
+
+/**
+ * Finds the areas of a map containing a tile.
+ *
+ * Areas are map tree entries of type 2 below a map. Their area_rect
+ * covers the tiles from (l, t) up to, but not including, (r, b). The
+ * index divides every map with areas into cells of 8x8 tiles and keeps
+ * the areas overlapping each cell, so a lookup only checks the few areas
+ * near the tile.
+ *
+ * The index refers to the map tree it was built from and must be rebuilt
+ * when maps are added, removed or their area_rect changes.
+ */
+class AreaIndex {
+public:
+	AreaIndex();
+	explicit AreaIndex(const RPG::TreeMap& treemap);
+
+	/**
+	 * Indexes the areas of all maps of a map tree.
+	 */
+	void Build(const RPG::TreeMap& treemap);
+
+	/**
+	 * Returns the areas of a map containing a tile, in the order of the
+	 * maps vector.
+	 *
+	 * @param map_id ID of the map.
+	 * @param x tile x position.
+	 * @param y tile y position.
+	 * @param areas receives the areas.
+	 */
+	void GetAreas(int map_id, int x, int y, std::vector<const RPG::MapInfo*>& areas) const;
+
+	/**
+	 * Returns the troops that can be encountered on a tile: the troops of
+	 * the map itself followed by the troops of the areas containing the
+	 * tile. Troops listed more than once are returned more than once.
+	 *
+	 * @param map_id ID of the map.
+	 * @param x tile x position.
+	 * @param y tile y position.
+	 * @param troops receives the troop IDs.
+	 */
+	void GetTroops(int map_id, int x, int y, std::vector<int>& troops) const;
+
+private:
+	/** Areas per cell of one map, stored as consecutive ranges. */
+	struct Grid {
+		int columns;
+		int rows;
+		/** Start of the areas of each cell in areas, one more than cells. */
+		std::vector<uint32_t> offsets;
+		/** Positions in the maps vector. */
+		std::vector<int> areas;
+	};
+
+	const RPG::TreeMap* treemap;
+	/** Position in maps per map ID. */
+	std::unordered_map<int, int> positions;
+	/** Grid per ID of a map with areas. */
+	std::unordered_map<int, Grid> grids;
+};
+
+#endif
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "cache_reader.h"
+#include "data.h"
+#include "reader_lcf.h"
+#include "reader_mmap.h"
+#include "reader_struct.h"
+
+// File layout: magic, version, kind, source size and mtime (each as two
+// little-endian uint32, low word first), followed by the LCF chunks of
+// the cached struct with UTF-8 strings.
+
+static const char cache_magic[8] = { 'L', 'c', 'f', 'C', 'a', 'c', 'h', 'e' };
+
+/**
+ * Cache format version. Increase when the layout or the meaning of
+ * cached fields changes, old caches are then rebuilt.
+ */
+static const uint32_t cache_version = 1;
+
+enum CacheKind {
+	CacheDatabase = 1,
+	CacheTreeMap = 2,
+	CacheMap = 3
+};
+
+/**
+ * Size and modification time of the game file a cache belongs to.
+ */
+struct SourceStamp {
+	unsigned long long size;
+	unsigned long long mtime;
+};
+
+static bool GetSourceStamp(const std::string& source, SourceStamp& stamp) {
+	struct stat st;
+	if (stat(source.c_str(), &st) != 0) {
+		LcfReader::SetError("Couldn't find %s source file of the cache.\n", source.c_str());
+		return false;
+	}
+	stamp.size = (unsigned long long) st.st_size;
+	stamp.mtime = (unsigned long long) st.st_mtime;
+	return true;
+}
+
+static void WriteWide(LcfWriter& writer, unsigned long long val) {
+	writer.Write<uint32_t>((uint32_t) (val & 0xFFFFFFFFU));
+	writer.Write<uint32_t>((uint32_t) (val >> 32));
+}
+
+static unsigned long long ReadWide(LcfReader& reader) {
+	uint32_t low = 0;
+	uint32_t high = 0;
+	reader.Read(low);
+	reader.Read(high);
+	return ((unsigned long long) high << 32) | low;
+}
+
+static bool WriteHeader(LcfWriter& writer, CacheKind kind, const SourceStamp& stamp, const std::string& filename) {
+	if (!writer.IsOk()) {
+		LcfReader::SetError("Couldn't open %s cache file.\n", filename.c_str());
+		return false;
+	}
+	writer.Write(cache_magic, 1, sizeof(cache_magic));
+	writer.Write<uint32_t>(cache_version);
+	writer.Write<uint32_t>((uint32_t) kind);
+	WriteWide(writer, stamp.size);
+	WriteWide(writer, stamp.mtime);
+	return true;
+}
+
+static bool ReadHeader(LcfReader& reader, uint32_t& kind, const std::string& filename, const std::string& source) {
+	char magic[sizeof(cache_magic)];
+	uint32_t version = 0;
+	if (reader.Read0(magic, 1, sizeof(magic)) != sizeof(magic) ||
+		memcmp(magic, cache_magic, sizeof(magic)) != 0) {
+		LcfReader::SetError("%s is not a valid cache file.\n", filename.c_str());
+		return false;
+	}
+	reader.Read(version);
+	reader.Read(kind);
+	if (version != cache_version) {
+		LcfReader::SetError("%s is a cache of a different version.\n", filename.c_str());
+		return false;
+	}
+
+	SourceStamp stamp;
+	if (!GetSourceStamp(source, stamp))
+		return false;
+	unsigned long long size = ReadWide(reader);
+	unsigned long long mtime = ReadWide(reader);
+	if (reader.Eof() || size != stamp.size || mtime != stamp.mtime) {
+		LcfReader::SetError("%s is outdated.\n", filename.c_str());
+		return false;
+	}
+	return true;
+}
+
+static bool ReadHeader(LcfReader& reader, CacheKind kind, const std::string& filename, const std::string& source) {
+	uint32_t file_kind = 0;
+	if (!ReadHeader(reader, file_kind, filename, source))
+		return false;
+	if (file_kind != (uint32_t) kind) {
+		LcfReader::SetError("%s is a cache of a different kind.\n", filename.c_str());
+		return false;
+	}
+	return true;
+}
+
+static bool OpenCache(MappedFile& file, const std::string& filename) {
+	if (!file.Open(filename)) {
+		LcfReader::SetError("Couldn't find %s cache file.\n", filename.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool Cache_Reader::IsValid(const std::string& filename, const std::string& source) {
+	MappedFile file;
+	if (!OpenCache(file, filename))
+		return false;
+	LcfReader reader(file.Data(), file.Size());
+	uint32_t kind = 0;
+	return ReadHeader(reader, kind, filename, source);
+}
+
+bool Cache_Reader::LoadDatabase(const std::string& filename, const std::string& source) {
+	return LoadDatabase(filename, source, Data::data);
+}
+
+bool Cache_Reader::LoadDatabase(const std::string& filename, const std::string& source, RPG::Database& db) {
+	MappedFile file;
+	if (!OpenCache(file, filename))
+		return false;
+	LcfReader reader(file.Data(), file.Size());
+	if (!ReadHeader(reader, CacheDatabase, filename, source))
+		return false;
+	TypeReader<RPG::Database>::ReadLcf(db, reader, 0);
+
+	// Same as LDB_Reader::Load, cached actors already have their
+	// engine dependent defaults so this changes nothing for them
+	std::vector<RPG::Actor>::iterator it;
+	for (it = db.actors.begin(); it != db.actors.end(); ++it) {
+		(*it).Setup(db.system);
+	}
+	return true;
+}
+
+bool Cache_Reader::SaveDatabase(const std::string& filename, const std::string& source) {
+	return SaveDatabase(filename, Data::data, source);
+}
+
+bool Cache_Reader::SaveDatabase(const std::string& filename, const RPG::Database& db, const std::string& source) {
+	SourceStamp stamp;
+	if (!GetSourceStamp(source, stamp))
+		return false;
+	LcfWriter writer(filename, "");
+	if (!WriteHeader(writer, CacheDatabase, stamp, filename))
+		return false;
+	TypeReader<RPG::Database>::WriteLcf(db, writer);
+	return true;
+}
+
+bool Cache_Reader::LoadTreeMap(const std::string& filename, const std::string& source) {
+	return LoadTreeMap(filename, source, Data::treemap);
+}
+
+bool Cache_Reader::LoadTreeMap(const std::string& filename, const std::string& source, RPG::TreeMap& treemap) {
+	MappedFile file;
+	if (!OpenCache(file, filename))
+		return false;
+	LcfReader reader(file.Data(), file.Size());
+	if (!ReadHeader(reader, CacheTreeMap, filename, source))
+		return false;
+	TypeReader<RPG::TreeMap>::ReadLcf(treemap, reader, 0);
+	return true;
+}
+
+bool Cache_Reader::SaveTreeMap(const std::string& filename, const std::string& source) {
+	return SaveTreeMap(filename, Data::treemap, source);
+}
+
+bool Cache_Reader::SaveTreeMap(const std::string& filename, const RPG::TreeMap& treemap, const std::string& source) {
+	SourceStamp stamp;
+	if (!GetSourceStamp(source, stamp))
+		return false;
+	LcfWriter writer(filename, "");
+	if (!WriteHeader(writer, CacheTreeMap, stamp, filename))
+		return false;
+	TypeReader<RPG::TreeMap>::WriteLcf(treemap, writer);
+	return true;
+}
+
+std::unique_ptr<RPG::Map> Cache_Reader::LoadMap(const std::string& filename, const std::string& source) {
+	MappedFile file;
+	if (!OpenCache(file, filename))
+		return std::unique_ptr<RPG::Map>();
+	LcfReader reader(file.Data(), file.Size());
+	if (!ReadHeader(reader, CacheMap, filename, source))
+		return std::unique_ptr<RPG::Map>();
+
+	RPG::Map* map = new RPG::Map();
+	Struct<RPG::Map>::ReadLcf(*map, reader);
+	return std::unique_ptr<RPG::Map>(map);
+}
+
+bool Cache_Reader::SaveMap(const std::string& filename, const RPG::Map& map, const std::string& source) {
+	SourceStamp stamp;
+	if (!GetSourceStamp(source, stamp))
+		return false;
+	LcfWriter writer(filename, "");
+	if (!WriteHeader(writer, CacheMap, stamp, filename))
+		return false;
+	Struct<RPG::Map>::WriteLcf(map, writer);
+	return true;
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#ifndef LCF_CACHE_READER_H
+#define LCF_CACHE_READER_H
+
+#include <string>
+#include <memory>
+#include "rpg_database.h"
+#include "rpg_map.h"
+#include "rpg_treemap.h"
+
+/**
+ * Cache Reader namespace.
+ *
+ * A cache file holds a database, map tree or map that was already
+ * loaded from the game files. Strings are stored in UTF-8 so loading
+ * needs no charset conversion, and the file is read through a memory
+ * mapping.
+ *
+ * Every cache records the size and modification time of the game file
+ * it was created from. Loading fails when they no longer match, the
+ * caller then loads the game file and saves a new cache.
+ */
+namespace Cache_Reader {
+
+	/**
+	 * Checks if a cache was created by this version of liblcf from
+	 * the current version of a game file.
+	 *
+	 * @param filename cache file.
+	 * @param source game file the cache was created from.
+	 * @return true if the cache can be loaded.
+	 */
+	bool IsValid(const std::string& filename, const std::string& source);
+
+	/**
+	 * Loads Database from a cache into Data::data.
+	 */
+	bool LoadDatabase(const std::string& filename, const std::string& source);
+
+	/**
+	 * Loads Database from a cache into db.
+	 */
+	bool LoadDatabase(const std::string& filename, const std::string& source, RPG::Database& db);
+
+	/**
+	 * Saves Database from Data::data to a cache.
+	 */
+	bool SaveDatabase(const std::string& filename, const std::string& source);
+
+	/**
+	 * Saves Database from db to a cache.
+	 */
+	bool SaveDatabase(const std::string& filename, const RPG::Database& db, const std::string& source);
+
+	/**
+	 * Loads map tree from a cache into Data::treemap.
+	 */
+	bool LoadTreeMap(const std::string& filename, const std::string& source);
+
+	/**
+	 * Loads map tree from a cache into treemap.
+	 */
+	bool LoadTreeMap(const std::string& filename, const std::string& source, RPG::TreeMap& treemap);
+
+	/**
+	 * Saves map tree from Data::treemap to a cache.
+	 */
+	bool SaveTreeMap(const std::string& filename, const std::string& source);
+
+	/**
+	 * Saves map tree from treemap to a cache.
+	 */
+	bool SaveTreeMap(const std::string& filename, const RPG::TreeMap& treemap, const std::string& source);
+
+	/**
+	 * Loads map from a cache.
+	 */
+	std::unique_ptr<RPG::Map> LoadMap(const std::string& filename, const std::string& source);
+
+	/**
+	 * Saves map to a cache.
+	 */
+	bool SaveMap(const std::string& filename, const RPG::Map& map, const std::string& source);
+}
+
+#endif
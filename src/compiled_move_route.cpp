@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#include "compiled_move_route.h"
+
+int MoveRouteStrings::Intern(const std::string& str) {
+	std::unordered_map<std::string, int>::const_iterator it = ids.find(str);
+	if (it != ids.end())
+		return it->second;
+	int id = (int) strings.size();
+	strings.push_back(str);
+	ids.insert(std::make_pair(str, id));
+	return id;
+}
+
+const std::string& MoveRouteStrings::Get(int id) const {
+	return strings[id];
+}
+
+size_t MoveRouteStrings::Size() const {
+	return strings.size();
+}
+
+void MoveRouteStrings::Clear() {
+	strings.clear();
+	ids.clear();
+}
+
+/**
+ * Appends a compressed integer in the format of LcfWriter::WriteInt.
+ */
+static void PutInt(std::vector<uint8_t>& code, int value) {
+	uint32_t x = (uint32_t) value;
+	int shift = 28;
+	while (shift > 0 && (x >> shift) == 0)
+		shift -= 7;
+	for (; shift > 0; shift -= 7)
+		code.push_back((uint8_t) (((x >> shift) & 0x7F) | 0x80));
+	code.push_back((uint8_t) (x & 0x7F));
+}
+
+const uint8_t CompiledMoveRoute::EscapeCode;
+
+CompiledMoveRoute::CompiledMoveRoute() {
+	Clear();
+}
+
+CompiledMoveRoute::CompiledMoveRoute(const std::vector<RPG::MoveCommand>& commands, MoveRouteStrings& strings) {
+	Assign(commands, strings);
+}
+
+void CompiledMoveRoute::Assign(const std::vector<RPG::MoveCommand>& commands, MoveRouteStrings& strings) {
+	Clear();
+	code.reserve(commands.size());
+	for (size_t i = 0; i < commands.size(); i++)
+		Add(commands[i], strings);
+}
+
+void CompiledMoveRoute::ToVector(const MoveRouteStrings& strings, std::vector<RPG::MoveCommand>& commands) const {
+	commands.resize(Size());
+	Command command;
+	size_t position = 0;
+	for (size_t i = 0; i < commands.size(); i++) {
+		position = Step(position, command);
+		RPG::MoveCommand& out = commands[i];
+		out.command_id = command.code;
+		if (command.string_id >= 0)
+			out.parameter_string = strings.Get(command.string_id);
+		else
+			out.parameter_string.clear();
+		out.parameter_a = command.parameter_a;
+		out.parameter_b = command.parameter_b;
+		out.parameter_c = command.parameter_c;
+	}
+}
+
+void CompiledMoveRoute::Add(const RPG::MoveCommand& command, MoveRouteStrings& strings) {
+	if (command.command_id >= 0 && command.command_id < EscapeCode) {
+		code.push_back((uint8_t) command.command_id);
+	} else {
+		code.push_back(EscapeCode);
+		PutInt(code, command.command_id);
+	}
+	switch (command.command_id) {
+		case RPG::MoveCommand::Code::switch_on:
+		case RPG::MoveCommand::Code::switch_off:
+			PutInt(code, command.parameter_a);
+			break;
+		case RPG::MoveCommand::Code::change_graphic:
+			PutInt(code, strings.Intern(command.parameter_string));
+			PutInt(code, command.parameter_a);
+			break;
+		case RPG::MoveCommand::Code::play_sound_effect:
+			PutInt(code, strings.Intern(command.parameter_string));
+			PutInt(code, command.parameter_a);
+			PutInt(code, command.parameter_b);
+			PutInt(code, command.parameter_c);
+			break;
+	}
+	count++;
+}
+
+void CompiledMoveRoute::Clear() {
+	code.clear();
+	count = 0;
+}
+
+size_t CompiledMoveRoute::Size() const {
+	return count;
+}
+
+bool CompiledMoveRoute::Empty() const {
+	return count == 0;
+}
+
+size_t CompiledMoveRoute::GetPosition(size_t index) const {
+	Command command;
+	size_t position = 0;
+	for (size_t i = 0; i < index && position < code.size(); i++)
+		position = Step(position, command);
+	return position;
+}
+
+std::vector<std::vector<CompiledMoveRoute> > CompiledMoveRoute::Compile(const RPG::Map& map, MoveRouteStrings& strings) {
+	std::vector<std::vector<CompiledMoveRoute> > routes(map.events.size());
+	for (size_t i = 0; i < map.events.size(); i++) {
+		const std::vector<RPG::EventPage>& pages = map.events[i].pages;
+		routes[i].resize(pages.size());
+		for (size_t j = 0; j < pages.size(); j++)
+			routes[i][j].Assign(pages[j].move_route.move_commands, strings);
+	}
+	return routes;
+}
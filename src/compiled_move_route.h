@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#ifndef LCF_COMPILED_MOVE_ROUTE_H
+#define LCF_COMPILED_MOVE_ROUTE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "reader_lcf.h"
+#include "reader_types.h"
+#include "rpg_map.h"
+#include "rpg_movecommand.h"
+
+/**
+ * Strings of compiled move routes, every distinct string stored once.
+ *
+ * One table is meant to be shared by all routes of a map or game, so the
+ * few graphic and sound file names are not repeated per command.
+ */
+class MoveRouteStrings {
+public:
+	/**
+	 * Returns the ID of a string, adding it if it is new.
+	 */
+	int Intern(const std::string& str);
+
+	/**
+	 * Returns the string with an ID.
+	 */
+	const std::string& Get(int id) const;
+
+	size_t Size() const;
+	void Clear();
+
+private:
+	std::vector<std::string> strings;
+	std::unordered_map<std::string, int> ids;
+};
+
+/**
+ * Move route commands compiled to a byte stream.
+ *
+ * A std::vector<RPG::MoveCommand> stores a string and three parameters
+ * per command although most commands have none. Here every command is
+ * its code in one byte, followed by the parameters it uses as compressed
+ * integers: the switch ID for switch_on and switch_off, the string ID and
+ * index for change_graphic and the string ID, volume, tempo and balance
+ * for play_sound_effect. Codes outside of 0 to 254 are stored as 255 and
+ * the compressed code. Strings are IDs in a MoveRouteStrings table.
+ *
+ * Like the LCF format, only the parameters used by the code are kept.
+ * Routes are stepped through with Step, which decodes one command at a
+ * byte position.
+ */
+class CompiledMoveRoute {
+public:
+	/**
+	 * One decoded command. Parameters the code does not use are 0.
+	 */
+	struct Command {
+		int code;
+		/** ID in the string table, -1 for codes without string. */
+		int string_id;
+		int parameter_a;
+		int parameter_b;
+		int parameter_c;
+	};
+
+	CompiledMoveRoute();
+	CompiledMoveRoute(const std::vector<RPG::MoveCommand>& commands, MoveRouteStrings& strings);
+
+	/**
+	 * Replaces the contents with the commands of a vector.
+	 */
+	void Assign(const std::vector<RPG::MoveCommand>& commands, MoveRouteStrings& strings);
+
+	/**
+	 * Returns the commands in the usual vector form.
+	 */
+	void ToVector(const MoveRouteStrings& strings, std::vector<RPG::MoveCommand>& commands) const;
+
+	/**
+	 * Appends a command.
+	 */
+	void Add(const RPG::MoveCommand& command, MoveRouteStrings& strings);
+
+	void Clear();
+
+	/**
+	 * Returns the number of commands.
+	 */
+	size_t Size() const;
+	bool Empty() const;
+
+	/**
+	 * Returns the size of the byte stream, the position after the last
+	 * command.
+	 */
+	size_t CodeSize() const;
+
+	/**
+	 * Decodes the command at a byte position.
+	 *
+	 * @param position position of a command, 0 for the first one.
+	 * @param command receives the command.
+	 * @return position of the next command, CodeSize() after the last.
+	 */
+	size_t Step(size_t position, Command& command) const;
+
+	/**
+	 * Returns the byte position of the command with an index, for
+	 * example a saved move_route_index. CodeSize() when there are not
+	 * as many commands.
+	 */
+	size_t GetPosition(size_t index) const;
+
+	/**
+	 * Reads an LCF move command chunk directly into the route, replacing
+	 * its contents. Uses the same decoder as the vector form, see
+	 * lmu_movecommand.cpp.
+	 *
+	 * @param stream reader positioned at the chunk data.
+	 * @param length chunk length.
+	 * @param strings table receiving the strings.
+	 */
+	void ReadLcf(LcfReader& stream, uint32_t length, MoveRouteStrings& strings);
+
+	/**
+	 * Compiles the routes of all pages of all events of a map. The
+	 * result has one vector of page routes per event, in the same order.
+	 */
+	static std::vector<std::vector<CompiledMoveRoute> > Compile(const RPG::Map& map, MoveRouteStrings& strings);
+
+private:
+	/** Code byte followed by the compressed code of codes outside of a byte. */
+	static const uint8_t EscapeCode = 0xFF;
+
+	static int ReadInt(const uint8_t* data, size_t& position);
+
+	std::vector<uint8_t> code;
+	uint32_t count;
+};
+
+inline size_t CompiledMoveRoute::CodeSize() const {
+	return code.size();
+}
+
+inline int CompiledMoveRoute::ReadInt(const uint8_t* data, size_t& position) {
+	uint32_t value = 0;
+	uint8_t byte;
+	do {
+		byte = data[position++];
+		value = (value << 7) | (byte & 0x7F);
+	} while (byte & 0x80);
+	return (int) value;
+}
+
+inline size_t CompiledMoveRoute::Step(size_t position, Command& command) const {
+	const uint8_t* data = &code.front();
+	command.code = data[position++];
+	if (command.code == EscapeCode)
+		command.code = ReadInt(data, position);
+	command.string_id = -1;
+	command.parameter_a = 0;
+	command.parameter_b = 0;
+	command.parameter_c = 0;
+	switch (command.code) {
+		case RPG::MoveCommand::Code::switch_on:
+		case RPG::MoveCommand::Code::switch_off:
+			command.parameter_a = ReadInt(data, position);
+			break;
+		case RPG::MoveCommand::Code::change_graphic:
+			command.string_id = ReadInt(data, position);
+			command.parameter_a = ReadInt(data, position);
+			break;
+		case RPG::MoveCommand::Code::play_sound_effect:
+			command.string_id = ReadInt(data, position);
+			command.parameter_a = ReadInt(data, position);
+			command.parameter_b = ReadInt(data, position);
+			command.parameter_c = ReadInt(data, position);
+			break;
+	}
+	return position;
+}
+
+#endif
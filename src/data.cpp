@@ -8,50 +8,56 @@
 #include "data.h"
 
 namespace Data {
-	RPG::Database data;
+	Context context;
 
-	std::vector<RPG::Actor>& actors = data.actors;
-	std::vector<RPG::Skill>& skills = data.skills;
-	std::vector<RPG::Item>& items = data.items;
-	std::vector<RPG::Enemy>& enemies = data.enemies;
-	std::vector<RPG::Troop>& troops = data.troops;
-	std::vector<RPG::Terrain>& terrains = data.terrains;
-	std::vector<RPG::Attribute>& attributes = data.attributes;
-	std::vector<RPG::State>& states = data.states;
-	std::vector<RPG::Animation>& animations = data.animations;
-	std::vector<RPG::Chipset>& chipsets = data.chipsets;
-	std::vector<RPG::CommonEvent>& commonevents = data.commonevents;
-	RPG::BattleCommands& battlecommands = data.battlecommands;
-	std::vector<RPG::Class>& classes = data.classes;
-	std::vector<RPG::BattlerAnimation>& battleranimations = data.battleranimations;
-	RPG::Terms& terms = data.terms;
-	RPG::System& system = data.system;
-	std::vector<RPG::Switch>& switches = data.switches;
-	std::vector<RPG::Variable>& variables = data.variables;
+	RPG::Database& data = context.data;
 
-	RPG::TreeMap treemap;
+	std::vector<RPG::Actor>& actors = context.data.actors;
+	std::vector<RPG::Skill>& skills = context.data.skills;
+	std::vector<RPG::Item>& items = context.data.items;
+	std::vector<RPG::Enemy>& enemies = context.data.enemies;
+	std::vector<RPG::Troop>& troops = context.data.troops;
+	std::vector<RPG::Terrain>& terrains = context.data.terrains;
+	std::vector<RPG::Attribute>& attributes = context.data.attributes;
+	std::vector<RPG::State>& states = context.data.states;
+	std::vector<RPG::Animation>& animations = context.data.animations;
+	std::vector<RPG::Chipset>& chipsets = context.data.chipsets;
+	std::vector<RPG::CommonEvent>& commonevents = context.data.commonevents;
+	RPG::BattleCommands& battlecommands = context.data.battlecommands;
+	std::vector<RPG::Class>& classes = context.data.classes;
+	std::vector<RPG::BattlerAnimation>& battleranimations = context.data.battleranimations;
+	RPG::Terms& terms = context.data.terms;
+	RPG::System& system = context.data.system;
+	std::vector<RPG::Switch>& switches = context.data.switches;
+	std::vector<RPG::Variable>& variables = context.data.variables;
+
+	RPG::TreeMap& treemap = context.treemap;
 }
 
-void Data::Clear() {
-	actors.clear();
-	skills.clear();
-	items.clear();
-	enemies.clear();
-	troops.clear();
-	terrains.clear();
-	attributes.clear();
-	states.clear();
-	animations.clear();
-	chipsets.clear();
-	commonevents.clear();
-	battlecommands = RPG::BattleCommands();
-	classes.clear();
-	battleranimations.clear();
-	terms = RPG::Terms();
-	system = RPG::System();
-	switches.clear();
-	variables.clear();
+void Data::Context::Clear() {
+	data.actors.clear();
+	data.skills.clear();
+	data.items.clear();
+	data.enemies.clear();
+	data.troops.clear();
+	data.terrains.clear();
+	data.attributes.clear();
+	data.states.clear();
+	data.animations.clear();
+	data.chipsets.clear();
+	data.commonevents.clear();
+	data.battlecommands = RPG::BattleCommands();
+	data.classes.clear();
+	data.battleranimations.clear();
+	data.terms = RPG::Terms();
+	data.system = RPG::System();
+	data.switches.clear();
+	data.variables.clear();
 	treemap.active_node = 0;
 	treemap.maps.clear();
 	treemap.tree_order.clear();
 }
+
+void Data::Clear() {
+	context.Clear();
+}
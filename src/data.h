@@ -35,8 +35,30 @@
  * Data namespace
  */
 namespace Data {
-	/** Database Data (ldb) */
-	extern RPG::Database data;
+	/**
+	 * Database and map tree of one game.
+	 *
+	 * Games loaded into separate contexts are independent of each other
+	 * and of the default context behind the globals below, so several
+	 * games can be kept in memory and loaded from different threads.
+	 */
+	struct Context {
+		/** Database Data (ldb) */
+		RPG::Database data;
+		/** TreeMap (lmt) */
+		RPG::TreeMap treemap;
+
+		/**
+		 * Clears database and map tree.
+		 */
+		void Clear();
+	};
+
+	/** Default context used by the loaders without a context argument. */
+	extern Context context;
+
+	/** Database Data (ldb) of the default context */
+	extern RPG::Database& data;
 	/** @{ */
 	extern std::vector<RPG::Actor>& actors;
 	extern std::vector<RPG::Skill>& skills;
@@ -58,11 +80,11 @@ namespace Data {
 	extern std::vector<RPG::Variable>& variables;
 	/** @} */
 
-	/** TreeMap (lmt) */
-	extern RPG::TreeMap treemap;
+	/** TreeMap (lmt) of the default context */
+	extern RPG::TreeMap& treemap;
 
 	/**
-	 * Clears database data.
+	 * Clears database data of the default context.
 	 */
 	void Clear();
 }
@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#include "data_index.h"
+
+void DatabaseIndex::Build(const RPG::Database& db) {
+	actors.Build(db.actors);
+	skills.Build(db.skills);
+	items.Build(db.items);
+	enemies.Build(db.enemies);
+	troops.Build(db.troops);
+	terrains.Build(db.terrains);
+	attributes.Build(db.attributes);
+	states.Build(db.states);
+	animations.Build(db.animations);
+	chipsets.Build(db.chipsets);
+	switches.Build(db.switches);
+	variables.Build(db.variables);
+	commonevents.Build(db.commonevents);
+	classes.Build(db.classes);
+	battleranimations.Build(db.battleranimations);
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#ifndef LCF_DATA_INDEX_H
+#define LCF_DATA_INDEX_H
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "reader_types.h"
+#include "rpg_database.h"
+
+/**
+ * Maps the ID of the elements of a database vector to the element.
+ *
+ * Elements are usually stored in ID order starting at 1, but databases
+ * edited by other tools can have gaps or a different order. The index
+ * handles both: IDs up to about twice the element count are kept in a
+ * table indexed by ID, larger IDs in a hash map, so lookups are constant
+ * time. Elements with an ID of 0 or below are not indexed, for duplicate
+ * IDs the first element wins.
+ *
+ * The index refers to the elements of the vector it was built from and
+ * must be rebuilt when the vector changes.
+ */
+template <class S>
+class IDIndex {
+public:
+	IDIndex() : elements(NULL) {}
+
+	explicit IDIndex(const std::vector<S>& vec) : elements(NULL) {
+		Build(vec);
+	}
+
+	/**
+	 * Indexes the elements of vec.
+	 */
+	void Build(const std::vector<S>& vec) {
+		elements = vec.empty() ? NULL : &vec.front();
+		slots.clear();
+		sparse.clear();
+
+		const int limit = (int) (vec.size() * 2 + 64);
+		int max_id = 0;
+		for (size_t i = 0; i < vec.size(); i++) {
+			if (vec[i].ID > max_id && vec[i].ID <= limit)
+				max_id = vec[i].ID;
+		}
+		slots.assign(max_id + 1, -1);
+
+		for (size_t i = 0; i < vec.size(); i++) {
+			int id = vec[i].ID;
+			if (id <= 0)
+				continue;
+			if (id <= max_id) {
+				if (slots[id] < 0)
+					slots[id] = (int32_t) i;
+			} else {
+				sparse.insert(std::make_pair(id, (int32_t) i));
+			}
+		}
+	}
+
+	/**
+	 * Returns the element with the ID or NULL if there is none.
+	 */
+	const S* Get(int id) const {
+		if (id > 0 && (size_t) id < slots.size()) {
+			int32_t slot = slots[id];
+			return slot < 0 ? NULL : &elements[slot];
+		}
+		if (sparse.empty())
+			return NULL;
+		std::unordered_map<int, int32_t>::const_iterator it = sparse.find(id);
+		return it == sparse.end() ? NULL : &elements[it->second];
+	}
+
+	/**
+	 * Checks if there is an element with the ID.
+	 */
+	bool Has(int id) const {
+		return Get(id) != NULL;
+	}
+
+	/**
+	 * Returns the element with the ID without building an index.
+	 * Constant time when the element is at position ID - 1, a linear
+	 * search otherwise. Unlike Get, any of several elements with the
+	 * same ID may be returned.
+	 *
+	 * @return the element or NULL if there is none.
+	 */
+	static const S* Find(const std::vector<S>& vec, int id) {
+		if (id > 0 && (size_t) id <= vec.size() && vec[id - 1].ID == id)
+			return &vec[id - 1];
+		for (size_t i = 0; i < vec.size(); i++) {
+			if (vec[i].ID == id)
+				return &vec[i];
+		}
+		return NULL;
+	}
+
+private:
+	const S* elements;
+	/** Element position per ID, -1 for IDs without element. */
+	std::vector<int32_t> slots;
+	/** Element position of IDs beyond the table. */
+	std::unordered_map<int, int32_t> sparse;
+};
+
+/**
+ * ID indices of all database vectors.
+ */
+struct DatabaseIndex {
+	IDIndex<RPG::Actor> actors;
+	IDIndex<RPG::Skill> skills;
+	IDIndex<RPG::Item> items;
+	IDIndex<RPG::Enemy> enemies;
+	IDIndex<RPG::Troop> troops;
+	IDIndex<RPG::Terrain> terrains;
+	IDIndex<RPG::Attribute> attributes;
+	IDIndex<RPG::State> states;
+	IDIndex<RPG::Animation> animations;
+	IDIndex<RPG::Chipset> chipsets;
+	IDIndex<RPG::Switch> switches;
+	IDIndex<RPG::Variable> variables;
+	IDIndex<RPG::CommonEvent> commonevents;
+	IDIndex<RPG::Class> classes;
+	IDIndex<RPG::BattlerAnimation> battleranimations;
+
+	DatabaseIndex() {}
+
+	explicit DatabaseIndex(const RPG::Database& db) {
+		Build(db);
+	}
+
+	/**
+	 * Indexes all vectors of db, usually once after loading it.
+	 */
+	void Build(const RPG::Database& db);
+};
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#include "event_command_list.h"
+
+EventCommandList::EventCommandList() {
+	Clear();
+}
+
+EventCommandList::EventCommandList(const std::vector<RPG::EventCommand>& commands) {
+	Assign(commands);
+}
+
+void EventCommandList::Assign(const std::vector<RPG::EventCommand>& commands) {
+	Clear();
+	size_t parameter_count = 0;
+	size_t string_bytes = 0;
+	for (size_t i = 0; i < commands.size(); i++) {
+		parameter_count += commands[i].parameters.size();
+		string_bytes += commands[i].string.size();
+	}
+	Reserve(commands.size(), parameter_count, string_bytes);
+	for (size_t i = 0; i < commands.size(); i++)
+		Add(commands[i]);
+}
+
+std::vector<RPG::EventCommand> EventCommandList::ToVector() const {
+	std::vector<RPG::EventCommand> commands;
+	ToVector(commands);
+	return commands;
+}
+
+void EventCommandList::ToVector(std::vector<RPG::EventCommand>& commands) const {
+	commands.resize(Size());
+	for (size_t i = 0; i < commands.size(); i++) {
+		RPG::EventCommand& command = commands[i];
+		command.code = codes[i];
+		command.indent = indents[i];
+		command.string.assign(GetStringData(i), GetStringSize(i));
+		const int* first = GetParameters(i);
+		command.parameters.assign(first, first + GetParameterCount(i));
+	}
+}
+
+void EventCommandList::Add(const RPG::EventCommand& command) {
+	Add(command.code, command.indent, command.string,
+		command.parameters.empty() ? NULL : &command.parameters.front(), command.parameters.size());
+}
+
+void EventCommandList::Add(int code, int indent, const std::string& string, const int* parameters, size_t parameter_count) {
+	codes.push_back(code);
+	indents.push_back(indent);
+	this->parameters.insert(this->parameters.end(), parameters, parameters + parameter_count);
+	parameter_offsets.push_back((uint32_t) this->parameters.size());
+	strings.append(string);
+	string_offsets.push_back((uint32_t) strings.size());
+}
+
+void EventCommandList::Reserve(size_t commands, size_t parameters, size_t string_bytes) {
+	codes.reserve(commands);
+	indents.reserve(commands);
+	parameter_offsets.reserve(commands + 1);
+	string_offsets.reserve(commands + 1);
+	this->parameters.reserve(parameters);
+	strings.reserve(string_bytes);
+}
+
+void EventCommandList::Clear() {
+	codes.clear();
+	indents.clear();
+	parameters.clear();
+	strings.clear();
+	parameter_offsets.assign(1, 0);
+	string_offsets.assign(1, 0);
+}
+
+size_t EventCommandList::Size() const {
+	return codes.size();
+}
+
+bool EventCommandList::Empty() const {
+	return codes.empty();
+}
+
+int EventCommandList::GetCode(size_t index) const {
+	return codes[index];
+}
+
+int EventCommandList::GetIndent(size_t index) const {
+	return indents[index];
+}
+
+const char* EventCommandList::GetStringData(size_t index) const {
+	return strings.data() + string_offsets[index];
+}
+
+size_t EventCommandList::GetStringSize(size_t index) const {
+	return string_offsets[index + 1] - string_offsets[index];
+}
+
+std::string EventCommandList::GetString(size_t index) const {
+	return std::string(GetStringData(index), GetStringSize(index));
+}
+
+const int* EventCommandList::GetParameters(size_t index) const {
+	return parameters.data() + parameter_offsets[index];
+}
+
+size_t EventCommandList::GetParameterCount(size_t index) const {
+	return parameter_offsets[index + 1] - parameter_offsets[index];
+}
+
+int EventCommandList::GetParameter(size_t index, size_t parameter, int def) const {
+	if (parameter >= GetParameterCount(index))
+		return def;
+	return GetParameters(index)[parameter];
+}
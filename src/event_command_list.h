@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#ifndef LCF_EVENT_COMMAND_LIST_H
+#define LCF_EVENT_COMMAND_LIST_H
+
+#include <string>
+#include <vector>
+#include "reader_types.h"
+#include "rpg_eventcommand.h"
+
+class LcfReader;
+class LcfWriter;
+
+/**
+ * Compact storage of an event command list.
+ *
+ * A std::vector<RPG::EventCommand> allocates a string and a parameter
+ * vector per command. This list stores codes and indents in parallel
+ * arrays, all parameters in one pool and all strings in one buffer, so
+ * a list of any length needs a handful of allocations and is read
+ * sequentially. Converting to and from the vector form is lossless.
+ */
+class EventCommandList {
+public:
+	EventCommandList();
+	explicit EventCommandList(const std::vector<RPG::EventCommand>& commands);
+
+	/**
+	 * Replaces the contents with the commands of a vector.
+	 */
+	void Assign(const std::vector<RPG::EventCommand>& commands);
+
+	/**
+	 * Returns the commands in the usual vector form.
+	 */
+	std::vector<RPG::EventCommand> ToVector() const;
+	void ToVector(std::vector<RPG::EventCommand>& commands) const;
+
+	/**
+	 * Appends a command.
+	 */
+	void Add(const RPG::EventCommand& command);
+	void Add(int code, int indent, const std::string& string, const int* parameters, size_t parameter_count);
+
+	/**
+	 * Reserves room for commands and their parameters and string bytes.
+	 */
+	void Reserve(size_t commands, size_t parameters, size_t string_bytes);
+
+	void Clear();
+	size_t Size() const;
+	bool Empty() const;
+
+	int GetCode(size_t index) const;
+	int GetIndent(size_t index) const;
+
+	/**
+	 * Returns the string of a command. The data is not null terminated.
+	 */
+	const char* GetStringData(size_t index) const;
+	size_t GetStringSize(size_t index) const;
+	std::string GetString(size_t index) const;
+
+	/**
+	 * Returns the parameters of a command.
+	 */
+	const int* GetParameters(size_t index) const;
+	size_t GetParameterCount(size_t index) const;
+
+	/**
+	 * Returns a parameter or def if the command has fewer parameters.
+	 */
+	int GetParameter(size_t index, size_t parameter, int def = 0) const;
+
+	/**
+	 * Reads an LCF event command chunk directly into the list, replacing
+	 * its contents. Uses the same decoder as the vector form, see
+	 * ldb_eventcommand.cpp.
+	 *
+	 * @param stream reader positioned at the chunk data.
+	 * @param length chunk length.
+	 */
+	void ReadLcf(LcfReader& stream, uint32_t length);
+
+	/**
+	 * Writes the list as an LCF event command chunk.
+	 */
+	void WriteLcf(LcfWriter& stream) const;
+
+private:
+	std::vector<int> codes;
+	std::vector<int> indents;
+	/** Start of the parameters of each command in parameters, one more than commands. */
+	std::vector<uint32_t> parameter_offsets;
+	std::vector<int> parameters;
+	/** Start of the string of each command in strings, one more than commands. */
+	std::vector<uint32_t> string_offsets;
+	std::string strings;
+};
+
+#endif
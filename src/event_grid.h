@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#ifndef LCF_EVENT_GRID_H
+#define LCF_EVENT_GRID_H
+
+#include <algorithm>
+#include <climits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "reader_types.h"
+#include "rpg_event.h"
+#include "rpg_savemapevent.h"
+
+/**
+ * Position fields of the event types.
+ */
+template <class E>
+struct EventPosition {
+};
+
+template <>
+struct EventPosition<RPG::Event> {
+	static int& X(RPG::Event& event) { return event.x; }
+	static int& Y(RPG::Event& event) { return event.y; }
+};
+
+template <>
+struct EventPosition<RPG::SaveMapEvent> {
+	static int& X(RPG::SaveMapEvent& event) { return event.position_x; }
+	static int& Y(RPG::SaveMapEvent& event) { return event.position_y; }
+};
+
+/**
+ * Finds the events of a map near a tile.
+ *
+ * Events are kept in buckets of 8x8 tiles, so a lookup only checks the
+ * events in the buckets around the position. Works for the events of a
+ * map (RPG::Event) and of a save (RPG::SaveMapEvent).
+ *
+ * The grid refers to the event vector it was built from. Moving events
+ * through Move, or calling Update after changing a position directly,
+ * keeps it current. Adding or removing events requires a new Build.
+ */
+template <class E>
+class EventGrid {
+public:
+	EventGrid() : events(NULL) {}
+
+	explicit EventGrid(std::vector<E>& events) : events(NULL) {
+		Build(events);
+	}
+
+	/**
+	 * Indexes the positions of all events.
+	 */
+	void Build(std::vector<E>& events) {
+		this->events = &events;
+		cells.clear();
+		positions.clear();
+		slots.clear();
+		min_cell = std::make_pair(INT_MAX, INT_MAX);
+		max_cell = std::make_pair(INT_MIN, INT_MIN);
+		for (int i = 0; i < (int) events.size(); i++) {
+			positions.insert(std::make_pair(events[i].ID, i));
+			int x = EventPosition<E>::X(events[i]);
+			int y = EventPosition<E>::Y(events[i]);
+			slots.push_back(std::make_pair(x, y));
+			cells[Key(x, y)].push_back(i);
+			Occupy(x, y);
+		}
+	}
+
+	/**
+	 * Returns the events on a tile in the order of the event vector.
+	 */
+	void GetAt(int x, int y, std::vector<E*>& result) const {
+		result.clear();
+		typename std::unordered_map<long long, std::vector<int> >::const_iterator it = cells.find(Key(x, y));
+		if (it == cells.end())
+			return;
+		std::vector<int> found;
+		for (size_t i = 0; i < it->second.size(); i++) {
+			int index = it->second[i];
+			if (slots[index].first == x && slots[index].second == y)
+				found.push_back(index);
+		}
+		Collect(found, result);
+	}
+
+	/**
+	 * Returns the events at most radius tiles away from a tile, measured
+	 * as straight line distance, in the order of the event vector.
+	 */
+	void GetInRadius(int x, int y, int radius, std::vector<E*>& result) const {
+		result.clear();
+		if (radius < 0 || cells.empty())
+			return;
+		// Bounds in long long, x - radius and y + radius may not fit an int
+		const int cx0 = (int) std::max(Cell((long long) x - radius), (long long) min_cell.first);
+		const int cx1 = (int) std::min(Cell((long long) x + radius), (long long) max_cell.first);
+		const int cy0 = (int) std::max(Cell((long long) y - radius), (long long) min_cell.second);
+		const int cy1 = (int) std::min(Cell((long long) y + radius), (long long) max_cell.second);
+		if (cx0 > cx1 || cy0 > cy1)
+			return;
+
+		std::vector<int> found;
+		if ((long long) (cx1 - cx0 + 1) * (cy1 - cy0 + 1) > (long long) cells.size()) {
+			// Fewer occupied cells than cells in the range
+			typename std::unordered_map<long long, std::vector<int> >::const_iterator it;
+			for (it = cells.begin(); it != cells.end(); ++it) {
+				int cx = CellX(it->first);
+				int cy = CellY(it->first);
+				if (cx >= cx0 && cx <= cx1 && cy >= cy0 && cy <= cy1)
+					Match(it->second, x, y, radius, found);
+			}
+		} else {
+			for (int cy = cy0; cy <= cy1; cy++) {
+				for (int cx = cx0; cx <= cx1; cx++) {
+					typename std::unordered_map<long long, std::vector<int> >::const_iterator it = cells.find(CellKey(cx, cy));
+					if (it != cells.end())
+						Match(it->second, x, y, radius, found);
+				}
+			}
+		}
+		Collect(found, result);
+	}
+
+	/**
+	 * Moves an event and updates the grid.
+	 *
+	 * @return false if there is no event with the ID.
+	 */
+	bool Move(int id, int x, int y) {
+		typename std::unordered_map<int, int>::const_iterator it = positions.find(id);
+		if (it == positions.end())
+			return false;
+		E& event = (*events)[it->second];
+		EventPosition<E>::X(event) = x;
+		EventPosition<E>::Y(event) = y;
+		Reposition(it->second);
+		return true;
+	}
+
+	/**
+	 * Updates the grid after the position of an event was changed
+	 * directly.
+	 *
+	 * @return false if there is no event with the ID.
+	 */
+	bool Update(int id) {
+		typename std::unordered_map<int, int>::const_iterator it = positions.find(id);
+		if (it == positions.end())
+			return false;
+		Reposition(it->second);
+		return true;
+	}
+
+private:
+	static const int cell_size = 8;
+
+	static int Cell(int tile) {
+		return (int) Cell((long long) tile);
+	}
+
+	static long long Cell(long long tile) {
+		// Rounds down for negative positions too
+		return tile >= 0 ? tile / cell_size : -((-tile + cell_size - 1) / cell_size);
+	}
+
+	static long long CellKey(int cx, int cy) {
+		return (long long) (((unsigned long long) (unsigned int) cx << 32) | (unsigned int) cy);
+	}
+
+	static int CellX(long long key) {
+		return (int) (unsigned int) ((unsigned long long) key >> 32);
+	}
+
+	static int CellY(long long key) {
+		return (int) (unsigned int) key;
+	}
+
+	static long long Key(int x, int y) {
+		return CellKey(Cell(x), Cell(y));
+	}
+
+	/**
+	 * Widens the occupied cell range to include the cell of a tile.
+	 */
+	void Occupy(int x, int y) {
+		std::pair<int, int> cell(Cell(x), Cell(y));
+		min_cell.first = std::min(min_cell.first, cell.first);
+		min_cell.second = std::min(min_cell.second, cell.second);
+		max_cell.first = std::max(max_cell.first, cell.first);
+		max_cell.second = std::max(max_cell.second, cell.second);
+	}
+
+	/**
+	 * Adds the events of a cell within radius of a tile to found.
+	 */
+	void Match(const std::vector<int>& cell, int x, int y, int radius, std::vector<int>& found) const {
+		const long long max_distance = (long long) radius * radius;
+		for (size_t i = 0; i < cell.size(); i++) {
+			int index = cell[i];
+			long long dx = (long long) slots[index].first - x;
+			long long dy = (long long) slots[index].second - y;
+			// Checked first so the squares below cannot overflow
+			if (dx < -radius || dx > radius || dy < -radius || dy > radius)
+				continue;
+			if (dx * dx + dy * dy <= max_distance)
+				found.push_back(index);
+		}
+	}
+
+	void Reposition(int index) {
+		E& event = (*events)[index];
+		int x = EventPosition<E>::X(event);
+		int y = EventPosition<E>::Y(event);
+		long long old_key = Key(slots[index].first, slots[index].second);
+		long long new_key = Key(x, y);
+		slots[index] = std::make_pair(x, y);
+		if (old_key == new_key)
+			return;
+
+		std::vector<int>& old_cell = cells[old_key];
+		old_cell.erase(std::find(old_cell.begin(), old_cell.end(), index));
+		if (old_cell.empty())
+			cells.erase(old_key);
+		cells[new_key].push_back(index);
+		Occupy(x, y);
+	}
+
+	void Collect(std::vector<int>& found, std::vector<E*>& result) const {
+		std::sort(found.begin(), found.end());
+		result.reserve(found.size());
+		for (size_t i = 0; i < found.size(); i++)
+			result.push_back(&(*events)[found[i]]);
+	}
+
+	std::vector<E>* events;
+	/** Event positions in the vector per cell. */
+	std::unordered_map<long long, std::vector<int> > cells;
+	/** Position in the vector per event ID. */
+	std::unordered_map<int, int> positions;
+	/** Indexed tile of each event, same order as the vector. */
+	std::vector<std::pair<int, int> > slots;
+	/**
+	 * Lowest and highest occupied cell on each axis. Only grows when
+	 * events move, so it may cover cells that are empty again.
+	 */
+	std::pair<int, int> min_cell;
+	std::pair<int, int> max_cell;
+};
+
+typedef EventGrid<RPG::Event> MapEventGrid;
+typedef EventGrid<RPG::SaveMapEvent> SaveEventGrid;
+
+#endif
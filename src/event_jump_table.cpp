@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#include <utility>
+#include "event_command_list.h"
+#include "event_jump_table.h"
+
+typedef RPG::EventCommand::Code Code;
+
+/**
+ * Checks if a command jumps to the next command with the same indent.
+ */
+static bool JumpsToNext(int code) {
+	switch (code) {
+		case Code::ConditionalBranch:
+		case Code::ConditionalBranch_B:
+		case Code::ElseBranch:
+		case Code::ElseBranch_B:
+		case Code::Loop:
+		case Code::ShowChoice:
+		case Code::ShowChoiceOption:
+		case Code::VictoryHandler:
+		case Code::EscapeHandler:
+		case Code::DefeatHandler:
+		case Code::Transaction:
+		case Code::NoTransaction:
+		case Code::Stay:
+		case Code::NoStay:
+			return true;
+	}
+	return false;
+}
+
+EventJumpTable::EventJumpTable() {
+}
+
+EventJumpTable::EventJumpTable(const std::vector<RPG::EventCommand>& commands) {
+	Build(commands);
+}
+
+EventJumpTable::EventJumpTable(const EventCommandList& commands) {
+	Build(commands);
+}
+
+void EventJumpTable::Build(const std::vector<RPG::EventCommand>& commands) {
+	std::vector<int> codes(commands.size());
+	std::vector<int> indents(commands.size());
+	std::vector<int> label_ids(commands.size());
+	for (size_t i = 0; i < commands.size(); i++) {
+		codes[i] = commands[i].code;
+		indents[i] = commands[i].indent;
+		label_ids[i] = commands[i].parameters.empty() ? 0 : commands[i].parameters[0];
+	}
+	Build(codes, indents, label_ids);
+}
+
+void EventJumpTable::Build(const EventCommandList& commands) {
+	std::vector<int> codes(commands.Size());
+	std::vector<int> indents(commands.Size());
+	std::vector<int> label_ids(commands.Size());
+	for (size_t i = 0; i < commands.Size(); i++) {
+		codes[i] = commands.GetCode(i);
+		indents[i] = commands.GetIndent(i);
+		label_ids[i] = commands.GetParameter(i, 0);
+	}
+	Build(codes, indents, label_ids);
+}
+
+void EventJumpTable::Build(const std::vector<int>& codes, const std::vector<int>& indents, const std::vector<int>& label_ids) {
+	const int count = (int) codes.size();
+	jumps.assign(count, -1);
+	next.assign(count, -1);
+	labels.clear();
+
+	// Commands waiting for the next command with their indent
+	std::vector<int> pending;
+	// Open loops and the BreakLoops inside of them
+	std::vector<int> loops;
+	std::vector<std::pair<int, int> > breaks;
+
+	for (int i = 0; i < count; i++) {
+		while (!pending.empty() && indents[pending.back()] >= indents[i]) {
+			int open = pending.back();
+			pending.pop_back();
+			if (indents[open] == indents[i])
+				next[open] = i;
+		}
+		pending.push_back(i);
+
+		switch (codes[i]) {
+			case Code::Loop:
+				loops.push_back(i);
+				break;
+			case Code::EndLoop:
+				// Loops left without EndLoop at this indent are broken
+				while (!loops.empty() && indents[loops.back()] > indents[i])
+					loops.pop_back();
+				if (!loops.empty() && indents[loops.back()] == indents[i]) {
+					jumps[i] = loops.back();
+					loops.pop_back();
+				}
+				break;
+			case Code::BreakLoop:
+				if (!loops.empty())
+					breaks.push_back(std::make_pair(i, loops.back()));
+				break;
+			case Code::Label:
+				labels.insert(std::make_pair(label_ids[i], i));
+				break;
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+		if (JumpsToNext(codes[i]))
+			jumps[i] = next[i];
+	}
+	for (size_t i = 0; i < breaks.size(); i++) {
+		int end = jumps[breaks[i].second];
+		if (end != -1 && codes[end] == Code::EndLoop)
+			jumps[breaks[i].first] = end;
+	}
+	for (int i = 0; i < count; i++) {
+		if (codes[i] == Code::JumpToLabel)
+			jumps[i] = GetLabel(label_ids[i]);
+	}
+}
+
+int EventJumpTable::GetJump(size_t index) const {
+	return index < jumps.size() ? jumps[index] : -1;
+}
+
+int EventJumpTable::GetNext(size_t index) const {
+	return index < next.size() ? next[index] : -1;
+}
+
+int EventJumpTable::GetLabel(int label_id) const {
+	std::unordered_map<int, int>::const_iterator it = labels.find(label_id);
+	return it == labels.end() ? -1 : it->second;
+}
+
+std::vector<EventJumpTable> EventJumpTable::Build(const std::vector<RPG::CommonEvent>& commonevents) {
+	std::vector<EventJumpTable> tables(commonevents.size());
+	for (size_t i = 0; i < commonevents.size(); i++)
+		tables[i].Build(commonevents[i].event_commands);
+	return tables;
+}
+
+std::vector<std::vector<EventJumpTable> > EventJumpTable::Build(const RPG::Map& map) {
+	std::vector<std::vector<EventJumpTable> > tables(map.events.size());
+	for (size_t i = 0; i < map.events.size(); i++) {
+		const std::vector<RPG::EventPage>& pages = map.events[i].pages;
+		tables[i].resize(pages.size());
+		for (size_t j = 0; j < pages.size(); j++)
+			tables[i][j].Build(pages[j].event_commands);
+	}
+	return tables;
+}
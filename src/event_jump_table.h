@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#ifndef LCF_EVENT_JUMP_TABLE_H
+#define LCF_EVENT_JUMP_TABLE_H
+
+#include <unordered_map>
+#include <vector>
+#include "reader_types.h"
+#include "rpg_commonevent.h"
+#include "rpg_eventcommand.h"
+#include "rpg_map.h"
+
+class EventCommandList;
+
+/**
+ * Control flow targets of an event command list.
+ *
+ * Interpreters find the end of a branch or loop by scanning for the next
+ * command with the same indent. The table does this once per list, in
+ * one pass, and stores the target of every flow command:
+ *
+ * - ConditionalBranch: its ElseBranch, or its EndBranch without else.
+ * - ElseBranch: its EndBranch.
+ * - Loop: its EndLoop. EndLoop: its Loop.
+ * - BreakLoop: the EndLoop of the innermost enclosing loop.
+ * - ShowChoice and ShowChoiceOption: the next ShowChoiceOption or the
+ *   ShowChoiceEnd. The same holds for the battle handlers, shop
+ *   transaction and inn stay commands and their end commands.
+ * - JumpToLabel: the first Label with the same number.
+ *
+ * Other commands and broken structures have no target. Building tables
+ * only reads the commands, so tables of different lists can be built on
+ * several threads at once.
+ */
+class EventJumpTable {
+public:
+	EventJumpTable();
+	explicit EventJumpTable(const std::vector<RPG::EventCommand>& commands);
+	explicit EventJumpTable(const EventCommandList& commands);
+
+	void Build(const std::vector<RPG::EventCommand>& commands);
+	void Build(const EventCommandList& commands);
+
+	/**
+	 * Returns the position of the target of a command, -1 for none.
+	 */
+	int GetJump(size_t index) const;
+
+	/**
+	 * Returns the position of the next command with the same indent
+	 * before the indent decreases, -1 for none.
+	 */
+	int GetNext(size_t index) const;
+
+	/**
+	 * Returns the position of the first Label command with a number,
+	 * -1 for none.
+	 */
+	int GetLabel(int label_id) const;
+
+	/**
+	 * Builds the tables of all common events, in the same order.
+	 */
+	static std::vector<EventJumpTable> Build(const std::vector<RPG::CommonEvent>& commonevents);
+
+	/**
+	 * Builds the tables of all pages of all events of a map. The result
+	 * has one vector of page tables per event, in the same order.
+	 */
+	static std::vector<std::vector<EventJumpTable> > Build(const RPG::Map& map);
+
+private:
+	void Build(const std::vector<int>& codes, const std::vector<int>& indents, const std::vector<int>& labels);
+
+	std::vector<int> jumps;
+	std::vector<int> next;
+	/** Position of the first Label per label number. */
+	std::unordered_map<int, int> labels;
+};
+
+#endif
@@ -19,14 +19,14 @@
 LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(std::string, name),
 	LCF_STRUCT_TYPED_FIELD(std::string, title),
-	LCF_STRUCT_TYPED_FIELD(std::string, character_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, character_name),
 	LCF_STRUCT_TYPED_FIELD(int, character_index),
 	LCF_STRUCT_TYPED_FIELD(bool, transparent),
 	LCF_STRUCT_TYPED_FIELD(int, initial_level),
 	LCF_STRUCT_TYPED_FIELD(int, final_level),
 	LCF_STRUCT_TYPED_FIELD(bool, critical_hit),
 	LCF_STRUCT_TYPED_FIELD(int, critical_hit_chance),
-	LCF_STRUCT_TYPED_FIELD(std::string, face_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, face_name),
 	LCF_STRUCT_TYPED_FIELD(int, face_index),
 	LCF_STRUCT_TYPED_FIELD(bool, two_weapon),
 	LCF_STRUCT_TYPED_FIELD(bool, lock_equipment),
@@ -18,7 +18,7 @@
 
 LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(std::string, name),
-	LCF_STRUCT_TYPED_FIELD(std::string, battler_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, battler_name),
 	LCF_STRUCT_TYPED_FIELD(int, battler_index),
 	LCF_STRUCT_TYPED_FIELD(int, animation_type),
 	LCF_STRUCT_TYPED_FIELD(int, animation_id),
@@ -18,7 +18,7 @@
 
 LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(std::string, name),
-	LCF_STRUCT_TYPED_FIELD(std::string, chipset_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, chipset_name),
 	LCF_STRUCT_TYPED_FIELD(std::vector<int16_t>, terrain_data),
 	LCF_STRUCT_TYPED_FIELD(std::vector<uint8_t>, passable_data_lower),
 	LCF_STRUCT_TYPED_FIELD(std::vector<uint8_t>, passable_data_upper),
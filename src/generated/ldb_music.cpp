@@ -17,7 +17,7 @@
 #define LCF_CURRENT_STRUCT Music
 
 LCF_STRUCT_FIELDS_BEGIN()
-	LCF_STRUCT_TYPED_FIELD(std::string, name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, name),
 	LCF_STRUCT_TYPED_FIELD(int, fadein),
 	LCF_STRUCT_TYPED_FIELD(int, volume),
 	LCF_STRUCT_TYPED_FIELD(int, tempo),
@@ -17,7 +17,7 @@
 #define LCF_CURRENT_STRUCT Sound
 
 LCF_STRUCT_FIELDS_BEGIN()
-	LCF_STRUCT_TYPED_FIELD(std::string, name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, name),
 	LCF_STRUCT_TYPED_FIELD(int, volume),
 	LCF_STRUCT_TYPED_FIELD(int, tempo),
 	LCF_STRUCT_TYPED_FIELD(int, balance),
@@ -18,16 +18,16 @@
 
 LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(int, ldb_id),
-	LCF_STRUCT_TYPED_FIELD(std::string, boat_name),
-	LCF_STRUCT_TYPED_FIELD(std::string, ship_name),
-	LCF_STRUCT_TYPED_FIELD(std::string, airship_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, boat_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, ship_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, airship_name),
 	LCF_STRUCT_TYPED_FIELD(int, boat_index),
 	LCF_STRUCT_TYPED_FIELD(int, ship_index),
 	LCF_STRUCT_TYPED_FIELD(int, airship_index),
-	LCF_STRUCT_TYPED_FIELD(std::string, title_name),
-	LCF_STRUCT_TYPED_FIELD(std::string, gameover_name),
-	LCF_STRUCT_TYPED_FIELD(std::string, system_name),
-	LCF_STRUCT_TYPED_FIELD(std::string, system2_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, title_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, gameover_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, system_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, system2_name),
 	LCF_STRUCT_SIZE_FIELD(int16_t, party),
 	LCF_STRUCT_TYPED_FIELD(std::vector<int16_t>, party),
 	LCF_STRUCT_SIZE_FIELD(int16_t, menu_commands),
@@ -70,7 +70,7 @@ LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(int, battletest_condition),
 	LCF_STRUCT_TYPED_FIELD(int, unknown_61),
 	LCF_STRUCT_TYPED_FIELD(bool, show_frame),
-	LCF_STRUCT_TYPED_FIELD(std::string, frame_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, frame_name),
 	LCF_STRUCT_TYPED_FIELD(bool, invert_animations),
 	LCF_STRUCT_TYPED_FIELD(bool, show_title),
 LCF_STRUCT_FIELDS_END()
@@ -20,7 +20,7 @@ LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(std::string, name),
 	LCF_STRUCT_TYPED_FIELD(int, damage),
 	LCF_STRUCT_TYPED_FIELD(int, encounter_rate),
-	LCF_STRUCT_TYPED_FIELD(std::string, background_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, background_name),
 	LCF_STRUCT_TYPED_FIELD(bool, boat_pass),
 	LCF_STRUCT_TYPED_FIELD(bool, ship_pass),
 	LCF_STRUCT_TYPED_FIELD(bool, airship_pass),
@@ -29,13 +29,13 @@ LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(RPG::Sound, footstep),
 	LCF_STRUCT_TYPED_FIELD(bool, on_damage_se),
 	LCF_STRUCT_TYPED_FIELD(int, background_type),
-	LCF_STRUCT_TYPED_FIELD(std::string, background_a_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, background_a_name),
 	LCF_STRUCT_TYPED_FIELD(bool, background_a_scrollh),
 	LCF_STRUCT_TYPED_FIELD(bool, background_a_scrollv),
 	LCF_STRUCT_TYPED_FIELD(int, background_a_scrollh_speed),
 	LCF_STRUCT_TYPED_FIELD(int, background_a_scrollv_speed),
 	LCF_STRUCT_TYPED_FIELD(bool, background_b),
-	LCF_STRUCT_TYPED_FIELD(std::string, background_b_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, background_b_name),
 	LCF_STRUCT_TYPED_FIELD(bool, background_b_scrollh),
 	LCF_STRUCT_TYPED_FIELD(bool, background_b_scrollv),
 	LCF_STRUCT_TYPED_FIELD(int, background_b_scrollh_speed),
@@ -27,7 +27,7 @@ LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(int, music_type),
 	LCF_STRUCT_TYPED_FIELD(RPG::Music, music),
 	LCF_STRUCT_TYPED_FIELD(int, background_type),
-	LCF_STRUCT_TYPED_FIELD(std::string, background_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, background_name),
 	LCF_STRUCT_TYPED_FIELD(int, teleport),
 	LCF_STRUCT_TYPED_FIELD(int, escape),
 	LCF_STRUCT_TYPED_FIELD(int, save),
@@ -18,7 +18,7 @@
 
 LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(RPG::EventPageCondition, condition),
-	LCF_STRUCT_TYPED_FIELD(std::string, character_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, character_name),
 	LCF_STRUCT_TYPED_FIELD(int, character_index),
 	LCF_STRUCT_TYPED_FIELD(int, character_direction),
 	LCF_STRUCT_TYPED_FIELD(int, character_pattern),
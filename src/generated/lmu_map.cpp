@@ -22,7 +22,7 @@ LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(int, height),
 	LCF_STRUCT_TYPED_FIELD(int, scroll_type),
 	LCF_STRUCT_TYPED_FIELD(bool, parallax_flag),
-	LCF_STRUCT_TYPED_FIELD(std::string, parallax_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, parallax_name),
 	LCF_STRUCT_TYPED_FIELD(bool, parallax_loop_x),
 	LCF_STRUCT_TYPED_FIELD(bool, parallax_loop_y),
 	LCF_STRUCT_TYPED_FIELD(bool, parallax_auto_loop_x),
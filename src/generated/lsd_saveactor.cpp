@@ -19,10 +19,10 @@
 LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(std::string, name),
 	LCF_STRUCT_TYPED_FIELD(std::string, title),
-	LCF_STRUCT_TYPED_FIELD(std::string, sprite_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, sprite_name),
 	LCF_STRUCT_TYPED_FIELD(int, sprite_id),
 	LCF_STRUCT_TYPED_FIELD(int, sprite_flags),
-	LCF_STRUCT_TYPED_FIELD(std::string, face_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, face_name),
 	LCF_STRUCT_TYPED_FIELD(int, face_id),
 	LCF_STRUCT_TYPED_FIELD(int, level),
 	LCF_STRUCT_TYPED_FIELD(int, exp),
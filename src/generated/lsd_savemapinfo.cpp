@@ -24,7 +24,7 @@ LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(std::vector<RPG::SaveMapEvent>, events),
 	LCF_STRUCT_TYPED_FIELD(std::vector<uint8_t>, lower_tiles),
 	LCF_STRUCT_TYPED_FIELD(std::vector<uint8_t>, upper_tiles),
-	LCF_STRUCT_TYPED_FIELD(std::string, parallax_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, parallax_name),
 	LCF_STRUCT_TYPED_FIELD(bool, parallax_horz),
 	LCF_STRUCT_TYPED_FIELD(bool, parallax_vert),
 	LCF_STRUCT_TYPED_FIELD(bool, parallax_horz_auto),
@@ -48,7 +48,7 @@ LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(int, begin_jump_y),
 	LCF_STRUCT_TYPED_FIELD(int, unknown_47_pause),
 	LCF_STRUCT_TYPED_FIELD(bool, flying),
-	LCF_STRUCT_TYPED_FIELD(std::string, sprite_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, sprite_name),
 	LCF_STRUCT_TYPED_FIELD(int, sprite_id),
 	LCF_STRUCT_TYPED_FIELD(int, unknown_4b_sprite_move),
 	LCF_STRUCT_TYPED_FIELD(int, flash_red),
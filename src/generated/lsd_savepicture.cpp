@@ -17,7 +17,7 @@
 #define LCF_CURRENT_STRUCT SavePicture
 
 LCF_STRUCT_FIELDS_BEGIN()
-	LCF_STRUCT_TYPED_FIELD(std::string, name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, name),
 	LCF_STRUCT_TYPED_FIELD(double, start_x),
 	LCF_STRUCT_TYPED_FIELD(double, start_y),
 	LCF_STRUCT_TYPED_FIELD(double, current_x),
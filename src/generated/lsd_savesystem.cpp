@@ -19,7 +19,7 @@
 LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(int, screen),
 	LCF_STRUCT_TYPED_FIELD(int, frame_count),
-	LCF_STRUCT_TYPED_FIELD(std::string, graphics_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, graphics_name),
 	LCF_STRUCT_TYPED_FIELD(int, message_stretch),
 	LCF_STRUCT_TYPED_FIELD(int, font_id),
 	LCF_STRUCT_TYPED_FIELD(int, switches_size),
@@ -30,7 +30,7 @@ LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(int, message_position),
 	LCF_STRUCT_TYPED_FIELD(int, message_prevent_overlap),
 	LCF_STRUCT_TYPED_FIELD(int, message_continue_events),
-	LCF_STRUCT_TYPED_FIELD(std::string, face_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, face_name),
 	LCF_STRUCT_TYPED_FIELD(int, face_id),
 	LCF_STRUCT_TYPED_FIELD(bool, face_right),
 	LCF_STRUCT_TYPED_FIELD(bool, face_flip),
@@ -21,13 +21,13 @@ LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(std::string, hero_name),
 	LCF_STRUCT_TYPED_FIELD(int, hero_level),
 	LCF_STRUCT_TYPED_FIELD(int, hero_hp),
-	LCF_STRUCT_TYPED_FIELD(std::string, face1_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, face1_name),
 	LCF_STRUCT_TYPED_FIELD(int, face1_id),
-	LCF_STRUCT_TYPED_FIELD(std::string, face2_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, face2_name),
 	LCF_STRUCT_TYPED_FIELD(int, face2_id),
-	LCF_STRUCT_TYPED_FIELD(std::string, face3_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, face3_name),
 	LCF_STRUCT_TYPED_FIELD(int, face3_id),
-	LCF_STRUCT_TYPED_FIELD(std::string, face4_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, face4_name),
 	LCF_STRUCT_TYPED_FIELD(int, face4_id),
 LCF_STRUCT_FIELDS_END()
 
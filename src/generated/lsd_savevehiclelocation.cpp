@@ -46,7 +46,7 @@ LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(int, begin_jump_y),
 	LCF_STRUCT_TYPED_FIELD(int, unknown_47_pause),
 	LCF_STRUCT_TYPED_FIELD(bool, flying),
-	LCF_STRUCT_TYPED_FIELD(std::string, sprite_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, sprite_name),
 	LCF_STRUCT_TYPED_FIELD(int, sprite_id),
 	LCF_STRUCT_TYPED_FIELD(int, unknown_4b_sprite_move),
 	LCF_STRUCT_TYPED_FIELD(int, flash_red),
@@ -58,7 +58,7 @@ LCF_STRUCT_FIELDS_BEGIN()
 	LCF_STRUCT_TYPED_FIELD(int, original_move_route_index),
 	LCF_STRUCT_TYPED_FIELD(int, remaining_ascent),
 	LCF_STRUCT_TYPED_FIELD(int, remaining_descent),
-	LCF_STRUCT_TYPED_FIELD(std::string, sprite2_name),
+	LCF_STRUCT_TYPED_FIELD(SharedString, sprite2_name),
 	LCF_STRUCT_TYPED_FIELD(int, sprite2_id),
 LCF_STRUCT_FIELDS_END()
 
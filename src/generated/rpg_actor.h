@@ -16,6 +16,8 @@
 #include "rpg_equipment.h"
 #include "rpg_learning.h"
 #include "rpg_parameters.h"
+#include "rpg_system.h"
+#include "shared_string.h"
 
 /**
  * RPG::Actor class.
@@ -24,18 +26,19 @@ namespace RPG {
 	class Actor {
 	public:
 		void Setup();
+		void Setup(const RPG::System& system);
 
 		int ID = 0;
 		std::string name;
 		std::string title;
-		std::string character_name;
+		SharedString character_name;
 		int character_index = 0;
 		bool transparent = false;
 		int initial_level = 1;
 		int final_level = -1;
 		bool critical_hit = true;
 		int critical_hit_chance = 30;
-		std::string face_name;
+		SharedString face_name;
 		int face_index = 0;
 		bool two_weapon = false;
 		bool lock_equipment = false;
@@ -14,6 +14,7 @@
 #include <vector>
 #include "rpg_animationframe.h"
 #include "rpg_animationtiming.h"
+#include "shared_string.h"
 
 /**
  * RPG::Animation class.
@@ -33,7 +34,7 @@ namespace RPG {
 
 		int ID = 0;
 		std::string name;
-		std::string animation_name;
+		SharedString animation_name;
 		int unknown_03 = -1;
 		std::vector<AnimationTiming> timings;
 		int scope = 0;
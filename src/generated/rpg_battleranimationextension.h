@@ -11,6 +11,7 @@
 
 // Headers
 #include <string>
+#include "shared_string.h"
 
 /**
  * RPG::BattlerAnimationExtension class.
@@ -25,7 +26,7 @@ namespace RPG {
 
 		int ID = 0;
 		std::string name;
-		std::string battler_name;
+		SharedString battler_name;
 		int battler_index = 0;
 		int animation_type = 0;
 		int animation_id = 1;
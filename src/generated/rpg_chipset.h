@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 #include "reader_types.h"
+#include "shared_string.h"
 
 /**
  * RPG::Chipset class.
@@ -30,7 +31,7 @@ namespace RPG {
 
 		int ID = 0;
 		std::string name;
-		std::string chipset_name;
+		SharedString chipset_name;
 		std::vector<int16_t> terrain_data;
 		std::vector<uint8_t> passable_data_lower;
 		std::vector<uint8_t> passable_data_upper;
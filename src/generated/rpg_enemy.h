@@ -14,6 +14,7 @@
 #include <vector>
 #include "reader_types.h"
 #include "rpg_enemyaction.h"
+#include "shared_string.h"
 
 /**
  * RPG::Enemy class.
@@ -23,7 +24,7 @@ namespace RPG {
 	public:
 		int ID = 0;
 		std::string name;
-		std::string battler_name;
+		SharedString battler_name;
 		int battler_hue = 0;
 		int max_hp = 10;
 		int max_sp = 10;
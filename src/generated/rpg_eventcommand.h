@@ -11,7 +11,7 @@
 
 // Headers
 #include <string>
-#include <vector>
+#include "small_vector.h"
 
 /**
  * RPG::EventCommand class.
@@ -155,7 +155,7 @@ namespace RPG {
 		int code = 0;
 		int indent = 0;
 		std::string string;
-		std::vector<int> parameters;
+		SmallVector<int, 4> parameters;
 	};
 }
 
@@ -10,11 +10,11 @@
 #define LCF_RPG_EVENTPAGE_H
 
 // Headers
-#include <string>
 #include <vector>
 #include "rpg_eventcommand.h"
 #include "rpg_eventpagecondition.h"
 #include "rpg_moveroute.h"
+#include "shared_string.h"
 
 /**
  * RPG::EventPage class.
@@ -73,7 +73,7 @@ namespace RPG {
 
 		int ID = 0;
 		EventPageCondition condition;
-		std::string character_name;
+		SharedString character_name;
 		int character_index = 0;
 		int character_direction = 2;
 		int character_pattern = 1;
@@ -10,10 +10,10 @@
 #define LCF_RPG_MAP_H
 
 // Headers
-#include <string>
 #include <vector>
 #include "reader_types.h"
 #include "rpg_event.h"
+#include "shared_string.h"
 
 /**
  * RPG::Map class.
@@ -43,7 +43,7 @@ namespace RPG {
 		int height = 15;
 		int scroll_type = 0;
 		bool parallax_flag = false;
-		std::string parallax_name;
+		SharedString parallax_name;
 		bool parallax_loop_x = false;
 		bool parallax_loop_y = false;
 		bool parallax_auto_loop_x = false;
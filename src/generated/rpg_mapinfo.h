@@ -15,6 +15,7 @@
 #include "rpg_encounter.h"
 #include "rpg_music.h"
 #include "rpg_rect.h"
+#include "shared_string.h"
 
 /**
  * RPG::MapInfo class.
@@ -52,7 +53,7 @@ namespace RPG {
 		int music_type = 0;
 		Music music;
 		int background_type = 0;
-		std::string background_name;
+		SharedString background_name;
 		int teleport = 0;
 		int escape = 0;
 		int save = 0;
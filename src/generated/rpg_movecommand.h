@@ -10,7 +10,7 @@
 #define LCF_RPG_MOVECOMMAND_H
 
 // Headers
-#include <string>
+#include "shared_string.h"
 
 /**
  * RPG::MoveCommand class.
@@ -66,7 +66,7 @@ namespace RPG {
 		};
 
 		int command_id = 0;
-		std::string parameter_string;
+		SharedString parameter_string;
 		int parameter_a = 0;
 		int parameter_b = 0;
 		int parameter_c = 0;
@@ -10,7 +10,7 @@
 #define LCF_RPG_MUSIC_H
 
 // Headers
-#include <string>
+#include "shared_string.h"
 
 /**
  * RPG::Music class.
@@ -18,7 +18,7 @@
 namespace RPG {
 	class Music {
 	public:
-		std::string name;
+		SharedString name;
 		int fadein = 0;
 		int volume = 100;
 		int tempo = 100;
@@ -11,6 +11,7 @@
 
 // Headers
 #include <vector>
+#include "rpg_database.h"
 #include "rpg_saveactor.h"
 #include "rpg_savecommonevent.h"
 #include "rpg_saveeventdata.h"
@@ -31,6 +32,7 @@ namespace RPG {
 	class Save {
 	public:
 		void Setup();
+		void Setup(const RPG::Database& db);
 
 		SaveTitle title;
 		SaveSystem system;
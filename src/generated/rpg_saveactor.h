@@ -13,6 +13,8 @@
 #include <string>
 #include <vector>
 #include "reader_types.h"
+#include "rpg_actor.h"
+#include "shared_string.h"
 
 /**
  * RPG::SaveActor class.
@@ -21,15 +23,17 @@ namespace RPG {
 	class SaveActor {
 	public:
 		void Setup(int actor_id);
+		void Setup(const RPG::Actor& actor);
 		void Fixup(int actor_id);
+		void Fixup(const RPG::Actor& actor);
 
 		int ID = 0;
 		std::string name;
 		std::string title;
-		std::string sprite_name;
+		SharedString sprite_name;
 		int sprite_id = 0;
 		int sprite_flags = 0;
-		std::string face_name;
+		SharedString face_name;
 		int face_id = 0;
 		int level = -1;
 		int exp = -1;
@@ -12,6 +12,7 @@
 // Headers
 #include <vector>
 #include "reader_types.h"
+#include "rpg_system.h"
 
 /**
  * RPG::SaveInventory class.
@@ -20,6 +21,7 @@ namespace RPG {
 	class SaveInventory {
 	public:
 		void Setup();
+		void Setup(const RPG::System& system);
 
 		int party_size = -1;
 		std::vector<int16_t> party;
@@ -10,10 +10,10 @@
 #define LCF_RPG_SAVEMAPEVENT_H
 
 // Headers
-#include <string>
 #include "rpg_event.h"
 #include "rpg_moveroute.h"
 #include "rpg_saveeventdata.h"
+#include "shared_string.h"
 
 /**
  * RPG::SaveMapEvent class.
@@ -55,7 +55,7 @@ namespace RPG {
 		int begin_jump_y = 0;
 		int unknown_47_pause = 0;
 		bool flying = false;
-		std::string sprite_name;
+		SharedString sprite_name;
 		int sprite_id = -1;
 		int unknown_4b_sprite_move = -1;
 		int flash_red = 100;
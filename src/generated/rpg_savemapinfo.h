@@ -10,12 +10,12 @@
 #define LCF_RPG_SAVEMAPINFO_H
 
 // Headers
-#include <string>
 #include <vector>
 #include "reader_types.h"
 #include "rpg_map.h"
 #include "rpg_mapinfo.h"
 #include "rpg_savemapevent.h"
+#include "shared_string.h"
 
 /**
  * RPG::SaveMapInfo class.
@@ -35,7 +35,7 @@ namespace RPG {
 		std::vector<SaveMapEvent> events;
 		std::vector<uint8_t> lower_tiles;
 		std::vector<uint8_t> upper_tiles;
-		std::string parallax_name;
+		SharedString parallax_name;
 		bool parallax_horz = false;
 		bool parallax_vert = false;
 		bool parallax_horz_auto = false;
@@ -10,8 +10,8 @@
 #define LCF_RPG_SAVEPARTYLOCATION_H
 
 // Headers
-#include <string>
 #include "rpg_moveroute.h"
+#include "shared_string.h"
 
 /**
  * RPG::SavePartyLocation class.
@@ -57,7 +57,7 @@ namespace RPG {
 		int begin_jump_y = 0;
 		int unknown_47_pause = 0;
 		bool flying = false;
-		std::string sprite_name;
+		SharedString sprite_name;
 		int sprite_id = 0;
 		int unknown_4b_sprite_move = 0;
 		int flash_red = 100;
@@ -10,7 +10,7 @@
 #define LCF_RPG_SAVEPICTURE_H
 
 // Headers
-#include <string>
+#include "shared_string.h"
 
 /**
  * RPG::SavePicture class.
@@ -19,7 +19,7 @@ namespace RPG {
 	class SavePicture {
 	public:
 		int ID = 0;
-		std::string name;
+		SharedString name;
 		double start_x = 0.0;
 		double start_y = 0.0;
 		double current_x = 0.0;
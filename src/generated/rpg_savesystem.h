@@ -13,8 +13,10 @@
 #include <string>
 #include <vector>
 #include "reader_types.h"
+#include "rpg_database.h"
 #include "rpg_music.h"
 #include "rpg_sound.h"
+#include "shared_string.h"
 
 /**
  * RPG::SaveSystem class.
@@ -28,11 +30,13 @@ namespace RPG {
 		};
 
 		void Setup();
+		void Setup(const RPG::Database& db);
 		void Fixup();
+		void Fixup(const RPG::Database& db);
 
 		int screen = 1;
 		int frame_count = 0;
-		std::string graphics_name;
+		SharedString graphics_name;
 		int message_stretch = 0;
 		int font_id = 0;
 		int switches_size = 0;
@@ -43,7 +47,7 @@ namespace RPG {
 		int message_position = 2;
 		int message_prevent_overlap = 1;
 		int message_continue_events = 0;
-		std::string face_name;
+		SharedString face_name;
 		int face_id = 0;
 		bool face_right = false;
 		bool face_flip = false;
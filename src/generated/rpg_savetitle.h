@@ -11,6 +11,7 @@
 
 // Headers
 #include <string>
+#include "shared_string.h"
 
 /**
  * RPG::SaveTitle class.
@@ -22,13 +23,13 @@ namespace RPG {
 		std::string hero_name;
 		int hero_level = 0;
 		int hero_hp = 0;
-		std::string face1_name;
+		SharedString face1_name;
 		int face1_id = 0;
-		std::string face2_name;
+		SharedString face2_name;
 		int face2_id = 0;
-		std::string face3_name;
+		SharedString face3_name;
 		int face3_id = 0;
-		std::string face4_name;
+		SharedString face4_name;
 		int face4_id = 0;
 	};
 }
@@ -10,8 +10,8 @@
 #define LCF_RPG_SAVEVEHICLELOCATION_H
 
 // Headers
-#include <string>
 #include "rpg_moveroute.h"
+#include "shared_string.h"
 
 /**
  * RPG::SaveVehicleLocation class.
@@ -48,7 +48,7 @@ namespace RPG {
 		int begin_jump_y = 0;
 		int unknown_47_pause = 0;
 		bool flying = false;
-		std::string sprite_name;
+		SharedString sprite_name;
 		int sprite_id = 0;
 		int unknown_4b_sprite_move = 0;
 		int flash_red = 100;
@@ -60,7 +60,7 @@ namespace RPG {
 		int original_move_route_index = 0;
 		int remaining_ascent = 0;
 		int remaining_descent = 0;
-		std::string sprite2_name;
+		SharedString sprite2_name;
 		int sprite2_id = 0;
 	};
 }
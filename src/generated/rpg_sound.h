@@ -10,7 +10,7 @@
 #define LCF_RPG_SOUND_H
 
 // Headers
-#include <string>
+#include "shared_string.h"
 
 /**
  * RPG::Sound class.
@@ -18,7 +18,7 @@
 namespace RPG {
 	class Sound {
 	public:
-		std::string name;
+		SharedString name;
 		int volume = 100;
 		int tempo = 100;
 		int balance = 50;
@@ -16,6 +16,7 @@
 #include "rpg_music.h"
 #include "rpg_sound.h"
 #include "rpg_testbattler.h"
+#include "shared_string.h"
 
 /**
  * RPG::System class.
@@ -93,16 +94,16 @@ namespace RPG {
 		};
 
 		int ldb_id = 0;
-		std::string boat_name;
-		std::string ship_name;
-		std::string airship_name;
+		SharedString boat_name;
+		SharedString ship_name;
+		SharedString airship_name;
 		int boat_index = 0;
 		int ship_index = 0;
 		int airship_index = 0;
-		std::string title_name;
-		std::string gameover_name;
-		std::string system_name;
-		std::string system2_name;
+		SharedString title_name;
+		SharedString gameover_name;
+		SharedString system_name;
+		SharedString system2_name;
 		std::vector<int16_t> party;
 		std::vector<int16_t> menu_commands;
 		Music title_music;
@@ -143,7 +144,7 @@ namespace RPG {
 		int battletest_condition = 0;
 		int unknown_61 = -1;
 		bool show_frame = false;
-		std::string frame_name;
+		SharedString frame_name;
 		bool invert_animations = false;
 		bool show_title = true;
 	};
@@ -12,6 +12,7 @@
 // Headers
 #include <string>
 #include "rpg_sound.h"
+#include "shared_string.h"
 
 /**
  * RPG::Terrain class.
@@ -34,7 +35,7 @@ namespace RPG {
 		std::string name;
 		int damage = 0;
 		int encounter_rate = 100;
-		std::string background_name;
+		SharedString background_name;
 		bool boat_pass = false;
 		bool ship_pass = false;
 		bool airship_pass = true;
@@ -43,13 +44,13 @@ namespace RPG {
 		Sound footstep;
 		bool on_damage_se = false;
 		int background_type = 0;
-		std::string background_a_name;
+		SharedString background_a_name;
 		bool background_a_scrollh = false;
 		bool background_a_scrollv = false;
 		int background_a_scrollh_speed = 0;
 		int background_a_scrollv_speed = 0;
 		bool background_b = false;
-		std::string background_b_name;
+		SharedString background_b_name;
 		bool background_b_scrollh = false;
 		bool background_b_scrollv = false;
 		int background_b_scrollh_speed = 0;
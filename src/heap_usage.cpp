@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include "heap_usage.h"
+#include "reader_struct.h"
+#include "rpg_database.h"
+#include "rpg_map.h"
+#include "rpg_save.h"
+#include "rpg_treemap.h"
+
+static void ClearEntry(HeapUsage::Entry& entry) {
+	entry.objects = 0;
+	entry.bytes = 0;
+	entry.allocations = 0;
+	entry.string_bytes = 0;
+}
+
+HeapUsage::HeapUsage() : owner(&root) {
+	ClearEntry(root);
+}
+
+HeapUsage::HeapUsage(const HeapUsage& other) :
+	entries(other.entries),
+	root(other.root),
+	owner(&root),
+	shared(other.shared)
+{
+}
+
+HeapUsage& HeapUsage::operator=(const HeapUsage& other) {
+	entries = other.entries;
+	root = other.root;
+	owner = &root;
+	shared = other.shared;
+	return *this;
+}
+
+HeapUsage HeapUsage::Of(const RPG::Database& db) {
+	HeapUsage usage;
+	TypeReader<RPG::Database>::HeapSize(db, usage);
+	return usage;
+}
+
+HeapUsage HeapUsage::Of(const RPG::TreeMap& treemap) {
+	HeapUsage usage;
+	TypeReader<RPG::TreeMap>::HeapSize(treemap, usage);
+	return usage;
+}
+
+HeapUsage HeapUsage::Of(const RPG::Map& map) {
+	HeapUsage usage;
+	TypeReader<RPG::Map>::HeapSize(map, usage);
+	return usage;
+}
+
+HeapUsage HeapUsage::Of(const RPG::Save& save) {
+	HeapUsage usage;
+	TypeReader<RPG::Save>::HeapSize(save, usage);
+	return usage;
+}
+
+std::vector<HeapUsage::Entry> HeapUsage::Sections(const RPG::Database& db) {
+	std::vector<Entry> sections;
+	Struct<RPG::Database>::HeapSizeByField(db, sections);
+	return sections;
+}
+
+std::vector<HeapUsage::Entry> HeapUsage::Sections(const RPG::Map& map) {
+	std::vector<Entry> sections;
+	Struct<RPG::Map>::HeapSizeByField(map, sections);
+	return sections;
+}
+
+std::vector<HeapUsage::Entry> HeapUsage::Sections(const RPG::Save& save) {
+	std::vector<Entry> sections;
+	Struct<RPG::Save>::HeapSizeByField(save, sections);
+	return sections;
+}
+
+static bool MoreBytes(const HeapUsage::Entry& a, const HeapUsage::Entry& b) {
+	return a.bytes > b.bytes;
+}
+
+std::vector<HeapUsage::Entry> HeapUsage::Get() const {
+	std::vector<Entry> result;
+	std::map<const char*, Entry, NameLess>::const_iterator it;
+	for (it = entries.begin(); it != entries.end(); ++it)
+		result.push_back(it->second);
+	std::stable_sort(result.begin(), result.end(), MoreBytes);
+	return result;
+}
+
+bool HeapUsage::Get(const std::string& name, Entry& entry) const {
+	std::map<const char*, Entry, NameLess>::const_iterator it = entries.find(name.c_str());
+	if (it == entries.end())
+		return false;
+	entry = it->second;
+	return true;
+}
+
+unsigned long long HeapUsage::Bytes() const {
+	unsigned long long bytes = root.bytes;
+	std::map<const char*, Entry, NameLess>::const_iterator it;
+	for (it = entries.begin(); it != entries.end(); ++it)
+		bytes += it->second.bytes;
+	return bytes;
+}
+
+uint32_t HeapUsage::Allocations() const {
+	uint32_t allocations = root.allocations;
+	std::map<const char*, Entry, NameLess>::const_iterator it;
+	for (it = entries.begin(); it != entries.end(); ++it)
+		allocations += it->second.allocations;
+	return allocations;
+}
+
+uint32_t HeapUsage::Objects() const {
+	uint32_t objects = 0;
+	std::map<const char*, Entry, NameLess>::const_iterator it;
+	for (it = entries.begin(); it != entries.end(); ++it)
+		objects += it->second.objects;
+	return objects;
+}
+
+HeapUsage::Entry* HeapUsage::BeginObject(const char* name) {
+	Entry* previous = owner;
+	owner = Lookup(name);
+	owner->objects++;
+	return previous;
+}
+
+void HeapUsage::EndObject(Entry* previous) {
+	owner = previous;
+}
+
+HeapUsage::Entry* HeapUsage::Lookup(const char* name) {
+	std::map<const char*, Entry, NameLess>::iterator it = entries.find(name);
+	if (it != entries.end())
+		return &it->second;
+
+	Entry& entry = entries[name];
+	entry.name = name;
+	ClearEntry(entry);
+	return &entry;
+}
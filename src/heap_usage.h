@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#ifndef LCF_HEAP_USAGE_H
+#define LCF_HEAP_USAGE_H
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "reader_types.h"
+#include "shared_string.h"
+#include "small_vector.h"
+
+namespace RPG {
+	class Database;
+	class Map;
+	class Save;
+	class TreeMap;
+}
+
+/**
+ * Heap memory owned by loaded data.
+ *
+ * Gathered by walking the field tables: every string that does not fit
+ * into the string object itself and every vector buffer counts as one
+ * allocation. Bytes are the requested sizes, allocator overhead is not
+ * included. Buffers of struct vectors are counted for the element type,
+ * everything else for the struct owning the field.
+ */
+class HeapUsage {
+public:
+	/**
+	 * Usage of one struct type or section.
+	 */
+	struct Entry {
+		std::string name;
+		/** Number of objects walked. */
+		uint32_t objects;
+		/** Heap bytes owned. */
+		unsigned long long bytes;
+		/** Heap blocks owned. */
+		uint32_t allocations;
+		/** Part of bytes in strings. */
+		unsigned long long string_bytes;
+	};
+
+	HeapUsage();
+	HeapUsage(const HeapUsage& other);
+	HeapUsage& operator=(const HeapUsage& other);
+
+	/**
+	 * Walks a database, map tree, map or save.
+	 */
+	static HeapUsage Of(const RPG::Database& db);
+	static HeapUsage Of(const RPG::TreeMap& treemap);
+	static HeapUsage Of(const RPG::Map& map);
+	static HeapUsage Of(const RPG::Save& save);
+
+	/**
+	 * Returns the usage of each top-level field, for example actors or
+	 * commonevents of the database, in field order.
+	 */
+	static std::vector<Entry> Sections(const RPG::Database& db);
+	static std::vector<Entry> Sections(const RPG::Map& map);
+	static std::vector<Entry> Sections(const RPG::Save& save);
+
+	/**
+	 * Returns the usage per struct type, most bytes first.
+	 */
+	std::vector<Entry> Get() const;
+
+	/**
+	 * Returns the usage of one struct type.
+	 *
+	 * @return true if an object of the type was walked.
+	 */
+	bool Get(const std::string& name, Entry& entry) const;
+
+	/** Total heap bytes. */
+	unsigned long long Bytes() const;
+	/** Total heap blocks. */
+	uint32_t Allocations() const;
+	/** Total objects walked. */
+	uint32_t Objects() const;
+
+	// Used by the field walkers
+
+	/**
+	 * Starts an object of a struct type, following usage is counted
+	 * for it.
+	 *
+	 * @param name struct name, must be a static string.
+	 * @return the previous owner, to be passed to EndObject.
+	 */
+	Entry* BeginObject(const char* name);
+
+	/**
+	 * Returns to the owner before BeginObject.
+	 */
+	void EndObject(Entry* owner);
+
+	/**
+	 * Counts the buffer of a struct vector for the element type.
+	 */
+	template <class T>
+	void AddElements(const char* name, const std::vector<T>& vec) {
+		if (vec.capacity() == 0)
+			return;
+		Entry* entry = Lookup(name);
+		entry->bytes += vec.capacity() * sizeof(T);
+		entry->allocations++;
+	}
+
+	/**
+	 * Counts a string of the current object.
+	 */
+	void Add(const std::string& str) {
+		// Short strings are stored inside the object
+		const char* data = str.data();
+		if (data >= (const char*) &str && data < (const char*) (&str + 1))
+			return;
+		owner->bytes += str.capacity() + 1;
+		owner->string_bytes += str.capacity() + 1;
+		owner->allocations++;
+	}
+
+	/**
+	 * Counts a vector of the current object.
+	 */
+	template <class T>
+	void Add(const std::vector<T>& vec) {
+		if (vec.capacity() == 0)
+			return;
+		owner->bytes += vec.capacity() * sizeof(T);
+		owner->allocations++;
+	}
+
+	/**
+	 * Counts a small vector of the current object, nothing while it is
+	 * stored inside the object.
+	 */
+	template <class T, size_t N>
+	void Add(const SmallVector<T, N>& vec) {
+		if (vec.IsInline())
+			return;
+		owner->bytes += vec.capacity() * sizeof(T);
+		owner->allocations++;
+	}
+
+	/**
+	 * Counts a shared string of the current object. A buffer shared by
+	 * several strings is counted once, for the first owner walked.
+	 */
+	void Add(const SharedString& str) {
+		if (str.empty() || !shared.insert(&str.str()).second)
+			return;
+		owner->bytes += SharedString::NodeSize();
+		owner->string_bytes += SharedString::NodeSize();
+		owner->allocations++;
+		Add(str.str());
+	}
+
+	void Add(const std::vector<bool>& vec) {
+		if (vec.capacity() == 0)
+			return;
+		owner->bytes += vec.capacity() / 8;
+		owner->allocations++;
+	}
+
+private:
+	struct NameLess {
+		bool operator()(const char* a, const char* b) const {
+			return strcmp(a, b) < 0;
+		}
+	};
+
+	Entry* Lookup(const char* name);
+
+	std::map<const char*, Entry, NameLess> entries;
+	/** Usage outside of any struct, like the buffer of a top-level vector. */
+	Entry root;
+	Entry* owner;
+	/** Buffers of the shared strings counted so far. */
+	std::unordered_set<const std::string*> shared;
+};
+
+#endif
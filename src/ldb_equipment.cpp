@@ -15,6 +15,7 @@ struct RawStruct<RPG::Equipment> {
 	static int LcfSize(const RPG::Equipment& ref, LcfWriter& stream);
 	static void WriteXml(const RPG::Equipment& ref, XmlWriter& stream);
 	static void BeginXml(RPG::Equipment& ref, XmlReader& stream);
+	static void HeapSize(const RPG::Equipment& ref, HeapUsage& usage);
 };
 
 /**
@@ -82,5 +83,8 @@ public:
 };
 
 void RawStruct<RPG::Equipment>::BeginXml(RPG::Equipment& ref, XmlReader& stream) {
-	stream.SetHandler(new WrapperXmlHandler("Equipment", new EquipmentXmlHandler(ref)));
+	stream.SetHandler(stream.MakeHandler<WrapperXmlHandler>("Equipment", stream.MakeHandler<EquipmentXmlHandler>(ref)));
+}
+
+void RawStruct<RPG::Equipment>::HeapSize(const RPG::Equipment& /* ref */, HeapUsage& /* usage */) {
 }
@@ -4,8 +4,11 @@
  * http://opensource.org/licenses/MIT
  */
 
+#include <algorithm>
 #include <string>
 #include <vector>
+#include "event_command_list.h"
+#include "reader_stats.h"
 #include "reader_struct.h"
 #include "rpg_eventcommand.h"
 
@@ -16,29 +19,43 @@ struct RawStruct<RPG::EventCommand> {
 	static int LcfSize(const RPG::EventCommand& ref, LcfWriter& stream);
 	static void WriteXml(const RPG::EventCommand& ref, XmlWriter& stream);
 	static void BeginXml(RPG::EventCommand& ref, XmlReader& stream);
+	static void HeapSize(const RPG::EventCommand& ref, HeapUsage& usage);
 };
 
 template <>
 struct RawStruct<std::vector<RPG::EventCommand> > {
 	static void ReadLcf(std::vector<RPG::EventCommand>& ref, LcfReader& stream, uint32_t length);
+	static void ReadLcf(EventCommandList& ref, LcfReader& stream, uint32_t length);
 	static void WriteLcf(const std::vector<RPG::EventCommand>& ref, LcfWriter& stream);
 	static int LcfSize(const std::vector<RPG::EventCommand>& ref, LcfWriter& stream);
 	static void WriteXml(const std::vector<RPG::EventCommand>& ref, XmlWriter& stream);
 	static void BeginXml(std::vector<RPG::EventCommand>& ref, XmlReader& stream);
+	static void HeapSize(const std::vector<RPG::EventCommand>& ref, HeapUsage& usage);
 };
 
+/**
+ * Reads the fields of an event command that follow its code.
+ */
+static void ReadEventCommandBody(RPG::EventCommand& event_command, LcfReader& stream) {
+	stream.Read(event_command.indent);
+	stream.ReadString(event_command.string, stream.ReadInt());
+	int count = stream.ReadInt();
+	if (count > 0) {
+		size_t start = event_command.parameters.size();
+		event_command.parameters.resize(start + count);
+		int* parameters = &event_command.parameters[start];
+		for (int i = 0; i < count; i++)
+			parameters[i] = stream.ReadInt();
+	}
+}
+
 /**
  * Reads Event Command.
  */
 void RawStruct<RPG::EventCommand>::ReadLcf(RPG::EventCommand& event_command, LcfReader& stream, uint32_t /* length */) {
 	stream.Read(event_command.code);
-	if (event_command.code != 0) {
-		stream.Read(event_command.indent);
-		stream.ReadString(event_command.string, stream.ReadInt());
-		for (int i = stream.ReadInt(); i > 0; i--) {
-			event_command.parameters.push_back(stream.ReadInt());
-		}
-	}
+	if (event_command.code != 0)
+		ReadEventCommandBody(event_command, stream);
 }
 
 void RawStruct<RPG::EventCommand>::WriteLcf(const RPG::EventCommand& event_command, LcfWriter& stream) {
@@ -70,7 +87,7 @@ void RawStruct<RPG::EventCommand>::WriteXml(const RPG::EventCommand& event_comma
 	stream.WriteNode<int>("code", event_command.code);
 	stream.WriteNode<int>("indent", event_command.indent);
 	stream.WriteNode<std::string>("string", event_command.string);
-	stream.WriteNode<std::vector<int> >("parameters", event_command.parameters);
+	stream.WriteNode<SmallVector<int, 4> >("parameters", event_command.parameters);
 	stream.EndElement("EventCommand");
 }
 
@@ -117,46 +134,195 @@ public:
 				XmlReader::Read<std::string>(ref.string, data);
 				break;
 			case Parameters:
-				XmlReader::Read<std::vector<int> >(ref.parameters, data);
+				XmlReader::Read<SmallVector<int, 4> >(ref.parameters, data);
 				break;
 		}
 	}
 };
 
 void RawStruct<RPG::EventCommand>::BeginXml(RPG::EventCommand& ref, XmlReader& stream) {
-	stream.SetHandler(new WrapperXmlHandler("EventCommand", new EventCommandXmlHandler(ref)));
+	stream.SetHandler(stream.MakeHandler<WrapperXmlHandler>("EventCommand", stream.MakeHandler<EventCommandXmlHandler>(ref)));
+}
+
+namespace {
+	/** Sizes of the commands of a chunk, see ScanEventCommands. */
+	struct EventCommandCounts {
+		size_t commands;
+		size_t parameters;
+		size_t string_bytes;
+	};
 }
 
 /**
- * Reads event commands.
+ * Decodes a compressed integer of a buffer and advances p past it.
+ *
+ * @return false if the integer does not end before end.
  */
-void RawStruct<std::vector<RPG::EventCommand> >::ReadLcf(
-	std::vector<RPG::EventCommand>& event_commands, LcfReader& stream, uint32_t length) {
+static bool ScanInt(const uint8_t*& p, const uint8_t* end, uint32_t& value) {
+	value = 0;
+	while (p < end) {
+		uint8_t byte = *p++;
+		value = (value << 7) | (byte & 0x7F);
+		if (!(byte & 0x80))
+			return true;
+	}
+	return false;
+}
+
+/**
+ * Counts the commands of an event command chunk in memory without
+ * decoding them. Stops at the terminator or at the first command that
+ * does not end inside the data, so the counts are exact for a valid
+ * chunk and only a lower bound otherwise.
+ */
+static EventCommandCounts ScanEventCommands(const char* data, size_t size) {
+	EventCommandCounts counts = { 0, 0, 0 };
+	const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+	const uint8_t* end = p + size;
+	uint32_t code, value, string_size, parameter_count;
+	while (ScanInt(p, end, code) && code != 0) {
+		if (!ScanInt(p, end, value) || !ScanInt(p, end, string_size) || string_size > (size_t)(end - p))
+			break;
+		p += string_size;
+		if (!ScanInt(p, end, parameter_count))
+			break;
+		uint32_t i = 0;
+		while (i < parameter_count && ScanInt(p, end, value))
+			i++;
+		if (i < parameter_count)
+			break;
+		counts.commands++;
+		counts.parameters += parameter_count;
+		counts.string_bytes += string_size;
+	}
+	return counts;
+}
+
+/**
+ * Reads event commands into a sink. The sink reserves room for the
+ * counted commands with Reserve, hands out the command to read into with
+ * Next, takes it over with Commit and is told the end with Finish.
+ *
+ * Memory readers are scanned first, so the sink grows only once.
+ */
+template <class Sink>
+static void ReadEventCommands(Sink& sink, LcfReader& stream, uint32_t length) {
+#ifdef LCF_INSTRUMENT
+	ReaderStats::Scope stats("EventCommands", ReaderStats::Read);
+	stats.SetBytes(length);
+#endif
 	// Event Commands is a special array
 	// Has no size information. Is terminated by 4 times 0x00.
 	unsigned long startpos = stream.Tell();
 	unsigned long endpos = startpos + length;
+	size_t available;
+	const char* data = stream.Peek(available);
+	if (data != NULL)
+		sink.Reserve(ScanEventCommands(data, std::min<size_t>(available, length)));
 	for (;;) {
-		uint8_t ch;
-		stream.Read(ch);
-		if (ch == 0) {
+		int code = stream.ReadInt();
+		if (code == 0) {
 			stream.Seek(3, LcfReader::FromCurrent);
 			break;
 		}
-		stream.Ungetch(ch);
-		RPG::EventCommand command;
-		RawStruct<RPG::EventCommand>::ReadLcf(command, stream, 0);
-		event_commands.push_back(command);
+		RPG::EventCommand& command = sink.Next();
+		command.code = code;
+		ReadEventCommandBody(command, stream);
+		sink.Commit();
 	}
+	sink.Finish();
 	assert(stream.Tell() == endpos);
 }
 
+namespace {
+	/**
+	 * Reads every command directly into an element of a vector. Elements
+	 * already in the vector are reused with their storage, the remaining
+	 * ones are removed by Finish.
+	 */
+	struct VectorSink {
+		std::vector<RPG::EventCommand>& commands;
+		size_t used;
+		void Reserve(const EventCommandCounts& counts) {
+			commands.reserve(counts.commands);
+		}
+		RPG::EventCommand& Next() {
+			if (used == commands.size())
+				commands.emplace_back();
+			RPG::EventCommand& command = commands[used++];
+			command.parameters.clear();
+			return command;
+		}
+		void Commit() {}
+		void Finish() {
+			commands.resize(used);
+		}
+	};
+
+	/** Reads every command into one reused command and appends it to a list. */
+	struct ListSink {
+		EventCommandList& list;
+		RPG::EventCommand command;
+		void Reserve(const EventCommandCounts& counts) {
+			list.Reserve(counts.commands, counts.parameters, counts.string_bytes);
+		}
+		RPG::EventCommand& Next() {
+			command.parameters.clear();
+			return command;
+		}
+		void Commit() {
+			list.Add(command);
+		}
+		void Finish() {}
+	};
+}
+
+/**
+ * Reads event commands.
+ */
+void RawStruct<std::vector<RPG::EventCommand> >::ReadLcf(
+	std::vector<RPG::EventCommand>& event_commands, LcfReader& stream, uint32_t length) {
+	VectorSink sink = { event_commands, 0 };
+	ReadEventCommands(sink, stream, length);
+}
+
+void RawStruct<std::vector<RPG::EventCommand> >::ReadLcf(EventCommandList& event_commands, LcfReader& stream, uint32_t length) {
+	event_commands.Clear();
+	ListSink sink = { event_commands, RPG::EventCommand() };
+	ReadEventCommands(sink, stream, length);
+}
+
+void EventCommandList::ReadLcf(LcfReader& stream, uint32_t length) {
+	RawStruct<std::vector<RPG::EventCommand> >::ReadLcf(*this, stream, length);
+}
+
+void EventCommandList::WriteLcf(LcfWriter& stream) const {
+	RPG::EventCommand command;
+	for (size_t i = 0; i < Size(); i++) {
+		command.code = GetCode(i);
+		command.indent = GetIndent(i);
+		command.string.assign(GetStringData(i), GetStringSize(i));
+		command.parameters.assign(GetParameters(i), GetParameters(i) + GetParameterCount(i));
+		RawStruct<RPG::EventCommand>::WriteLcf(command, stream);
+	}
+	for (int i = 0; i < 4; i++)
+		stream.WriteInt(0);
+}
+
 void RawStruct<std::vector<RPG::EventCommand> >::WriteLcf(const std::vector<RPG::EventCommand>& event_commands, LcfWriter& stream) {
+#ifdef LCF_INSTRUMENT
+	ReaderStats::Scope stats("EventCommands", ReaderStats::Write);
+	uint32_t startpos = stream.Tell();
+#endif
 	int count = event_commands.size();
 	for (int i = 0; i < count; i++)
 		RawStruct<RPG::EventCommand>::WriteLcf(event_commands[i], stream);
 	for (int i = 0; i < 4; i++)
 		stream.WriteInt(0);
+
+#ifdef LCF_INSTRUMENT
+	stats.SetBytes(stream.Tell() - startpos);
+#endif
 }
 
 int RawStruct<std::vector<RPG::EventCommand> >::LcfSize(const std::vector<RPG::EventCommand>& event_commands, LcfWriter& stream) {
@@ -183,12 +349,25 @@ public:
 			stream.Error("Expecting %s but got %s", "EventCommand", name);
 		ref.resize(ref.size() + 1);
 		RPG::EventCommand& obj = ref.back();
-		stream.SetHandler(new EventCommandXmlHandler(obj));
+		stream.SetHandler(stream.MakeHandler<EventCommandXmlHandler>(obj));
 	}
 private:
 	std::vector<RPG::EventCommand>& ref;
 };
 
 void RawStruct<std::vector<RPG::EventCommand> >::BeginXml(std::vector<RPG::EventCommand>& obj, XmlReader& stream) {
-	stream.SetHandler(new EventCommandVectorXmlHandler(obj));
+	stream.SetHandler(stream.MakeHandler<EventCommandVectorXmlHandler>(obj));
+}
+
+void RawStruct<RPG::EventCommand>::HeapSize(const RPG::EventCommand& ref, HeapUsage& usage) {
+	HeapUsage::Entry* owner = usage.BeginObject("EventCommand");
+	usage.Add(ref.string);
+	usage.Add(ref.parameters);
+	usage.EndObject(owner);
+}
+
+void RawStruct<std::vector<RPG::EventCommand> >::HeapSize(const std::vector<RPG::EventCommand>& ref, HeapUsage& usage) {
+	usage.AddElements("EventCommand", ref);
+	for (size_t i = 0; i < ref.size(); i++)
+		RawStruct<RPG::EventCommand>::HeapSize(ref[i], usage);
 }
@@ -15,6 +15,7 @@ struct RawStruct<RPG::Parameters> {
 	static int LcfSize(const RPG::Parameters& ref, LcfWriter& stream);
 	static void WriteXml(const RPG::Parameters& ref, XmlWriter& stream);
 	static void BeginXml(RPG::Parameters& ref, XmlReader& stream);
+	static void HeapSize(const RPG::Parameters& ref, HeapUsage& usage);
 };
 
 /**
@@ -88,5 +89,16 @@ public:
 };
 
 void RawStruct<RPG::Parameters>::BeginXml(RPG::Parameters& ref, XmlReader& stream) {
-	stream.SetHandler(new WrapperXmlHandler("Parameters", new ParametersXmlHandler(ref)));
+	stream.SetHandler(stream.MakeHandler<WrapperXmlHandler>("Parameters", stream.MakeHandler<ParametersXmlHandler>(ref)));
+}
+
+void RawStruct<RPG::Parameters>::HeapSize(const RPG::Parameters& ref, HeapUsage& usage) {
+	HeapUsage::Entry* owner = usage.BeginObject("Parameters");
+	usage.Add(ref.maxhp);
+	usage.Add(ref.maxsp);
+	usage.Add(ref.attack);
+	usage.Add(ref.defense);
+	usage.Add(ref.spirit);
+	usage.Add(ref.agility);
+	usage.EndObject(owner);
 }
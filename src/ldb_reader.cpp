@@ -11,6 +11,10 @@
 #include "reader_struct.h"
 
 bool LDB_Reader::Load(const std::string& filename, const std::string& encoding) {
+	return Load(filename, encoding, Data::data);
+}
+
+bool LDB_Reader::Load(const std::string& filename, const std::string& encoding, RPG::Database& db) {
 	LcfReader reader(filename, encoding);
 	if (!reader.IsOk()) {
 		LcfReader::SetError("Couldn't find %s database file.\n", filename.c_str());
@@ -25,19 +29,23 @@ bool LDB_Reader::Load(const std::string& filename, const std::string& encoding)
 	if (header != "LcfDataBase") {
 		fprintf(stderr, "Warning: %s header is not LcfDataBase and might not be a valid RPG2000 database.\n", filename.c_str());
 	}
-	TypeReader<RPG::Database>::ReadLcf(Data::data, reader, 0);
+	TypeReader<RPG::Database>::ReadLcf(db, reader, 0);
 
 	// Delayed initialization of some actor fields because they are engine
 	// dependent
 	std::vector<RPG::Actor>::iterator it;
-	for (it = Data::actors.begin(); it != Data::actors.end(); ++it) {
-		(*it).Setup();
+	for (it = db.actors.begin(); it != db.actors.end(); ++it) {
+		(*it).Setup(db.system);
 	}
 
 	return true;
 }
 
 bool LDB_Reader::Save(const std::string& filename, const std::string& encoding) {
+	return Save(filename, Data::data, encoding);
+}
+
+bool LDB_Reader::Save(const std::string& filename, const RPG::Database& db, const std::string& encoding) {
 	LcfWriter writer(filename, encoding);
 	if (!writer.IsOk()) {
 		LcfReader::SetError("Couldn't open %s database file.\n", filename.c_str());
@@ -46,29 +54,37 @@ bool LDB_Reader::Save(const std::string& filename, const std::string& encoding)
 	const std::string header("LcfDataBase");
 	writer.WriteInt(header.size());
 	writer.Write(header);
-	TypeReader<RPG::Database>::WriteLcf(Data::data, writer);
+	TypeReader<RPG::Database>::WriteLcf(db, writer);
 	return true;
 }
 
 bool LDB_Reader::SaveXml(const std::string& filename) {
+	return SaveXml(filename, Data::data);
+}
+
+bool LDB_Reader::SaveXml(const std::string& filename, const RPG::Database& db) {
 	XmlWriter writer(filename);
 	if (!writer.IsOk()) {
 		LcfReader::SetError("Couldn't open %s database file.\n", filename.c_str());
 		return false;
 	}
 	writer.BeginElement("LDB");
-	TypeReader<RPG::Database>::WriteXml(Data::data, writer);
+	TypeReader<RPG::Database>::WriteXml(db, writer);
 	writer.EndElement("LDB");
 	return true;
 }
 
 bool LDB_Reader::LoadXml(const std::string& filename) {
+	return LoadXml(filename, Data::data);
+}
+
+bool LDB_Reader::LoadXml(const std::string& filename, RPG::Database& db) {
 	XmlReader reader(filename);
 	if (!reader.IsOk()) {
 		LcfReader::SetError("Couldn't open %s database file.\n", filename.c_str());
 		return false;
 	}
-	reader.SetHandler(new RootXmlHandler<RPG::Database>(Data::data, "LDB"));
+	reader.SetHandler(reader.MakeHandler<RootXmlHandler<RPG::Database> >(db, "LDB"));
 	reader.Parse();
 	return true;
 }
@@ -39,24 +39,44 @@
 namespace LDB_Reader {
 
 	/**
-	 * Loads Database.
+	 * Loads Database into Data::data.
 	 */
 	bool Load(const std::string& filename, const std::string& encoding);
 
 	/**
-	 * Saves Database.
+	 * Loads Database into db, for example the one of a Data::Context.
+	 */
+	bool Load(const std::string& filename, const std::string& encoding, RPG::Database& db);
+
+	/**
+	 * Saves Database from Data::data.
 	 */
 	bool Save(const std::string& filename, const std::string& encoding);
 
 	/**
-	 * Saves Database as XML.
+	 * Saves Database from db.
+	 */
+	bool Save(const std::string& filename, const RPG::Database& db, const std::string& encoding);
+
+	/**
+	 * Saves Database from Data::data as XML.
 	 */
 	bool SaveXml(const std::string& filename);
 
 	/**
-	 * Load Database as XML.
+	 * Saves Database from db as XML.
+	 */
+	bool SaveXml(const std::string& filename, const RPG::Database& db);
+
+	/**
+	 * Load Database as XML into Data::data.
 	 */
 	bool LoadXml(const std::string& filename);
+
+	/**
+	 * Load Database as XML into db.
+	 */
+	bool LoadXml(const std::string& filename, RPG::Database& db);
 }
 
 #endif
@@ -11,6 +11,10 @@
 #include "reader_struct.h"
 
 bool LMT_Reader::Load(const std::string& filename, const std::string &encoding) {
+	return Load(filename, encoding, Data::treemap);
+}
+
+bool LMT_Reader::Load(const std::string& filename, const std::string &encoding, RPG::TreeMap& treemap) {
 	LcfReader reader(filename, encoding);
 	if (!reader.IsOk()) {
 		LcfReader::SetError("Couldn't find %s map tree file.\n", filename.c_str());
@@ -25,11 +29,15 @@ bool LMT_Reader::Load(const std::string& filename, const std::string &encoding)
 	if (header != "LcfMapTree") {
 		fprintf(stderr, "Warning: %s header is not LcfMapTree and might not be a valid RPG2000 map tree.\n", filename.c_str());
 	}
-	TypeReader<RPG::TreeMap>::ReadLcf(Data::treemap, reader, 0);
+	TypeReader<RPG::TreeMap>::ReadLcf(treemap, reader, 0);
 	return true;
 }
 
 bool LMT_Reader::Save(const std::string& filename, const std::string &encoding) {
+	return Save(filename, Data::treemap, encoding);
+}
+
+bool LMT_Reader::Save(const std::string& filename, const RPG::TreeMap& treemap, const std::string &encoding) {
 	LcfWriter writer(filename, encoding);
 	if (!writer.IsOk()) {
 		LcfReader::SetError("Couldn't find %s map tree file.\n", filename.c_str());
@@ -38,29 +46,37 @@ bool LMT_Reader::Save(const std::string& filename, const std::string &encoding)
 	const std::string header("LcfMapTree");
 	writer.WriteInt(header.size());
 	writer.Write(header);
-	TypeReader<RPG::TreeMap>::WriteLcf(Data::treemap, writer);
+	TypeReader<RPG::TreeMap>::WriteLcf(treemap, writer);
 	return true;
 }
 
 bool LMT_Reader::SaveXml(const std::string& filename) {
+	return SaveXml(filename, Data::treemap);
+}
+
+bool LMT_Reader::SaveXml(const std::string& filename, const RPG::TreeMap& treemap) {
 	XmlWriter writer(filename);
 	if (!writer.IsOk()) {
 		LcfReader::SetError("Couldn't find %s map tree file.\n", filename.c_str());
 		return false;
 	}
 	writer.BeginElement("LMT");
-	TypeReader<RPG::TreeMap>::WriteXml(Data::treemap, writer);
+	TypeReader<RPG::TreeMap>::WriteXml(treemap, writer);
 	writer.EndElement("LMT");
 	return true;
 }
 
 bool LMT_Reader::LoadXml(const std::string& filename) {
+	return LoadXml(filename, Data::treemap);
+}
+
+bool LMT_Reader::LoadXml(const std::string& filename, RPG::TreeMap& treemap) {
 	XmlReader reader(filename);
 	if (!reader.IsOk()) {
 		LcfReader::SetError("Couldn't open %s map tree file.\n", filename.c_str());
 		return false;
 	}
-	reader.SetHandler(new RootXmlHandler<RPG::TreeMap>(Data::treemap, "LMT"));
+	reader.SetHandler(reader.MakeHandler<RootXmlHandler<RPG::TreeMap> >(treemap, "LMT"));
 	reader.Parse();
 	return true;
 }
@@ -19,24 +19,44 @@
 namespace LMT_Reader {
 
 	/**
-	 * Loads Map Tree.
+	 * Loads Map Tree into Data::treemap.
 	 */
 	bool Load(const std::string& filename, const std::string &encoding);
 
 	/**
-	 * Saves Map Tree.
+	 * Loads Map Tree into treemap, for example the one of a Data::Context.
+	 */
+	bool Load(const std::string& filename, const std::string &encoding, RPG::TreeMap& treemap);
+
+	/**
+	 * Saves Map Tree from Data::treemap.
 	 */
 	bool Save(const std::string& filename, const std::string &encoding);
 
 	/**
-	 * Saves Map Tree as XML.
+	 * Saves Map Tree from treemap.
+	 */
+	bool Save(const std::string& filename, const RPG::TreeMap& treemap, const std::string &encoding);
+
+	/**
+	 * Saves Map Tree from Data::treemap as XML.
 	 */
 	bool SaveXml(const std::string& filename);
 
 	/**
-	 * Loads Map Tree as XML.
+	 * Saves Map Tree from treemap as XML.
+	 */
+	bool SaveXml(const std::string& filename, const RPG::TreeMap& treemap);
+
+	/**
+	 * Loads Map Tree as XML into Data::treemap.
 	 */
 	bool LoadXml(const std::string& filename);
+
+	/**
+	 * Loads Map Tree as XML into treemap.
+	 */
+	bool LoadXml(const std::string& filename, RPG::TreeMap& treemap);
 }
 
 #endif
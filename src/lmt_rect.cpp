@@ -15,6 +15,7 @@ struct RawStruct<RPG::Rect> {
 	static int LcfSize(const RPG::Rect& ref, LcfWriter& stream);
 	static void WriteXml(const RPG::Rect& ref, XmlWriter& stream);
 	static void BeginXml(RPG::Rect& ref, XmlReader& stream);
+	static void HeapSize(const RPG::Rect& ref, HeapUsage& usage);
 };
 
 /**
@@ -78,5 +79,8 @@ public:
 };
 
 void RawStruct<RPG::Rect>::BeginXml(RPG::Rect& ref, XmlReader& stream) {
-	stream.SetHandler(new WrapperXmlHandler("Rect", new RectXmlHandler(ref)));
+	stream.SetHandler(stream.MakeHandler<WrapperXmlHandler>("Rect", stream.MakeHandler<RectXmlHandler>(ref)));
+}
+
+void RawStruct<RPG::Rect>::HeapSize(const RPG::Rect& /* ref */, HeapUsage& /* usage */) {
 }
@@ -6,6 +6,7 @@
 
 #include "lmt_reader.h"
 #include "lmt_chunks.h"
+#include "reader_stats.h"
 #include "reader_struct.h"
 
 template <>
@@ -15,20 +16,33 @@ struct RawStruct<RPG::TreeMap> {
 	static int LcfSize(const RPG::TreeMap& ref, LcfWriter& stream);
 	static void WriteXml(const RPG::TreeMap& ref, XmlWriter& stream);
 	static void BeginXml(RPG::TreeMap& ref, XmlReader& stream);
+	static void HeapSize(const RPG::TreeMap& ref, HeapUsage& usage);
 };
 
 /**
  * Reads Map Tree.
  */
 void RawStruct<RPG::TreeMap>::ReadLcf(RPG::TreeMap& ref, LcfReader& stream, uint32_t /* length */) {
+#ifdef LCF_INSTRUMENT
+	ReaderStats::Scope stats("TreeMap", ReaderStats::Read);
+	uint32_t startpos = stream.Tell();
+#endif
 	Struct<RPG::MapInfo>::ReadLcf(ref.maps, stream);
 	for (int i = stream.ReadInt(); i > 0; i--)
 		ref.tree_order.push_back(stream.ReadInt());
 	ref.active_node = stream.ReadInt();
 	Struct<RPG::Start>::ReadLcf(ref.start, stream);
+
+#ifdef LCF_INSTRUMENT
+	stats.SetBytes(stream.Tell() - startpos);
+#endif
 }
 
 void RawStruct<RPG::TreeMap>::WriteLcf(const RPG::TreeMap& ref, LcfWriter& stream) {
+#ifdef LCF_INSTRUMENT
+	ReaderStats::Scope stats("TreeMap", ReaderStats::Write);
+	uint32_t startpos = stream.Tell();
+#endif
 	Struct<RPG::MapInfo>::WriteLcf(ref.maps, stream);
 	int count = ref.tree_order.size();
 	stream.WriteInt(count);
@@ -36,6 +50,10 @@ void RawStruct<RPG::TreeMap>::WriteLcf(const RPG::TreeMap& ref, LcfWriter& strea
 		stream.WriteInt(ref.tree_order[i]);
 	stream.WriteInt(ref.active_node);
 	Struct<RPG::Start>::WriteLcf(ref.start, stream);
+
+#ifdef LCF_INSTRUMENT
+	stats.SetBytes(stream.Tell() - startpos);
+#endif
 }
 
 int RawStruct<RPG::TreeMap>::LcfSize(const RPG::TreeMap& /* ref */, LcfWriter& /* stream */) {
@@ -100,5 +118,13 @@ public:
 };
 
 void RawStruct<RPG::TreeMap>::BeginXml(RPG::TreeMap& ref, XmlReader& stream) {
-	stream.SetHandler(new WrapperXmlHandler("TreeMap", new TreeMapXmlHandler(ref)));
+	stream.SetHandler(stream.MakeHandler<WrapperXmlHandler>("TreeMap", stream.MakeHandler<TreeMapXmlHandler>(ref)));
+}
+
+void RawStruct<RPG::TreeMap>::HeapSize(const RPG::TreeMap& ref, HeapUsage& usage) {
+	HeapUsage::Entry* owner = usage.BeginObject("TreeMap");
+	Struct<RPG::MapInfo>::HeapSize(ref.maps, usage);
+	usage.Add(ref.tree_order);
+	Struct<RPG::Start>::HeapSize(ref.start, usage);
+	usage.EndObject(owner);
 }
@@ -4,7 +4,9 @@
  * http://opensource.org/licenses/MIT
  */
 
+#include "compiled_move_route.h"
 #include "rpg_movecommand.h"
+#include "reader_stats.h"
 #include "reader_struct.h"
 
 template <>
@@ -14,6 +16,7 @@ struct RawStruct<RPG::MoveCommand> {
 	static int LcfSize(const RPG::MoveCommand& ref, LcfWriter& stream);
 	static void WriteXml(const RPG::MoveCommand& ref, XmlWriter& stream);
 	static void BeginXml(RPG::MoveCommand& ref, XmlReader& stream);
+	static void HeapSize(const RPG::MoveCommand& ref, HeapUsage& usage);
 };
 
 template <>
@@ -23,6 +26,7 @@ struct RawStruct<std::vector<RPG::MoveCommand> > {
 	static int LcfSize(const std::vector<RPG::MoveCommand>& ref, LcfWriter& stream);
 	static void WriteXml(const std::vector<RPG::MoveCommand>& ref, XmlWriter& stream);
 	static void BeginXml(std::vector<RPG::MoveCommand>& ref, XmlReader& stream);
+	static void HeapSize(const std::vector<RPG::MoveCommand>& ref, HeapUsage& usage);
 };
 
 /**
@@ -61,12 +65,12 @@ void RawStruct<RPG::MoveCommand>::WriteLcf(const RPG::MoveCommand& ref, LcfWrite
 			break;
 		case RPG::MoveCommand::Code::change_graphic:
 			stream.WriteInt(stream.Decode(ref.parameter_string).size());
-			stream.Write(ref.parameter_string);
+			stream.Write(ref.parameter_string.str());
 			stream.Write(ref.parameter_a);
 			break;
 		case RPG::MoveCommand::Code::play_sound_effect:
 			stream.WriteInt(stream.Decode(ref.parameter_string).size());
-			stream.Write(ref.parameter_string);
+			stream.Write(ref.parameter_string.str());
 			stream.Write(ref.parameter_a);
 			stream.Write(ref.parameter_b);
 			stream.Write(ref.parameter_c);
@@ -157,31 +161,67 @@ public:
 		if (field != NULL)
 			XmlReader::Read<int>(*field, data);
 		else if (parameter_string)
-			XmlReader::Read<std::string>(ref.parameter_string, data);
+			Primitive<SharedString>::ParseXml(ref.parameter_string, data);
 	}
 };
 
 void RawStruct<RPG::MoveCommand>::BeginXml(RPG::MoveCommand& ref, XmlReader& stream) {
-	stream.SetHandler(new WrapperXmlHandler("MoveCommand", new MoveCommandXmlHandler(ref)));
+	stream.SetHandler(stream.MakeHandler<WrapperXmlHandler>("MoveCommand", stream.MakeHandler<MoveCommandXmlHandler>(ref)));
 }
 
 /**
  * Reads Move Commands.
  */
 void RawStruct<std::vector<RPG::MoveCommand> >::ReadLcf(std::vector<RPG::MoveCommand>& ref, LcfReader& stream, uint32_t length) {
+#ifdef LCF_INSTRUMENT
+	ReaderStats::Scope stats("MoveCommands", ReaderStats::Read);
+	stats.SetBytes(length);
+#endif
 	unsigned long startpos = stream.Tell();
 	unsigned long endpos = startpos + length;
+	// Commands already in the vector are reused with their storage
+	size_t used = 0;
 	do {
-		RPG::MoveCommand command;
+		if (used == ref.size())
+			ref.emplace_back();
+		RPG::MoveCommand& command = ref[used++];
+		command.parameter_string.clear();
+		command.parameter_a = 0;
+		command.parameter_b = 0;
+		command.parameter_c = 0;
 		RawStruct<RPG::MoveCommand>::ReadLcf(command, stream, 0);
-		ref.push_back(command);
 	} while (stream.Tell() != endpos);
+	ref.resize(used);
+}
+
+void CompiledMoveRoute::ReadLcf(LcfReader& stream, uint32_t length, MoveRouteStrings& strings) {
+#ifdef LCF_INSTRUMENT
+	ReaderStats::Scope stats("MoveCommands", ReaderStats::Read);
+	stats.SetBytes(length);
+#endif
+	Clear();
+	// Most commands are a single byte
+	code.reserve(length);
+	unsigned long endpos = stream.Tell() + length;
+	RPG::MoveCommand command;
+	while (stream.Tell() < endpos && !stream.Eof()) {
+		RawStruct<RPG::MoveCommand>::ReadLcf(command, stream, 0);
+		Add(command, strings);
+	}
 }
 
 void RawStruct<std::vector<RPG::MoveCommand> >::WriteLcf(const std::vector<RPG::MoveCommand>& ref, LcfWriter& stream) {
+#ifdef LCF_INSTRUMENT
+	ReaderStats::Scope stats("MoveCommands", ReaderStats::Write);
+	uint32_t startpos = stream.Tell();
+#endif
 	std::vector<RPG::MoveCommand>::const_iterator it;
 	for (it = ref.begin(); it != ref.end(); it++)
 		RawStruct<RPG::MoveCommand>::WriteLcf(*it, stream);
+
+#ifdef LCF_INSTRUMENT
+	stats.SetBytes(stream.Tell() - startpos);
+#endif
 }
 
 int RawStruct<std::vector<RPG::MoveCommand> >::LcfSize(const std::vector<RPG::MoveCommand>& ref, LcfWriter& stream) {
@@ -207,12 +247,24 @@ public:
 			stream.Error("Expecting %s but got %s", "MoveCommand", name);
 		ref.resize(ref.size() + 1);
 		RPG::MoveCommand& obj = ref.back();
-		stream.SetHandler(new MoveCommandXmlHandler(obj));
+		stream.SetHandler(stream.MakeHandler<MoveCommandXmlHandler>(obj));
 	}
 private:
 	std::vector<RPG::MoveCommand>& ref;
 };
 
 void RawStruct<std::vector<RPG::MoveCommand> >::BeginXml(std::vector<RPG::MoveCommand>& obj, XmlReader& stream) {
-	stream.SetHandler(new MoveCommandVectorXmlHandler(obj));
+	stream.SetHandler(stream.MakeHandler<MoveCommandVectorXmlHandler>(obj));
+}
+
+void RawStruct<RPG::MoveCommand>::HeapSize(const RPG::MoveCommand& ref, HeapUsage& usage) {
+	HeapUsage::Entry* owner = usage.BeginObject("MoveCommand");
+	usage.Add(ref.parameter_string);
+	usage.EndObject(owner);
+}
+
+void RawStruct<std::vector<RPG::MoveCommand> >::HeapSize(const std::vector<RPG::MoveCommand>& ref, HeapUsage& usage) {
+	usage.AddElements("MoveCommand", ref);
+	for (size_t i = 0; i < ref.size(); i++)
+		RawStruct<RPG::MoveCommand>::HeapSize(ref[i], usage);
 }
@@ -7,28 +7,38 @@
 #include "lmu_reader.h"
 #include "lmu_chunks.h"
 #include "reader_lcf.h"
+#include "reader_mmap.h"
 #include "reader_util.h"
 #include "reader_struct.h"
 
 std::unique_ptr<RPG::Map> LMU_Reader::Load(const std::string& filename, const std::string& encoding) {
-	LcfReader reader(filename, encoding);
-	if (!reader.IsOk()) {
-		LcfReader::SetError("Couldn't find %s map file.\n", filename.c_str());
+	std::unique_ptr<RPG::Map> map(new RPG::Map());
+	if (!LoadInto(filename, encoding, *map))
 		return std::unique_ptr<RPG::Map>();
+	return map;
+}
+
+bool LMU_Reader::LoadInto(const std::string& filename, const std::string& encoding, RPG::Map& map) {
+	// The whole file is read at once and decoded from memory, which also
+	// lets list readers count their elements before reading them.
+	MappedFile file;
+	if (!file.Open(filename)) {
+		LcfReader::SetError("Couldn't find %s map file.\n", filename.c_str());
+		return false;
 	}
+	LcfReader reader(file.Data(), file.Size(), encoding);
 	std::string header;
 	reader.ReadString(header, reader.ReadInt());
 	if (header.length() != 10) {
 		LcfReader::SetError("%s is not a valid RPG2000 map.\n", filename.c_str());
-		return std::unique_ptr<RPG::Map>();
+		return false;
 	}
 	if (header != "LcfMapUnit") {
 		fprintf(stderr, "Warning: %s header is not LcfMapUnit and might not be a valid RPG2000 map.\n", filename.c_str());
 	}
 
-	RPG::Map* map = new RPG::Map();
-	Struct<RPG::Map>::ReadLcf(*map, reader);
-	return std::unique_ptr<RPG::Map>(map);
+	Struct<RPG::Map>::ReadLcf(map, reader);
+	return true;
 }
 
 bool LMU_Reader::Save(const std::string& filename, const RPG::Map& map, const std::string& encoding) {
@@ -65,7 +75,7 @@ std::unique_ptr<RPG::Map> LMU_Reader::LoadXml(const std::string& filename) {
 	}
 
 	RPG::Map* map = new RPG::Map();
-	reader.SetHandler(new RootXmlHandler<RPG::Map>(*map, "LMU"));
+	reader.SetHandler(reader.MakeHandler<RootXmlHandler<RPG::Map> >(*map, "LMU"));
 	reader.Parse();
 	return std::unique_ptr<RPG::Map>(map);
 }
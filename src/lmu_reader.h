@@ -21,6 +21,16 @@ namespace LMU_Reader {
 	 */
 	std::unique_ptr<RPG::Map> Load(const std::string& filename, const std::string& encoding);
 
+	/**
+	 * Loads map into an existing one, replacing its contents. The
+	 * storage of its layers, events, pages, commands and strings is
+	 * reused, so loading maps of similar size one after another hardly
+	 * allocates.
+	 *
+	 * @return true on success. On failure the map may be partly read.
+	 */
+	bool LoadInto(const std::string& filename, const std::string& encoding, RPG::Map& map);
+
 	/**
 	 * Saves map.
 	 */
@@ -83,7 +83,7 @@ std::unique_ptr<RPG::Save> LSD_Reader::LoadXml(const std::string& filename) {
 	}
 
 	RPG::Save* save = new RPG::Save();
-	reader.SetHandler(new RootXmlHandler<RPG::Save>(*save, "LSD"));
+	reader.SetHandler(reader.MakeHandler<RootXmlHandler<RPG::Save> >(*save, "LSD"));
 	reader.Parse();
 	return std::unique_ptr<RPG::Save>(save);
 }
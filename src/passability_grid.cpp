@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include "passability_grid.h"
+
+namespace {
+	// First tile IDs of the chipset blocks
+	const int block_c = 3000;
+	const int block_d = 4000;
+	const int block_e = 5000;
+	const int block_f = 10000;
+
+	/** Entries of the upper table of a chipset, the lower has 18 more. */
+	const int upper_count = 144;
+	/** One more than the highest lower layer tile ID. */
+	const int lower_end = block_e + upper_count;
+
+	/** Chipset::Init defaults for tables shorter than usual. */
+	const uint8_t default_passable = 0x0F;
+	const int16_t default_terrain = 1;
+}
+
+int PassabilityGrid::GetLowerIndex(int tile_id) {
+	if (tile_id < 0)
+		return -1;
+	// Water A, B and deep water
+	if (tile_id < block_c)
+		return tile_id / 1000;
+	// Animated tiles
+	if (tile_id < block_d)
+		return (tile_id - block_c) / 50 + 3;
+	// Autotiles
+	if (tile_id < block_e)
+		return (tile_id - block_d) / 50 + 6;
+	// Plain tiles
+	if (tile_id < lower_end)
+		return tile_id - block_e + 18;
+	return -1;
+}
+
+int PassabilityGrid::GetUpperIndex(int tile_id) {
+	if (tile_id < block_f || tile_id >= block_f + upper_count)
+		return -1;
+	return tile_id - block_f;
+}
+
+PassabilityGrid::PassabilityGrid() : map(NULL), width(0), height(0) {
+}
+
+PassabilityGrid::PassabilityGrid(RPG::Map& map, const RPG::Chipset& chipset) : map(NULL), width(0), height(0) {
+	Build(map, chipset);
+}
+
+void PassabilityGrid::Build(RPG::Map& map, const RPG::Chipset& chipset) {
+	this->map = &map;
+	width = std::max(map.width, 0);
+	height = std::max(map.height, 0);
+
+	// Tables per tile ID, so the tile loop below is two lookups
+	lower_flags.resize(lower_end);
+	lower_terrain.resize(lower_end);
+	for (int tile_id = 0; tile_id < lower_end; tile_id++) {
+		int index = GetLowerIndex(tile_id);
+		lower_flags[tile_id] = index < (int) chipset.passable_data_lower.size() ?
+			chipset.passable_data_lower[index] : default_passable;
+		lower_terrain[tile_id] = index < (int) chipset.terrain_data.size() ?
+			chipset.terrain_data[index] : default_terrain;
+	}
+	upper_flags.resize(upper_count);
+	for (int index = 0; index < upper_count; index++) {
+		upper_flags[index] = index < (int) chipset.passable_data_upper.size() ?
+			chipset.passable_data_upper[index] : default_passable;
+	}
+
+	const int count = width * height;
+	passable.assign((count + 1) / 2, 0);
+	terrain.assign(count, 0);
+	for (int i = 0; i < count; i++)
+		Update(i);
+}
+
+void PassabilityGrid::Update(int index) {
+	int lower_id = index < (int) map->lower_layer.size() ? map->lower_layer[index] : -1;
+	int upper_id = index < (int) map->upper_layer.size() ? map->upper_layer[index] : -1;
+	int upper = GetUpperIndex(upper_id);
+
+	int flags;
+	if (upper > 0 && (upper_flags[upper] & Passable_above) == 0) {
+		flags = upper_flags[upper] & Passable_all;
+	} else if (lower_id >= 0 && lower_id < lower_end) {
+		flags = lower_flags[lower_id];
+		flags = (flags & Passable_above) ? Passable_all : flags & Passable_all;
+	} else {
+		flags = 0;
+	}
+
+	int shift = (index & 1) * 4;
+	uint8_t& packed = passable[index / 2];
+	packed = (uint8_t) ((packed & ~(0x0F << shift)) | (flags << shift));
+	terrain[index] = lower_id >= 0 && lower_id < lower_end ? lower_terrain[lower_id] : 0;
+}
+
+int PassabilityGrid::GetWidth() const {
+	return width;
+}
+
+int PassabilityGrid::GetHeight() const {
+	return height;
+}
+
+int PassabilityGrid::GetPassable(int x, int y) const {
+	if (x < 0 || y < 0 || x >= width || y >= height)
+		return 0;
+	int index = y * width + x;
+	return (passable[index / 2] >> ((index & 1) * 4)) & Passable_all;
+}
+
+bool PassabilityGrid::IsPassable(int x, int y, int direction) const {
+	return (GetPassable(x, y) & direction) != 0;
+}
+
+int PassabilityGrid::GetTerrain(int x, int y) const {
+	if (x < 0 || y < 0 || x >= width || y >= height)
+		return 0;
+	return terrain[y * width + x];
+}
+
+const std::vector<uint8_t>& PassabilityGrid::GetPassableData() const {
+	return passable;
+}
+
+const std::vector<int16_t>& PassabilityGrid::GetTerrainData() const {
+	return terrain;
+}
+
+bool PassabilityGrid::SetLowerTile(int x, int y, int16_t tile_id) {
+	if (x < 0 || y < 0 || x >= width || y >= height)
+		return false;
+	int index = y * width + x;
+	if (index >= (int) map->lower_layer.size())
+		return false;
+	map->lower_layer[index] = tile_id;
+	Update(index);
+	return true;
+}
+
+bool PassabilityGrid::SetUpperTile(int x, int y, int16_t tile_id) {
+	if (x < 0 || y < 0 || x >= width || y >= height)
+		return false;
+	int index = y * width + x;
+	if (index >= (int) map->upper_layer.size())
+		return false;
+	map->upper_layer[index] = tile_id;
+	Update(index);
+	return true;
+}
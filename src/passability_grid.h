@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#ifndef LCF_PASSABILITY_GRID_H
+#define LCF_PASSABILITY_GRID_H
+
+#include <vector>
+#include "reader_types.h"
+#include "rpg_chipset.h"
+#include "rpg_map.h"
+
+/**
+ * Passability and terrain of every tile of a map.
+ *
+ * Combines the tile IDs of the map layers with the passability and
+ * terrain tables of its chipset once, so lookups are a shift and a mask.
+ * An upper layer tile decides the passability unless it is the empty
+ * tile or drawn above the hero, then the lower layer tile decides. Lower
+ * tiles drawn above the hero are passable in all directions. Events and
+ * tile substitutions at runtime are not considered.
+ *
+ * The grid refers to the map it was built from. It must be rebuilt when
+ * the layers or the chipset change directly; SetLowerTile and
+ * SetUpperTile change map and grid together.
+ */
+class PassabilityGrid {
+public:
+	/**
+	 * Passability bits of the chipset tables.
+	 */
+	enum Passable {
+		Passable_down = 0x01,
+		Passable_left = 0x02,
+		Passable_right = 0x04,
+		Passable_up = 0x08,
+		Passable_above = 0x10,
+		Passable_all = 0x0F
+	};
+
+	PassabilityGrid();
+	PassabilityGrid(RPG::Map& map, const RPG::Chipset& chipset);
+
+	/**
+	 * Computes the grids of a map.
+	 */
+	void Build(RPG::Map& map, const RPG::Chipset& chipset);
+
+	int GetWidth() const;
+	int GetHeight() const;
+
+	/**
+	 * Returns the passable directions of a tile, a combination of
+	 * Passable_down, _left, _right and _up. 0 outside of the map.
+	 */
+	int GetPassable(int x, int y) const;
+
+	/**
+	 * Checks if a tile can be left or entered in a direction.
+	 *
+	 * @param direction one of Passable_down, _left, _right or _up.
+	 */
+	bool IsPassable(int x, int y, int direction) const;
+
+	/**
+	 * Returns the terrain ID of a tile, 0 outside of the map.
+	 */
+	int GetTerrain(int x, int y) const;
+
+	/**
+	 * Returns the packed passability: four bits per tile, two tiles per
+	 * byte, row by row. Even tile indices use the low four bits.
+	 */
+	const std::vector<uint8_t>& GetPassableData() const;
+
+	/**
+	 * Returns the terrain IDs, row by row.
+	 */
+	const std::vector<int16_t>& GetTerrainData() const;
+
+	/**
+	 * Changes a tile of the lower or upper layer of the map and updates
+	 * the grids.
+	 *
+	 * @return false if the position is outside of the map or the layer.
+	 */
+	bool SetLowerTile(int x, int y, int16_t tile_id);
+	bool SetUpperTile(int x, int y, int16_t tile_id);
+
+	/**
+	 * Returns the position of a lower layer tile ID in the lower
+	 * passability and terrain tables of a chipset, -1 if invalid.
+	 */
+	static int GetLowerIndex(int tile_id);
+
+	/**
+	 * Returns the position of an upper layer tile ID in the upper
+	 * passability table of a chipset, -1 if invalid.
+	 */
+	static int GetUpperIndex(int tile_id);
+
+private:
+	void Update(int index);
+
+	RPG::Map* map;
+	int width;
+	int height;
+	/** Lower layer flags and terrain per lower tile ID. */
+	std::vector<uint8_t> lower_flags;
+	std::vector<int16_t> lower_terrain;
+	/** Upper layer flags per upper tile index. */
+	std::vector<uint8_t> upper_flags;
+	std::vector<uint8_t> passable;
+	std::vector<int16_t> terrain;
+};
+
+#endif
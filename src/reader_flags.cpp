@@ -13,10 +13,12 @@
 
 template <class S>
 void Flags<S>::MakeTagMap() {
-	if (!tag_map.empty())
-		return;
-	for (int i = 0; flags[i] != NULL; i++)
-		tag_map[flags[i]->name] = flags[i];
+	// Thread-safe, see Struct<S>::MakeTagMap
+	static const bool built = []() {
+		tag_map.Build(flags);
+		return true;
+	}();
+	(void) built;
 }
 
 template <class S>
@@ -85,7 +87,7 @@ public:
 	}
 
 	void StartElement(XmlReader& stream, const char* name, const char** /* atts */) {
-		const typename Flags<S>::Flag* flag = Flags<S>::tag_map[name];
+		const typename Flags<S>::Flag* flag = Flags<S>::tag_map.Find(name);
 		if (flag != NULL) {
 			bool S::*ref = flag->ref;
 			field = &(obj.*ref);
@@ -106,7 +108,7 @@ public:
 
 template <class S>
 void Flags<S>::BeginXml(S& obj, XmlReader& stream) {
-	stream.SetHandler(new WrapperXmlHandler(name, new FlagsXmlHandler<S>(obj)));
+	stream.SetHandler(stream.MakeHandler<WrapperXmlHandler>(name, stream.MakeHandler<FlagsXmlHandler<S> >(obj)));
 }
 
 // Instantiate templates
@@ -4,6 +4,7 @@
  * http://opensource.org/licenses/MIT
  */
 
+#include <algorithm>
 #include <cstdarg>
 #include "reader_lcf.h"
 
@@ -13,19 +14,41 @@
 
 // Statics
 
-std::string LcfReader::error_str;
+thread_local std::string LcfReader::error_str;
+thread_local StringPool* LcfReader::string_pool = NULL;
 
 LcfReader::LcfReader(const char* filename, std::string encoding) :
 	filename(filename),
 	encoding(encoding),
-	stream(fopen(filename, "rb"))
+	stream(fopen(filename, "rb")),
+	memory(false),
+	data(NULL),
+	size(0),
+	pos(0),
+	eof(false)
 {
 }
 
 LcfReader::LcfReader(const std::string& filename, std::string encoding) :
 	filename(filename),
 	encoding(encoding),
-	stream(fopen(filename.c_str(), "rb"))
+	stream(fopen(filename.c_str(), "rb")),
+	memory(false),
+	data(NULL),
+	size(0),
+	pos(0),
+	eof(false)
+{
+}
+
+LcfReader::LcfReader(const char* data, size_t size, std::string encoding) :
+	encoding(encoding),
+	stream(NULL),
+	memory(true),
+	data(data),
+	size(size),
+	pos(0),
+	eof(false)
 {
 }
 
@@ -40,6 +63,19 @@ void LcfReader::Close() {
 }
 
 size_t LcfReader::Read0(void *ptr, size_t size, size_t nmemb) {
+	if (memory) {
+		// Same semantics as fread: partial elements are consumed
+		size_t bytes = size * nmemb;
+		size_t avail = pos < this->size ? this->size - pos : 0;
+		if (bytes > avail) {
+			bytes = avail;
+			eof = true;
+		}
+		memcpy(ptr, data + pos, bytes);
+		pos += bytes;
+		return size == 0 ? 0 : bytes / size;
+	}
+
 	size_t result = fread(ptr, size, nmemb, stream);
 #ifdef NDEBUG
 	if (result != nmemb && !Eof()) {
@@ -108,6 +144,7 @@ void LcfReader::Read<double>(double& ref) {
 template <>
 void LcfReader::Read<bool>(std::vector<bool> &buffer, size_t size) {
 	buffer.clear();
+	buffer.reserve(size);
 
 	for (unsigned i = 0; i < size; ++i) {
 		uint8_t val;
@@ -119,6 +156,7 @@ void LcfReader::Read<bool>(std::vector<bool> &buffer, size_t size) {
 template <>
 void LcfReader::Read<uint8_t>(std::vector<uint8_t> &buffer, size_t size) {
 	buffer.clear();
+	buffer.reserve(size);
 
 	for (unsigned int i = 0; i < size; ++i) {
 		uint8_t val;
@@ -131,6 +169,7 @@ template <>
 void LcfReader::Read<int16_t>(std::vector<int16_t> &buffer, size_t size) {
 	buffer.clear();
 	size_t items = size / 2;
+	buffer.reserve(items + size % 2);
 	for (unsigned int i = 0; i < items; ++i) {
 		int16_t val;
 		Read(&val, 2, 1);
@@ -147,6 +186,7 @@ template <>
 void LcfReader::Read<uint32_t>(std::vector<uint32_t> &buffer, size_t size) {
 	buffer.clear();
 	size_t items = size / 4;
+	buffer.reserve(items + (size % 4 != 0));
 	for (unsigned int i = 0; i < items; ++i) {
 		uint32_t val;
 		Read(&val, 4, 1);
@@ -159,23 +199,71 @@ void LcfReader::Read<uint32_t>(std::vector<uint32_t> &buffer, size_t size) {
 	}
 }
 
+void LcfReader::ReadRawString(std::string& str, size_t size) {
+	if (str.capacity() < size) {
+		// Growing with resize may round up the capacity
+		str = std::string(size, '\0');
+	} else {
+		str.resize(size);
+	}
+	if (size > 0)
+		Read(&str[0], 1, size);
+	// The string ends at the first null byte
+	size_t end = str.find('\0');
+	if (end != std::string::npos)
+		str.resize(end);
+}
+
 void LcfReader::ReadString(std::string& ref, size_t size) {
-	char* chars = new char[size + 1];
-	chars[size] = '\0';
-	Read(chars, 1, size);
-	ref = Encode(std::string(chars));
-	delete[] chars;
+	// Read in place, converted only when there is an encoding
+	ReadRawString(ref, size);
+	if (!encoding.empty() && !ref.empty())
+		ref = Encode(ref);
+}
+
+void LcfReader::ReadString(SharedString& ref, size_t size) {
+	ReadRawString(string_buffer, size);
+	if (string_buffer.empty())
+		ref.clear();
+	else if (string_pool != NULL)
+		ref = string_pool->Intern(string_buffer, encoding);
+	else if (!encoding.empty())
+		ref = Encode(string_buffer);
+	else
+		ref = string_buffer;
 }
 
 bool LcfReader::IsOk() const {
+	if (memory)
+		return true;
 	return (stream != NULL && !ferror(stream));
 }
 
 bool LcfReader::Eof() const {
+	if (memory)
+		return eof;
 	return feof(stream) != 0;
 }
 
 void LcfReader::Seek(size_t pos, SeekMode mode) {
+	if (memory) {
+		switch (mode) {
+		case LcfReader::FromStart:
+			this->pos = pos;
+			break;
+		case LcfReader::FromCurrent:
+			this->pos += pos;
+			break;
+		case LcfReader::FromEnd:
+			this->pos = size + pos;
+			break;
+		default:
+			assert(false && "Invalid SeekMode");
+		}
+		eof = false;
+		return;
+	}
+
 	switch (mode) {
 	case LcfReader::FromStart:
 		fseek(stream, pos, SEEK_SET);
@@ -192,10 +280,30 @@ void LcfReader::Seek(size_t pos, SeekMode mode) {
 }
 
 uint32_t LcfReader::Tell() {
+	if (memory)
+		return (uint32_t)pos;
 	return (uint32_t)ftell(stream);
 }
 
+const char* LcfReader::Peek(size_t& available) const {
+	if (!memory) {
+		available = 0;
+		return NULL;
+	}
+	size_t at = std::min(pos, size);
+	available = size - at;
+	return data + at;
+}
+
 bool LcfReader::Ungetch(uint8_t ch) {
+	if (memory) {
+		// Only the last read character can be put back
+		if (pos == 0 || pos > size || (uint8_t) data[pos - 1] != ch)
+			return false;
+		pos--;
+		eof = false;
+		return true;
+	}
 	return (ungetc(ch, stream) == ch);
 }
 
@@ -248,6 +356,14 @@ const std::string& LcfReader::GetError() {
 	return error_str;
 }
 
+void LcfReader::SetStringPool(StringPool* pool) {
+	string_pool = pool;
+}
+
+StringPool* LcfReader::GetStringPool() {
+	return string_pool;
+}
+
 std::string LcfReader::Encode(const std::string& str_to_encode) {
 	return ReaderUtil::Recode(str_to_encode, encoding, "UTF-8");
 }
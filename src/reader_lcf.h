@@ -16,6 +16,7 @@
 #include "reader_types.h"
 #include "reader_options.h"
 #include "reader_util.h"
+#include "string_pool.h"
 
 /*
  * Calls SkipDebug() instead of Skip() for debug builds.
@@ -45,6 +46,16 @@ public:
 	 */
 	LcfReader(const std::string& filename, std::string encoding = "");
 
+	/**
+	 * Constructs a new Reader over a memory buffer.
+	 * The buffer is not copied and must outlive the reader.
+	 *
+	 * @param data buffer to read from.
+	 * @param size size of the buffer in bytes.
+	 * @param encoding name of the encoding.
+	 */
+	LcfReader(const char* data, size_t size, std::string encoding = "");
+
 	/**
 	 * Destructor. Closes the opened file.
 	 */
@@ -71,6 +82,20 @@ public:
 	 */
 	static void SetError(const char* fmt, ...);
 
+	/**
+	 * Sets the pool that ReadString of readers on the calling thread
+	 * uses for SharedString fields, see string_pool.h. The pool must
+	 * outlive the reads.
+	 *
+	 * @param pool pool to use, NULL to convert every string on its own.
+	 */
+	static void SetStringPool(StringPool* pool);
+
+	/**
+	 * Returns the pool of the calling thread, NULL if none is set.
+	 */
+	static StringPool* GetStringPool();
+
 	/**
 	 * The chunk defines the basic layout of the binary blocks
 	 * used by the RPG Maker files.
@@ -145,6 +170,15 @@ public:
 	 */
 	void ReadString(std::string& ref, size_t size);
 
+	/**
+	 * Reads a file name string. With a string pool set, equal strings
+	 * share their buffer, see string_pool.h.
+	 *
+	 * @param size string length.
+	 * @param ref reference to store result, converted to UTF-8.
+	 */
+	void ReadString(SharedString& ref, size_t size);
+
 	/**
 	 * Checks if the file is readable and if no error occured.
 	 *
@@ -185,6 +219,15 @@ public:
 	 */
 	bool Ungetch(uint8_t ch);
 
+	/**
+	 * Returns the unread part of a memory buffer without consuming it.
+	 *
+	 * @param available receives the number of unread bytes.
+	 * @return the data at the read position or NULL when the reader
+	 *         reads from a file.
+	 */
+	const char* Peek(size_t& available) const;
+
 #ifdef _DEBUG
 	/**
 	 * The skip-function for debug builds.
@@ -231,8 +274,28 @@ private:
 	std::string encoding;
 	/** File-stream managed by this Reader. */
 	FILE* stream;
-	/** Contains the last set error. */
-	static std::string error_str;
+	/** Whether the reader reads from a memory buffer. */
+	bool memory;
+	/** Memory buffer. */
+	const char* data;
+	/** Size of the memory buffer. */
+	size_t size;
+	/** Read position in the memory buffer. */
+	size_t pos;
+	/** Whether a read hit the end of the memory buffer. */
+	bool eof;
+	/** Contains the last set error of the calling thread. */
+	static thread_local std::string error_str;
+	/** String pool of the calling thread. */
+	static thread_local StringPool* string_pool;
+	/** Bytes of the last file name string read. */
+	std::string string_buffer;
+
+	/**
+	 * Reads the bytes of a string up to the first null byte, reusing the
+	 * storage of str.
+	 */
+	void ReadRawString(std::string& str, size_t size);
 
 	/**
 	 * Converts a 16bit signed integer to/from little-endian.
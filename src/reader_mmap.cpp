@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#include <cstdio>
+#include "reader_mmap.h"
+
+#if !defined(_WIN32)
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+MappedFile::MappedFile() :
+	data(NULL),
+	size(0),
+	mapped(false),
+	open(false)
+{
+}
+
+MappedFile::~MappedFile() {
+	Close();
+}
+
+/**
+ * Reads a whole file into a buffer.
+ */
+static bool ReadFile(const std::string& filename, std::vector<char>& buffer) {
+	FILE* stream = fopen(filename.c_str(), "rb");
+	if (stream == NULL)
+		return false;
+
+	static const size_t bufsize = 64 * 1024;
+	size_t len = 0;
+	do {
+		buffer.resize(len + bufsize);
+		len += fread(&buffer[len], 1, bufsize, stream);
+	} while (len == buffer.size());
+	buffer.resize(len);
+
+	bool ok = !ferror(stream);
+	fclose(stream);
+	return ok;
+}
+
+bool MappedFile::Open(const std::string& filename) {
+	Close();
+
+#if !defined(_WIN32)
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+		size = (size_t) st.st_size;
+		if (size == 0) {
+			::close(fd);
+			open = true;
+			return true;
+		}
+		void* addr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (addr != MAP_FAILED) {
+			::close(fd);
+#if defined(MADV_SEQUENTIAL)
+			madvise(addr, size, MADV_SEQUENTIAL);
+#endif
+			data = (const char*) addr;
+			mapped = true;
+			open = true;
+			return true;
+		}
+		size = 0;
+	}
+	::close(fd);
+#endif
+
+	// Not mappable (pipes, special files, no mmap)
+	if (!ReadFile(filename, buffer)) {
+		std::vector<char>().swap(buffer);
+		return false;
+	}
+	data = buffer.empty() ? NULL : &buffer.front();
+	size = buffer.size();
+	open = true;
+	return true;
+}
+
+void MappedFile::Close() {
+#if !defined(_WIN32)
+	if (mapped)
+		munmap((void*) data, size);
+#endif
+	std::vector<char>().swap(buffer);
+	data = NULL;
+	size = 0;
+	mapped = false;
+	open = false;
+}
+
+bool MappedFile::IsOpen() const {
+	return open;
+}
+
+const char* MappedFile::Data() const {
+	return data;
+}
+
+size_t MappedFile::Size() const {
+	return size;
+}
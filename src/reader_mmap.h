@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#ifndef LCF_READER_MMAP_H
+#define LCF_READER_MMAP_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/**
+ * Read-only view of a whole file.
+ *
+ * Uses mmap where available and falls back to reading the file into
+ * memory otherwise.
+ */
+class MappedFile {
+
+public:
+	/**
+	 * Constructs an unopened file view.
+	 */
+	MappedFile();
+
+	/**
+	 * Destructor. Unmaps the file.
+	 */
+	~MappedFile();
+
+	/**
+	 * Maps a file, unmapping a previously opened one.
+	 *
+	 * @param filename file to map.
+	 * @return true on success.
+	 */
+	bool Open(const std::string& filename);
+
+	/**
+	 * Unmaps the file.
+	 */
+	void Close();
+
+	/**
+	 * Checks if a file is mapped.
+	 *
+	 * @return true if a file is mapped.
+	 */
+	bool IsOpen() const;
+
+	/**
+	 * Returns the file contents.
+	 *
+	 * @return pointer to the first byte, NULL for an empty file.
+	 */
+	const char* Data() const;
+
+	/**
+	 * Returns the file size.
+	 *
+	 * @return size in bytes.
+	 */
+	size_t Size() const;
+
+private:
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+	/** Start of the contents. */
+	const char* data;
+	/** Size of the contents. */
+	size_t size;
+	/** Whether data points into a mapping. */
+	bool mapped;
+	/** Whether a file is open. */
+	bool open;
+	/** File contents when mapping is not possible. */
+	std::vector<char> buffer;
+
+};
+
+#endif
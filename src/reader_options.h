@@ -20,4 +20,10 @@
  */
 //#define LCF_DEBUG_TRACE
 
+/**
+ * Measures time and bytes of reading and writing per struct, see
+ * reader_stats.h. Off by default as it slows down loading.
+ */
+//#define LCF_INSTRUMENT
+
 #endif
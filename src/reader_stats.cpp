@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <utility>
+#include "reader_stats.h"
+
+namespace {
+	typedef std::chrono::steady_clock Clock;
+
+	/**
+	 * Open scope. Struct names are static strings, so counters are
+	 * looked up by pointer.
+	 */
+	struct Frame {
+		size_t entry;
+		Clock::time_point start;
+		unsigned long long child_nanoseconds;
+		unsigned long long allocations;
+		unsigned long long allocated_bytes;
+	};
+
+	struct TraceEvent {
+		size_t entry;
+		unsigned long long start;
+		unsigned long long duration;
+		unsigned long long bytes;
+	};
+
+	std::vector<ReaderStats::Stats> entries;
+	std::map<std::pair<const char*, int>, size_t> entry_index;
+	std::vector<Frame> frames;
+	std::vector<TraceEvent> trace;
+	Clock::time_point epoch = Clock::now();
+	size_t trace_depth = 4;
+	ReaderStats::AllocationCounter allocation_counter = NULL;
+
+	/** Keeps the trace of a big game loadable in the trace viewers. */
+	const size_t trace_limit = 1000000;
+}
+
+static size_t GetEntry(const char* name, ReaderStats::Phase phase) {
+	std::pair<const char*, int> key(name, (int) phase);
+	std::map<std::pair<const char*, int>, size_t>::const_iterator it = entry_index.find(key);
+	if (it != entry_index.end())
+		return it->second;
+
+	ReaderStats::Stats stats;
+	stats.name = name;
+	stats.phase = phase;
+	stats.calls = 0;
+	stats.bytes = 0;
+	stats.nanoseconds = 0;
+	stats.self_nanoseconds = 0;
+	stats.strings = 0;
+	stats.chunks_skipped = 0;
+	stats.allocations = 0;
+	stats.allocated_bytes = 0;
+	entries.push_back(stats);
+	entry_index[key] = entries.size() - 1;
+	return entries.size() - 1;
+}
+
+static unsigned long long Nanoseconds(Clock::duration d) {
+	return (unsigned long long) std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+}
+
+bool ReaderStats::IsEnabled() {
+#ifdef LCF_INSTRUMENT
+	return true;
+#else
+	return false;
+#endif
+}
+
+void ReaderStats::Reset() {
+	entries.clear();
+	entry_index.clear();
+	trace.clear();
+	epoch = Clock::now();
+}
+
+static bool LongerFirst(const ReaderStats::Stats& a, const ReaderStats::Stats& b) {
+	return a.nanoseconds > b.nanoseconds;
+}
+
+std::vector<ReaderStats::Stats> ReaderStats::Get() {
+	std::vector<Stats> result(entries);
+	std::stable_sort(result.begin(), result.end(), LongerFirst);
+	return result;
+}
+
+bool ReaderStats::Get(const std::string& name, Phase phase, Stats& stats) {
+	for (size_t i = 0; i < entries.size(); i++) {
+		if (entries[i].phase == phase && entries[i].name == name) {
+			stats = entries[i];
+			return true;
+		}
+	}
+	return false;
+}
+
+void ReaderStats::SetAllocationCounter(AllocationCounter counter) {
+	allocation_counter = counter;
+}
+
+void ReaderStats::SetTraceDepth(int depth) {
+	trace_depth = depth < 0 ? 0 : (size_t) depth;
+}
+
+static const char* PhaseName(ReaderStats::Phase phase) {
+	switch (phase) {
+		case ReaderStats::Read:
+			return "read";
+		case ReaderStats::Write:
+			return "write";
+		case ReaderStats::Recode:
+			return "recode";
+	}
+	return "";
+}
+
+bool ReaderStats::WriteTrace(const std::string& filename) {
+	FILE* stream = fopen(filename.c_str(), "w");
+	if (stream == NULL)
+		return false;
+
+	fputs("{\"traceEvents\":[", stream);
+	for (size_t i = 0; i < trace.size(); i++) {
+		const TraceEvent& event = trace[i];
+		const Stats& stats = entries[event.entry];
+		// Timestamps are in microseconds
+		fprintf(stream, "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+			"\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"bytes\":%llu}}",
+			i == 0 ? "" : ",", stats.name.c_str(), PhaseName(stats.phase),
+			event.start / 1000.0, event.duration / 1000.0, event.bytes);
+	}
+	fputs("\n],\"displayTimeUnit\":\"ns\"}\n", stream);
+
+	bool ok = !ferror(stream);
+	return fclose(stream) == 0 && ok;
+}
+
+ReaderStats::Scope::Scope(const char* name, Phase phase) : bytes(0) {
+	Frame frame;
+	frame.entry = GetEntry(name, phase);
+	frame.child_nanoseconds = 0;
+	frame.allocations = 0;
+	frame.allocated_bytes = 0;
+	if (phase == Recode && !frames.empty())
+		entries[frames.back().entry].strings++;
+	if (allocation_counter != NULL)
+		allocation_counter(frame.allocations, frame.allocated_bytes);
+	frames.push_back(frame);
+	// Last, so the bookkeeping above is not measured
+	frames.back().start = Clock::now();
+}
+
+ReaderStats::Scope::~Scope() {
+	Clock::time_point end = Clock::now();
+	Frame frame = frames.back();
+	frames.pop_back();
+
+	if (allocation_counter != NULL) {
+		unsigned long long allocations = 0;
+		unsigned long long allocated_bytes = 0;
+		allocation_counter(allocations, allocated_bytes);
+		entries[frame.entry].allocations += allocations - frame.allocations;
+		entries[frame.entry].allocated_bytes += allocated_bytes - frame.allocated_bytes;
+	}
+
+	unsigned long long elapsed = Nanoseconds(end - frame.start);
+	Stats& stats = entries[frame.entry];
+	stats.calls++;
+	stats.bytes += bytes;
+	stats.nanoseconds += elapsed;
+	stats.self_nanoseconds += elapsed - std::min(elapsed, frame.child_nanoseconds);
+	if (!frames.empty())
+		frames.back().child_nanoseconds += elapsed;
+
+	if (frames.size() < trace_depth && trace.size() < trace_limit) {
+		TraceEvent event;
+		event.entry = frame.entry;
+		event.start = Nanoseconds(frame.start - epoch);
+		event.duration = elapsed;
+		event.bytes = bytes;
+		trace.push_back(event);
+	}
+}
+
+void ReaderStats::Scope::SetBytes(unsigned long long bytes) {
+	this->bytes = bytes;
+}
+
+void ReaderStats::AddSkippedChunk() {
+	if (!frames.empty())
+		entries[frames.back().entry].chunks_skipped++;
+}
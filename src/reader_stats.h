@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#ifndef LCF_READER_STATS_H
+#define LCF_READER_STATS_H
+
+#include <string>
+#include <vector>
+#include "reader_types.h"
+#include "reader_options.h"
+
+/**
+ * ReaderStats namespace.
+ *
+ * Collects time and byte counters of LCF reading and writing per struct
+ * when liblcf is built with LCF_INSTRUMENT. Without it the readers
+ * contain no instrumentation and all queries return nothing.
+ *
+ * Counters are global and not synchronized, only instrument loading
+ * from one thread at a time.
+ */
+namespace ReaderStats {
+
+	/**
+	 * Kind of work a counter measures.
+	 */
+	enum Phase {
+		Read,
+		Write,
+		Recode
+	};
+
+	/**
+	 * Counters of one struct and phase.
+	 */
+	struct Stats {
+		/** Struct name, "Recode" for string conversion. */
+		std::string name;
+		Phase phase;
+		/** Number of structs read or written. */
+		uint32_t calls;
+		/** LCF bytes read or written, input bytes for Recode. */
+		unsigned long long bytes;
+		/** Time including nested structs. */
+		unsigned long long nanoseconds;
+		/** Time without nested structs and string conversion. */
+		unsigned long long self_nanoseconds;
+		/** Strings converted directly in this struct. */
+		uint32_t strings;
+		/** Unknown chunks skipped directly in this struct. */
+		uint32_t chunks_skipped;
+		/** Heap allocations including nested structs, see SetAllocationCounter. */
+		unsigned long long allocations;
+		/** Heap bytes allocated including nested structs. */
+		unsigned long long allocated_bytes;
+	};
+
+	/**
+	 * Returns the number of heap allocations and allocated bytes so far.
+	 */
+	typedef void (*AllocationCounter)(unsigned long long& count, unsigned long long& bytes);
+
+	/**
+	 * Checks if liblcf was built with LCF_INSTRUMENT.
+	 */
+	bool IsEnabled();
+
+	/**
+	 * Clears all counters and the trace.
+	 */
+	void Reset();
+
+	/**
+	 * Returns the counters of every measured struct, sorted by time
+	 * including nested structs, longest first.
+	 */
+	std::vector<Stats> Get();
+
+	/**
+	 * Returns the counters of one struct.
+	 *
+	 * @param name struct name.
+	 * @param phase kind of work.
+	 * @param stats receives the counters.
+	 * @return true if the struct was measured.
+	 */
+	bool Get(const std::string& name, Phase phase, Stats& stats);
+
+	/**
+	 * Sets a function counting heap allocations, usually backed by a
+	 * replaced operator new of the application. Scopes then also record
+	 * the allocations made while reading or writing.
+	 *
+	 * @param counter counting function or NULL to stop counting.
+	 */
+	void SetAllocationCounter(AllocationCounter counter);
+
+	/**
+	 * Sets how deep nested structs are recorded in the trace. Structs
+	 * deeper than this only update the counters. Default is 4.
+	 */
+	void SetTraceDepth(int depth);
+
+	/**
+	 * Writes the recorded trace in Chrome trace event format, for
+	 * chrome://tracing or Perfetto.
+	 *
+	 * @param filename output file.
+	 * @return true on success.
+	 */
+	bool WriteTrace(const std::string& filename);
+
+	/**
+	 * Measures one struct read, write or string conversion until it is
+	 * destroyed. Scopes must be nested.
+	 */
+	class Scope {
+	public:
+		Scope(const char* name, Phase phase);
+		~Scope();
+
+		/**
+		 * Sets the number of bytes processed in the scope.
+		 */
+		void SetBytes(unsigned long long bytes);
+
+	private:
+		Scope(const Scope&);
+		Scope& operator=(const Scope&);
+
+		unsigned long long bytes;
+	};
+
+	/**
+	 * Counts a skipped chunk in the innermost scope.
+	 */
+	void AddSkippedChunk();
+}
+
+#endif
@@ -4,6 +4,7 @@
  * http://opensource.org/licenses/MIT
  */
 
+#include <bitset>
 #include <cstring>
 #include <iostream>
 #include <iomanip>
@@ -11,32 +12,52 @@
 #include "lmt_reader.h"
 #include "lmu_reader.h"
 #include "lsd_reader.h"
+#include "reader_stats.h"
 #include "reader_struct.h"
 #include "rpg_save.h"
 
 // Read/Write Struct
 
+// The maps are built on first use. Initialization of function local
+// statics is thread-safe, so several threads may load at the same time.
+
 template <class S>
 void Struct<S>::MakeFieldMap() {
-	if (!field_map.empty())
-		return;
-	for (int i = 0; fields[i] != NULL; i++)
-		field_map[fields[i]->id] = fields[i];
+	static const bool built = []() {
+		for (int i = 0; fields[i] != NULL; i++)
+			field_map[fields[i]->id] = fields[i];
+		return true;
+	}();
+	(void) built;
 }
 
 template <class S>
 void Struct<S>::MakeTagMap() {
-	if (!tag_map.empty())
-		return;
-	for (int i = 0; fields[i] != NULL; i++)
-		tag_map[fields[i]->name] = fields[i];
+	static const bool built = []() {
+		tag_map.Build(fields);
+		return true;
+	}();
+	(void) built;
 }
 
 template <class S>
 void Struct<S>::ReadLcf(S& obj, LcfReader& stream) {
+	static const S def = S();
+	ReadLcf(obj, stream, def);
+}
+
+template <class S>
+void Struct<S>::ReadLcf(S& obj, LcfReader& stream, const S& def) {
 	MakeFieldMap();
 
+#ifdef LCF_INSTRUMENT
+	ReaderStats::Scope stats(name, ReaderStats::Read);
+	uint32_t startpos = stream.Tell();
+#endif
+
 	LcfReader::Chunk chunk_info;
+	// Chunk IDs are below 256
+	std::bitset<256> read;
 
 	while (!stream.Eof()) {
 		chunk_info.ID = stream.ReadInt();
@@ -52,15 +73,38 @@ void Struct<S>::ReadLcf(S& obj, LcfReader& stream) {
 #ifdef LCF_DEBUG_TRACE
 			printf("0x%02x (size: %d, pos: 0x%x): %s\n", chunk_info.ID, chunk_info.length, stream.Tell(), it->second->name);
 #endif
-			it->second->ReadLcf(obj, stream, chunk_info.length);
+			it->second->ReadLcf(obj, stream, chunk_info.length, def);
+			if (chunk_info.ID < read.size())
+				read.set(chunk_info.ID);
 		}
-		else
+		else {
+#ifdef LCF_INSTRUMENT
+			ReaderStats::AddSkippedChunk();
+#endif
 			stream.Skip(chunk_info);
+		}
+	}
+
+	// Fields missing in the file get their default value, so reading into
+	// a used object, for example with LMU_Reader::LoadInto, gives the same
+	// result as reading into a new one.
+	for (int i = 0; fields[i] != NULL; i++) {
+		uint32_t id = (uint32_t) fields[i]->id;
+		if (id < read.size() && !read.test(id))
+			fields[i]->SetDefault(obj, def);
 	}
+
+#ifdef LCF_INSTRUMENT
+	stats.SetBytes(stream.Tell() - startpos);
+#endif
 }
 
 template <class S>
 void Struct<S>::WriteLcf(const S& obj, LcfWriter& stream) {
+#ifdef LCF_INSTRUMENT
+	ReaderStats::Scope stats(name, ReaderStats::Write);
+	uint32_t startpos = stream.Tell();
+#endif
 	S ref = S();
 	int last = -1;
 	for (int i = 0; fields[i] != NULL; i++) {
@@ -80,10 +124,18 @@ void Struct<S>::WriteLcf(const S& obj, LcfWriter& stream) {
 		field->WriteLcf(obj, stream);
 	}
 	stream.WriteInt(0);
+
+#ifdef LCF_INSTRUMENT
+	stats.SetBytes(stream.Tell() - startpos);
+#endif
 }
 
 template <>
 void Struct<RPG::Save>::WriteLcf(const RPG::Save& obj, LcfWriter& stream) {
+#ifdef LCF_INSTRUMENT
+	ReaderStats::Scope stats(name, ReaderStats::Write);
+	uint32_t startpos = stream.Tell();
+#endif
 	RPG::Save ref = RPG::Save();
 	int last = -1;
 	for (int i = 0; fields[i] != NULL; i++) {
@@ -103,6 +155,10 @@ void Struct<RPG::Save>::WriteLcf(const RPG::Save& obj, LcfWriter& stream) {
 		field->WriteLcf(obj, stream);
 	}
 	// stream.WriteInt(0); // This last byte broke savegames
+
+#ifdef LCF_INSTRUMENT
+	stats.SetBytes(stream.Tell() - startpos);
+#endif
 }
 
 template <class S>
@@ -123,6 +179,50 @@ int Struct<S>::LcfSize(const S& obj, LcfWriter& stream) {
 	return result;
 }
 
+template <class S>
+void Struct<S>::HeapSize(const S& obj, HeapUsage& usage) {
+	HeapUsage::Entry* owner = usage.BeginObject(name);
+	for (int i = 0; fields[i] != NULL; i++)
+		fields[i]->HeapSize(obj, usage);
+	usage.EndObject(owner);
+}
+
+template <class S>
+void Struct<S>::HeapSizeByField(const S& obj, std::vector<HeapUsage::Entry>& sections) {
+	for (int i = 0; fields[i] != NULL; i++) {
+		// Size fields own nothing
+		if (fields[i]->name[0] == '\0')
+			continue;
+		HeapUsage usage;
+		HeapUsage::Entry* owner = usage.BeginObject(name);
+		fields[i]->HeapSize(obj, usage);
+		usage.EndObject(owner);
+
+		HeapUsage::Entry section;
+		section.name = fields[i]->name;
+		section.objects = usage.Objects() - 1;
+		section.bytes = usage.Bytes();
+		section.allocations = usage.Allocations();
+		section.string_bytes = 0;
+		std::vector<HeapUsage::Entry> types = usage.Get();
+		for (size_t j = 0; j < types.size(); j++)
+			section.string_bytes += types[j].string_bytes;
+		sections.push_back(section);
+	}
+}
+
+template <class S>
+void Struct<S>::GetStrings(const S& obj, std::vector<std::pair<int, const std::string*> >& strings) {
+	for (int i = 0; fields[i] != NULL; i++) {
+		const TypedField<S, std::string>* field = dynamic_cast<const TypedField<S, std::string>*>(fields[i]);
+		if (field != NULL)
+			strings.push_back(std::make_pair(field->id, &(obj.*(field->ref))));
+		const TypedField<S, SharedString>* shared = dynamic_cast<const TypedField<S, SharedString>*>(fields[i]);
+		if (shared != NULL)
+			strings.push_back(std::make_pair(shared->id, &(obj.*(shared->ref)).str()));
+	}
+}
+
 template <class S>
 void Struct<S>::WriteXml(const S& obj, XmlWriter& stream) {
 	IDReader::WriteXmlTag(obj, name, stream);
@@ -141,8 +241,13 @@ public:
 	}
 
 	void StartElement(XmlReader& stream, const char* name, const char** /* atts */) {
-		field = Struct<S>::tag_map[name];
-		field->BeginXml(ref, stream);
+		field = Struct<S>::tag_map.Find(name);
+		if (field != NULL)
+			field->BeginXml(ref, stream);
+		else {
+			stream.Error("Unrecognized field '%s'", name);
+			stream.SetHandler(stream.MakeHandler<XmlHandler>());
+		}
 	}
 
 	void EndElement(XmlReader& /* stream */, const char* /* name */) {
@@ -167,7 +272,7 @@ public:
 		if (strcmp(name, Struct<S>::name) != 0)
 			stream.Error("Expecting %s but got %s", Struct<S>::name, name);
 		Struct<S>::IDReader::ReadIDXml(ref, atts);
-		stream.SetHandler(new StructXmlHandler<S>(ref));
+		stream.SetHandler(stream.MakeHandler<StructXmlHandler<S> >(ref));
 	}
 private:
 	S& ref;
@@ -175,7 +280,7 @@ private:
 
 template <class S>
 void Struct<S>::BeginXml(S& obj, XmlReader& stream) {
-	stream.SetHandler(new StructFieldXmlHandler<S>(obj));
+	stream.SetHandler(stream.MakeHandler<StructFieldXmlHandler<S> >(obj));
 }
 
 // Read/Write std::vector<Struct>
@@ -212,6 +317,13 @@ int Struct<S>::LcfSize(const std::vector<S>& vec, LcfWriter& stream) {
 	return result;
 }
 
+template <class S>
+void Struct<S>::HeapSize(const std::vector<S>& vec, HeapUsage& usage) {
+	usage.AddElements(name, vec);
+	for (size_t i = 0; i < vec.size(); i++)
+		TypeReader<S>::HeapSize(vec[i], usage);
+}
+
 template <class S>
 void Struct<S>::WriteXml(const std::vector<S>& vec, XmlWriter& stream) {
 	int count = vec.size();
@@ -230,7 +342,7 @@ public:
 		ref.resize(ref.size() + 1);
 		S& obj = ref.back();
 		Struct<S>::IDReader::ReadIDXml(obj, atts);
-		stream.SetHandler(new StructXmlHandler<S>(obj));
+		stream.SetHandler(stream.MakeHandler<StructXmlHandler<S> >(obj));
 	}
 private:
 	std::vector<S>& ref;
@@ -238,7 +350,7 @@ private:
 
 template <class S>
 void Struct<S>::BeginXml(std::vector<S>& obj, XmlReader& stream) {
-	stream.SetHandler(new StructVectorXmlHandler<S>(obj));
+	stream.SetHandler(stream.MakeHandler<StructVectorXmlHandler<S> >(obj));
 }
 
 // Instantiate templates
@@ -15,10 +15,12 @@
 #include <cstdlib>
 #include <boost/preprocessor/cat.hpp>
 #include <boost/preprocessor/stringize.hpp>
+#include "heap_usage.h"
 #include "reader_lcf.h"
 #include "writer_lcf.h"
 #include "reader_xml.h"
 #include "writer_xml.h"
+#include "shared_string.h"
 #include "rpg_eventpagecondition.h"
 #include "rpg_trooppagecondition.h"
 #include "rpg_terrain.h"
@@ -68,6 +70,7 @@ template <>	struct TypeCategory<int>							{ static const Category::Index value
 template <>	struct TypeCategory<bool>							{ static const Category::Index value = Category::Primitive; };
 template <>	struct TypeCategory<double>							{ static const Category::Index value = Category::Primitive; };
 template <>	struct TypeCategory<std::string>					{ static const Category::Index value = Category::Primitive; };
+template <>	struct TypeCategory<SharedString>					{ static const Category::Index value = Category::Primitive; };
 
 template <class T>
 struct TypeCategory<std::vector<T> > {
@@ -90,6 +93,7 @@ struct RawStruct {
 	static int LcfSize(const T& ref, LcfWriter& stream);
 	static void WriteXml(const T& ref, XmlWriter& stream);
 	static void BeginXml(T& ref, XmlReader& stream);
+	static void HeapSize(const T& ref, HeapUsage& usage);
 };
 
 template <class T>
@@ -112,6 +116,9 @@ struct TypeReader<T, Category::RawStruct> {
 	static void ParseXml(T& /* ref */, const std::string& /* data */) {
 		//no-op
 	}
+	static void HeapSize(const T& ref, HeapUsage& usage) {
+		RawStruct<T>::HeapSize(ref, usage);
+	}
 };
 
 /**
@@ -163,6 +170,8 @@ struct Primitive {
 	static void ParseXml(T& ref, const std::string& data) {
 		XmlReader::Read(ref, data);
 	}
+	static void HeapSize(const T& /* ref */, HeapUsage& /* usage */) {
+	}
 };
 
 /**
@@ -193,6 +202,9 @@ struct Primitive<std::vector<T> > {
 	static void ParseXml(std::vector<T>& ref, const std::string& data) {
 		XmlReader::Read(ref, data);
 	}
+	static void HeapSize(const std::vector<T>& ref, HeapUsage& usage) {
+		usage.Add(ref);
+	}
 };
 
 /**
@@ -227,6 +239,8 @@ struct Primitive<int> {
 	static void ParseXml(int& ref, const std::string& data) {
 		XmlReader::Read(ref, data);
 	}
+	static void HeapSize(const int& /* ref */, HeapUsage& /* usage */) {
+	}
 };
 
 /**
@@ -252,6 +266,39 @@ struct Primitive<std::string> {
 	static void ParseXml(std::string& ref, const std::string& data) {
 		XmlReader::Read(ref, data);
 	}
+	static void HeapSize(const std::string& ref, HeapUsage& usage) {
+		usage.Add(ref);
+	}
+};
+
+/**
+ * Shared string specialization.
+ */
+template <>
+struct Primitive<SharedString> {
+	static void ReadLcf(SharedString& ref, LcfReader& stream, uint32_t length) {
+		stream.ReadString(ref, length);
+#ifdef LCF_DEBUG_TRACE
+		printf("  %s\n", ref.c_str());
+#endif
+	}
+	static void WriteLcf(const SharedString& ref, LcfWriter& stream) {
+		stream.Write(ref.str());
+	}
+	static int LcfSize(const SharedString& ref, LcfWriter& stream) {
+		return stream.Decode(ref.str()).size();
+	}
+	static void WriteXml(const SharedString& ref, XmlWriter& stream) {
+		stream.Write(ref.str());
+	}
+	static void ParseXml(SharedString& ref, const std::string& data) {
+		std::string str;
+		XmlReader::Read(str, data);
+		ref = str;
+	}
+	static void HeapSize(const SharedString& ref, HeapUsage& usage) {
+		usage.Add(ref);
+	}
 };
 
 /**
@@ -277,6 +324,9 @@ struct TypeReader<T, Category::Primitive> {
 	static void ParseXml(T& ref, const std::string& data) {
 		Primitive<T>::ParseXml(ref, data);
 	}
+	static void HeapSize(const T& ref, HeapUsage& usage) {
+		Primitive<T>::HeapSize(ref, usage);
+	}
 };
 
 /**
@@ -289,13 +339,20 @@ struct Field {
 	int id;
 	const char* const name;
 
-	virtual void ReadLcf(S& obj, LcfReader& stream, uint32_t length) const = 0;
+	/**
+	 * Reads the field of obj. Nested structs and flags start from the
+	 * field of def, the default of obj.
+	 */
+	virtual void ReadLcf(S& obj, LcfReader& stream, uint32_t length, const S& def) const = 0;
 	virtual void WriteLcf(const S& obj, LcfWriter& stream) const = 0;
 	virtual int LcfSize(const S& obj, LcfWriter& stream) const = 0;
 	virtual bool IsDefault(const S& obj, const S& ref) const = 0;
+	/** Assigns the field of def to obj, reusing the storage of obj. */
+	virtual void SetDefault(S& obj, const S& def) const = 0;
 	virtual void WriteXml(const S& obj, XmlWriter& stream) const = 0;
 	virtual void BeginXml(S& obj, XmlReader& stream) const = 0;
 	virtual void ParseXml(S& obj, const std::string& data) const = 0;
+	virtual void HeapSize(const S& obj, HeapUsage& usage) const = 0;
 
 	Field(int id, const char* name) :
 		id(id), name(name) {}
@@ -331,6 +388,11 @@ struct Compare_Test<std::string> {
 	static const bool value = true;
 };
 
+template <>
+struct Compare_Test<SharedString> {
+	static const bool value = true;
+};
+
 template <class T, bool comparable>
 struct Compare_Traits_Impl {};
 
@@ -363,6 +425,17 @@ struct Compare_Traits {
 	}
 };
 
+/**
+ * Reads a field with the default of the enclosing struct. Only nested
+ * structs and flags need it, see the specializations below Flags.
+ */
+template <class T, Category::Index cat = TypeCategory<T>::value>
+struct FieldReader {
+	static void ReadLcf(T& ref, LcfReader& stream, uint32_t length, const T& /* def */) {
+		TypeReader<T>::ReadLcf(ref, stream, length);
+	}
+};
+
 /**
  * TypedField class template.
  */
@@ -370,8 +443,8 @@ template <class S, class T>
 struct TypedField : public Field<S> {
 	T S::*ref;
 
-	void ReadLcf(S& obj, LcfReader& stream, uint32_t length) const {
-		TypeReader<T>::ReadLcf(obj.*ref, stream, length);
+	void ReadLcf(S& obj, LcfReader& stream, uint32_t length, const S& def) const {
+		FieldReader<T>::ReadLcf(obj.*ref, stream, length, def.*ref);
 	}
 	void WriteLcf(const S& obj, LcfWriter& stream) const {
 		TypeReader<T>::WriteLcf(obj.*ref, stream);
@@ -390,9 +463,15 @@ struct TypedField : public Field<S> {
 	void ParseXml(S& obj, const std::string& data) const {
 		TypeReader<T>::ParseXml(obj.*ref, data);
 	}
+	void HeapSize(const S& obj, HeapUsage& usage) const {
+		TypeReader<T>::HeapSize(obj.*ref, usage);
+	}
 	bool IsDefault(const S& a, const S& b) const {
 		return Compare_Traits<T>::IsEqual(a.*ref, b.*ref);
 	}
+	void SetDefault(S& obj, const S& def) const {
+		obj.*ref = def.*ref;
+	}
 
 	TypedField(T S::*ref, int id, const char* name) :
 		Field<S>(id, name), ref(ref) {}
@@ -405,7 +484,7 @@ template <class S, class T>
 struct SizeField : public Field<S> {
 	const std::vector<T> S::*ref;
 
-	void ReadLcf(S& /* obj */, LcfReader& stream, uint32_t length) const {
+	void ReadLcf(S& /* obj */, LcfReader& stream, uint32_t length, const S& /* def */) const {
 		int dummy;
 		TypeReader<int>::ReadLcf(dummy, stream, length);
 	}
@@ -426,9 +505,15 @@ struct SizeField : public Field<S> {
 	void ParseXml(S& /* obj */, const std::string& /* data */) const {
 		// no-op
 	}
+	void HeapSize(const S& /* obj */, HeapUsage& /* usage */) const {
+		// no-op
+	}
 	bool IsDefault(const S& a, const S& b) const {
 		return (a.*ref).empty() && (b.*ref).empty();
 	}
+	void SetDefault(S& /* obj */, const S& /* def */) const {
+		// no-op
+	}
 
 	SizeField(const std::vector<T> S::*ref, int id) :
 		Field<S>(id, ""), ref(ref) {}
@@ -490,10 +575,93 @@ struct IDReaderT<S, false> {
 	static void ReadIDXml(S& /* obj */, const char** /* atts */) {}
 };
 
-struct StringComparator {
-	bool operator() (const char* const& lhs, const char* const& rhs) const {
-		return strcmp(lhs, rhs) < 0;
+/**
+ * Maps XML tag names to the entries of a NULL-terminated table.
+ *
+ * Built once as a perfect hash: a seed is searched so that every name
+ * gets a slot of its own, so a lookup is one hash and one strcmp.
+ */
+template <class T>
+class TagMap {
+public:
+	TagMap() : seed(0), mask(0) {}
+
+	bool empty() const {
+		return table.empty();
+	}
+
+	/**
+	 * Builds the map. Entries with empty names are skipped, for
+	 * duplicate names the last entry wins.
+	 *
+	 * @param entries NULL-terminated table of entries with a name.
+	 */
+	void Build(const T* const entries[]) {
+		std::vector<const T*> items;
+		for (int i = 0; entries[i] != NULL; i++) {
+			if (entries[i]->name[0] == '\0')
+				continue;
+			size_t j = 0;
+			while (j < items.size() && strcmp(items[j]->name, entries[i]->name) != 0)
+				j++;
+			if (j == items.size())
+				items.push_back(entries[i]);
+			else
+				items[j] = entries[i];
+		}
+
+		size_t size = 1;
+		while (size < items.size() * 2)
+			size <<= 1;
+		for (;;) {
+			for (uint32_t s = 0; s < 256; s++) {
+				if (TryBuild(items, size, s))
+					return;
+			}
+			size <<= 1;
+		}
+	}
+
+	/**
+	 * Looks up an entry.
+	 *
+	 * @param name tag name.
+	 * @return the entry or NULL if the name is unknown.
+	 */
+	const T* Find(const char* name) const {
+		const T* entry = table[Hash(name, seed) & mask];
+		if (entry == NULL || strcmp(entry->name, name) != 0)
+			return NULL;
+		return entry;
 	}
+
+private:
+	static uint32_t Hash(const char* name, uint32_t seed) {
+		// FNV-1a
+		uint32_t hash = 2166136261U ^ (seed * 0x9E3779B9U);
+		for (; *name != '\0'; name++) {
+			hash ^= (uint8_t) *name;
+			hash *= 16777619U;
+		}
+		return hash ^ (hash >> 16);
+	}
+
+	bool TryBuild(const std::vector<const T*>& items, size_t size, uint32_t s) {
+		table.assign(size, NULL);
+		for (size_t i = 0; i < items.size(); i++) {
+			const T*& slot = table[Hash(items[i]->name, s) & (size - 1)];
+			if (slot != NULL)
+				return false;
+			slot = items[i];
+		}
+		seed = s;
+		mask = (uint32_t) (size - 1);
+		return true;
+	}
+
+	std::vector<const T*> table;
+	uint32_t seed;
+	uint32_t mask;
 };
 
 // Struct class template
@@ -502,7 +670,7 @@ template <class S>
 class Struct {
 private:
 	typedef std::map<int, const Field<S>* > field_map_type;
-	typedef std::map<const char* const, const Field<S>*, StringComparator> tag_map_type;
+	typedef TagMap<Field<S> > tag_map_type;
 	typedef IDReaderT<S, IDChecker<S>::value > IDReader;
 	static const Field<S>* fields[];
 	static field_map_type field_map;
@@ -518,23 +686,48 @@ private:
 
 public:
 	static void ReadLcf(S& obj, LcfReader& stream);
+	/**
+	 * Reads an object, fields missing in the stream are set to those of
+	 * def. For a struct inside another one, def is the member of the
+	 * default of the enclosing struct, which may differ from S().
+	 */
+	static void ReadLcf(S& obj, LcfReader& stream, const S& def);
 	static void WriteLcf(const S& obj, LcfWriter& stream);
 	static int LcfSize(const S& obj, LcfWriter& stream);
 	static void WriteXml(const S& obj, XmlWriter& stream);
 	static void BeginXml(S& obj, XmlReader& stream);
+	static void HeapSize(const S& obj, HeapUsage& usage);
 
 	static void ReadLcf(std::vector<S>& obj, LcfReader& stream);
 	static void WriteLcf(const std::vector<S>& obj, LcfWriter& stream);
 	static int LcfSize(const std::vector<S>& obj, LcfWriter& stream);
 	static void WriteXml(const std::vector<S>& obj, XmlWriter& stream);
 	static void BeginXml(std::vector<S>& obj, XmlReader& stream);
+	static void HeapSize(const std::vector<S>& obj, HeapUsage& usage);
+
+	/**
+	 * Walks every field of an object on its own.
+	 *
+	 * @param obj object to walk.
+	 * @param sections receives the usage of each field.
+	 */
+	static void HeapSizeByField(const S& obj, std::vector<HeapUsage::Entry>& sections);
+
+	/**
+	 * Returns the string fields of an object.
+	 *
+	 * @param obj object to walk.
+	 * @param strings receives the LCF chunk ID and value of each string
+	 *                field, in field order.
+	 */
+	static void GetStrings(const S& obj, std::vector<std::pair<int, const std::string*> >& strings);
 };
 
 template <class S>
 std::map<int, const Field<S>* > Struct<S>::field_map;
 
 template <class S>
-std::map<const char* const, const Field<S>*, StringComparator> Struct<S>::tag_map;
+TagMap<Field<S> > Struct<S>::tag_map;
 
 /**
  * Struct reader.
@@ -559,6 +752,9 @@ struct TypeReader<T, Category::Struct> {
 	static void ParseXml(T& /* ref */, const std::string& /* data */) {
 		// no-op
 	}
+	static void HeapSize(const T& ref, HeapUsage& usage) {
+		Struct<T>::HeapSize(ref, usage);
+	}
 };
 
 template <class T>
@@ -581,6 +777,9 @@ struct TypeReader<std::vector<T>, Category::Struct> {
 	static void ParseXml(std::vector<T>& /* ref */, const std::string& /* data */) {
 		// no-op
 	}
+	static void HeapSize(const std::vector<T>& ref, HeapUsage& usage) {
+		Struct<T>::HeapSize(ref, usage);
+	}
 };
 
 /**
@@ -597,7 +796,7 @@ public:
 
 private:
 	static const uint32_t max_size;
-	typedef std::map<const char* const, const Flag*, StringComparator> tag_map_type;
+	typedef TagMap<Flag> tag_map_type;
 	static const Flag* flags[];
 	static tag_map_type tag_map;
 	static const char* const name;
@@ -615,7 +814,7 @@ public:
 };
 
 template <class S>
-std::map<const char* const, const typename Flags<S>::Flag*, StringComparator> Flags<S>::tag_map;
+TagMap<typename Flags<S>::Flag> Flags<S>::tag_map;
 
 /**
  * Wrapper XML handler struct.
@@ -640,6 +839,37 @@ struct TypeReader<T, Category::Flags> {
 	static void ParseXml(T& /* ref */, const std::string& /* data */) {
 		// no-op
 	}
+	static void HeapSize(const T& /* ref */, HeapUsage& /* usage */) {
+		// no-op
+	}
+};
+
+/**
+ * Nested struct field, missing fields are set from the enclosing default.
+ */
+template <class T>
+struct FieldReader<T, Category::Struct> {
+	static void ReadLcf(T& ref, LcfReader& stream, uint32_t /* length */, const T& def) {
+		Struct<T>::ReadLcf(ref, stream, def);
+	}
+};
+
+template <class T>
+struct FieldReader<std::vector<T>, Category::Struct> {
+	static void ReadLcf(std::vector<T>& ref, LcfReader& stream, uint32_t length, const std::vector<T>& /* def */) {
+		TypeReader<std::vector<T> >::ReadLcf(ref, stream, length);
+	}
+};
+
+/**
+ * Flags field, flags after the read bytes keep the enclosing default.
+ */
+template <class T>
+struct FieldReader<T, Category::Flags> {
+	static void ReadLcf(T& ref, LcfReader& stream, uint32_t length, const T& def) {
+		ref = def;
+		Flags<T>::ReadLcf(ref, stream, length);
+	}
 };
 
 /**
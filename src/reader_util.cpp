@@ -33,9 +33,9 @@
 #include <sstream>
 #include <vector>
 
-#include "data.h"
 #include "inireader.h"
 #include "ldb_reader.h"
+#include "reader_stats.h"
 #include "reader_util.h"
 
 namespace ReaderUtil {
@@ -86,53 +86,57 @@ std::vector<std::string> ReaderUtil::DetectEncodings(const std::string& database
 #ifdef LCF_SUPPORT_ICU
 	std::ostringstream text;
 
-	// Populate Data::terms and Data::system or will empty by default even if load fails
-	LDB_Reader::Load(database_file, "");
+	// Loaded into a local database so the game data of the caller is
+	// not replaced. Terms and system stay empty if the load fails.
+	RPG::Database db;
+	LDB_Reader::Load(database_file, "", db);
+	const RPG::Terms& terms = db.terms;
+	const RPG::System& system = db.system;
 
 	text <<
-	Data::terms.menu_save <<
-	Data::terms.menu_quit <<
-	Data::terms.new_game <<
-	Data::terms.load_game <<
-	Data::terms.exit_game <<
-	Data::terms.status <<
-	Data::terms.row <<
-	Data::terms.order <<
-	Data::terms.wait_on <<
-	Data::terms.wait_off <<
-	Data::terms.level <<
-	Data::terms.health_points <<
-	Data::terms.spirit_points <<
-	Data::terms.normal_status <<
-	Data::terms.exp_short <<
-	Data::terms.lvl_short <<
-	Data::terms.hp_short <<
-	Data::terms.sp_short <<
-	Data::terms.sp_cost <<
-	Data::terms.attack <<
-	Data::terms.defense <<
-	Data::terms.spirit <<
-	Data::terms.agility <<
-	Data::terms.weapon <<
-	Data::terms.shield <<
-	Data::terms.armor <<
-	Data::terms.helmet <<
-	Data::terms.accessory <<
-	Data::terms.save_game_message <<
-	Data::terms.load_game_message <<
-	Data::terms.file <<
-	Data::terms.exit_game_message <<
-	Data::terms.yes <<
-	Data::terms.no <<
-	Data::system.boat_name <<
-	Data::system.ship_name <<
-	Data::system.airship_name <<
-	Data::system.title_name <<
-	Data::system.gameover_name <<
-	Data::system.system_name <<
-	Data::system.system2_name <<
-	Data::system.battletest_background <<
-	Data::system.frame_name;
+	terms.menu_save <<
+	terms.menu_quit <<
+	terms.new_game <<
+	terms.load_game <<
+	terms.exit_game <<
+	terms.status <<
+	terms.row <<
+	terms.order <<
+	terms.wait_on <<
+	terms.wait_off <<
+	terms.level <<
+	terms.health_points <<
+	terms.spirit_points <<
+	terms.normal_status <<
+	terms.exp_short <<
+	terms.lvl_short <<
+	terms.hp_short <<
+	terms.sp_short <<
+	terms.sp_cost <<
+	terms.attack <<
+	terms.defense <<
+	terms.spirit <<
+	terms.agility <<
+	terms.weapon <<
+	terms.shield <<
+	terms.armor <<
+	terms.helmet <<
+	terms.accessory <<
+	terms.save_game_message <<
+	terms.load_game_message <<
+	terms.file <<
+	terms.exit_game_message <<
+	terms.yes <<
+	terms.no <<
+	system.boat_name <<
+	system.ship_name <<
+	system.airship_name <<
+	system.title_name <<
+	system.gameover_name <<
+	system.system_name <<
+	system.system2_name <<
+	system.battletest_background <<
+	system.frame_name;
 
 	if (!text.str().empty()) {
 		UErrorCode status = U_ZERO_ERROR;
@@ -261,6 +265,10 @@ std::string ReaderUtil::Recode(const std::string& str_to_encode,
 	if (src_enc.empty() || dst_enc.empty() || str_to_encode.empty()) {
 		return str_to_encode;
 	}
+#ifdef LCF_INSTRUMENT
+	ReaderStats::Scope stats("Recode", ReaderStats::Recode);
+	stats.SetBytes(str_to_encode.size());
+#endif
 	if (atoi(src_enc.c_str()) > 0) {
 		src_enc_str = ReaderUtil::CodepageToEncoding(atoi(src_enc.c_str()));
 	}
@@ -8,6 +8,7 @@
 #define LCF_READER_UTIL_H
 
 #include <string>
+#include <vector>
 
 /**
  * ReaderUtil namespace.
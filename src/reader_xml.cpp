@@ -4,11 +4,15 @@
  * http://opensource.org/licenses/MIT
  */
 
+#include <algorithm>
 #include <sstream>
+#include <locale>
+#include <climits>
 #include <cstdarg>
 #include <cstdio>
 #include "reader_lcf.h"
 #include "reader_xml.h"
+#include "small_vector.h"
 
 // Expat callbacks
 #if defined(LCF_SUPPORT_XML)
@@ -29,7 +33,20 @@ static void CharacterDataHandler(void* closure, const XML_Char* s, int len) {
 
 XmlReader::XmlReader(const std::string& filename) :
 	filename(filename),
-	stream(NULL),
+	data(NULL),
+	size(0),
+	ok(false),
+	chunk_size(default_chunk_size),
+	parser(NULL)
+{
+	Open();
+}
+
+XmlReader::XmlReader(const char* data, size_t size) :
+	data(data),
+	size(size),
+	ok(true),
+	chunk_size(default_chunk_size),
 	parser(NULL)
 {
 	Open();
@@ -37,11 +54,24 @@ XmlReader::XmlReader(const std::string& filename) :
 
 XmlReader::~XmlReader() {
 	Close();
+
+	// Handlers still on the stack after an aborted parse
+	for (size_t i = handlers.size(); i-- > 0; ) {
+		XmlHandler* handler = handlers[i];
+		if (handler != NULL && (i == 0 || handler != handlers[i - 1]))
+			ReleaseHandler(handler);
+	}
+	for (size_t i = 0; i < handler_slots.size(); i++)
+		::operator delete(handler_slots[i]);
 }
 
 void XmlReader::Open() {
 #if defined(LCF_SUPPORT_XML)
-	stream = fopen(filename.c_str(), "r");
+	if (!filename.empty()) {
+		ok = file.Open(filename);
+		data = file.Data();
+		size = file.Size();
+	}
 	parser = XML_ParserCreate("UTF-8");
 
 	XML_SetUserData(parser, (void*) this);
@@ -54,9 +84,12 @@ void XmlReader::Open() {
 
 void XmlReader::Close() {
 #if defined(LCF_SUPPORT_XML)
-	if (stream != NULL)
-		fclose(stream);
-	stream = NULL;
+	if (!filename.empty()) {
+		file.Close();
+		data = NULL;
+		size = 0;
+	}
+	ok = false;
 
 	if (parser != NULL)
 		XML_ParserFree(parser);
@@ -65,7 +98,7 @@ void XmlReader::Close() {
 }
 
 bool XmlReader::IsOk() const {
-	return (stream != NULL && !ferror(stream) && parser != NULL);
+	return (ok && parser != NULL);
 }
 
 void XmlReader::Error(const char* fmt, ...) {
@@ -78,21 +111,55 @@ void XmlReader::Error(const char* fmt, ...) {
 
 void XmlReader::Parse() {
 #if defined(LCF_SUPPORT_XML)
-	static const int bufsize = 4096;
-	while (IsOk() && !feof(stream)) {
-		void* buffer = XML_GetBuffer(parser, bufsize);
-		int len = fread(buffer, 1, bufsize, stream);
-		int result = XML_ParseBuffer(parser, len, len <= 0);
-		if (result == 0)
+	if (!IsOk())
+		return;
+
+	// Expat takes the length as int
+	size_t slice = chunk_size;
+	if (slice == 0 || slice > INT_MAX)
+		slice = INT_MAX;
+
+	size_t pos = 0;
+	do {
+		size_t len = size - pos < slice ? size - pos : slice;
+		bool last = pos + len == size;
+		if (XML_Parse(parser, data + pos, (int) len, last) == XML_STATUS_ERROR) {
 			Error("%s", XML_ErrorString(XML_GetErrorCode(parser)));
-	}
+			break;
+		}
+		pos += len;
+	} while (pos < size);
 #endif
 }
 
+void XmlReader::SetChunkSize(size_t size) {
+	chunk_size = size;
+}
+
 void XmlReader::SetHandler(XmlHandler* handler) {
 	handlers.back() = handler;
 }
 
+void* XmlReader::AllocateHandler() {
+	if (free_handlers.empty()) {
+		void* slot = ::operator new(handler_size);
+		handler_slots.push_back(slot);
+		return slot;
+	}
+	void* slot = free_handlers.back();
+	free_handlers.pop_back();
+	return slot;
+}
+
+void XmlReader::ReleaseHandler(XmlHandler* handler) {
+	// Handlers not made by MakeHandler belong to the caller
+	void* slot = dynamic_cast<void*>(handler);
+	if (std::find(handler_slots.begin(), handler_slots.end(), slot) == handler_slots.end())
+		return;
+	handler->~XmlHandler();
+	free_handlers.push_back(slot);
+}
+
 void XmlReader::StartElement(const char* name, const char** atts) {
 	XmlHandler* handler = handlers.back();
 	handlers.push_back(handler);
@@ -109,50 +176,173 @@ void XmlReader::EndElement(const char* name) {
 	handler->CharacterData(*this, buffer);
 	handlers.pop_back();
 	if (handler != handlers.back())
-		delete handler;
+		ReleaseHandler(handler);
 	handlers.back()->EndElement(*this, name);
 }
 
 // Primitive type readers
 
+// These parse directly from the character data and, unlike
+// std::istringstream, don't depend on the global locale.
+
+static inline bool IsSpace(char c) {
+	return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static inline bool IsDigit(char c) {
+	return c >= '0' && c <= '9';
+}
+
+static inline const char* SkipSpace(const char* p, const char* end) {
+	while (p != end && IsSpace(*p))
+		++p;
+	return p;
+}
+
+/**
+ * Parses an optionally signed decimal integer.
+ * Out of range values are clamped, invalid input yields 0.
+ */
+static long long ParseInteger(const char* p, const char* end, long long min, long long max) {
+	// Larger than any accepted value, stops overflow of the accumulator
+	static const unsigned long long limit = 1ULL << 40;
+
+	p = SkipSpace(p, end);
+	bool negative = false;
+	if (p != end && (*p == '-' || *p == '+')) {
+		negative = *p == '-';
+		++p;
+	}
+	unsigned long long value = 0;
+	for (; p != end && IsDigit(*p); ++p) {
+		if (value < limit)
+			value = value * 10 + (*p - '0');
+	}
+	long long result = negative ? -(long long) value : (long long) value;
+	if (result < min)
+		return min;
+	if (result > max)
+		return max;
+	return result;
+}
+
+static void ParseValue(bool& val, const char* p, const char* end) {
+	p = SkipSpace(p, end);
+	val = p != end && *p == 'T' && (p + 1 == end || IsSpace(p[1]));
+}
+
+static void ParseValue(int& val, const char* p, const char* end) {
+	val = (int) ParseInteger(p, end, INT_MIN, INT_MAX);
+}
+
+static void ParseValue(uint8_t& val, const char* p, const char* end) {
+	val = (uint8_t) ParseInteger(p, end, INT_MIN, INT_MAX);
+}
+
+static void ParseValue(int16_t& val, const char* p, const char* end) {
+	val = (int16_t) ParseInteger(p, end, SHRT_MIN, SHRT_MAX);
+}
+
+static void ParseValue(uint32_t& val, const char* p, const char* end) {
+	// Negative values wrap around like in the C library
+	val = (uint32_t) ParseInteger(p, end, -(long long) UINT_MAX, UINT_MAX);
+}
+
+static void ParseValue(double& val, const char* p, const char* end) {
+	static const double powers_of_ten[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	const char* begin = p = SkipSpace(p, end);
+
+	// Fast path: Up to 15 significant digits and a small exponent are
+	// exactly representable, one multiplication or division rounds correctly.
+	bool negative = false;
+	if (p != end && (*p == '-' || *p == '+')) {
+		negative = *p == '-';
+		++p;
+	}
+	unsigned long long mantissa = 0;
+	int digits = 0;
+	int exponent = 0;
+	bool any_digit = false;
+	for (; p != end && IsDigit(*p); ++p) {
+		any_digit = true;
+		if (mantissa != 0 || *p != '0') {
+			mantissa = mantissa * 10 + (*p - '0');
+			++digits;
+		}
+	}
+	if (p != end && *p == '.') {
+		for (++p; p != end && IsDigit(*p); ++p) {
+			any_digit = true;
+			if (mantissa != 0 || *p != '0') {
+				mantissa = mantissa * 10 + (*p - '0');
+				++digits;
+			}
+			--exponent;
+		}
+	}
+	bool fast = any_digit && digits <= 15;
+	if (fast && p != end && (*p == 'e' || *p == 'E')) {
+		++p;
+		bool exp_negative = false;
+		if (p != end && (*p == '-' || *p == '+')) {
+			exp_negative = *p == '-';
+			++p;
+		}
+		int exp_value = 0;
+		fast = p != end && IsDigit(*p);
+		for (; p != end && IsDigit(*p); ++p) {
+			if (exp_value < 1000)
+				exp_value = exp_value * 10 + (*p - '0');
+		}
+		exponent += exp_negative ? -exp_value : exp_value;
+	}
+	if (fast && exponent >= -22 && exponent <= 22) {
+		double result = (double) mantissa;
+		if (exponent < 0)
+			result /= powers_of_ten[-exponent];
+		else
+			result *= powers_of_ten[exponent];
+		val = negative ? -result : result;
+		return;
+	}
+
+	std::istringstream s(std::string(begin, end));
+	s.imbue(std::locale::classic());
+	s >> val;
+}
+
 template <>
 void XmlReader::Read<bool>(bool& val, const std::string& data) {
-	std::istringstream s(data);
-	std::string str;
-	s >> str;
-	val = str == "T";
+	ParseValue(val, data.data(), data.data() + data.size());
 }
 
 template <>
 void XmlReader::Read<int>(int& val, const std::string& data) {
-	std::istringstream s(data);
-	s >> val;
+	ParseValue(val, data.data(), data.data() + data.size());
 }
 
 template <>
 void XmlReader::Read<uint8_t>(uint8_t& val, const std::string& data) {
-	std::istringstream s(data);
-	int x;
-	s >> x;
-	val = x;
+	ParseValue(val, data.data(), data.data() + data.size());
 }
 
 template <>
 void XmlReader::Read<int16_t>(int16_t& val, const std::string& data) {
-	std::istringstream s(data);
-	s >> val;
+	ParseValue(val, data.data(), data.data() + data.size());
 }
 
 template <>
 void XmlReader::Read<uint32_t>(uint32_t& val, const std::string& data) {
-	std::istringstream s(data);
-	s >> val;
+	ParseValue(val, data.data(), data.data() + data.size());
 }
 
 template <>
 void XmlReader::Read<double>(double& val, const std::string& data) {
-	std::istringstream s(data);
-	s >> val;
+	ParseValue(val, data.data(), data.data() + data.size());
 }
 
 template <>
@@ -182,49 +372,65 @@ void XmlReader::Read<std::string>(std::string& val, const std::string& data) {
 	}
 }
 
-template <class T>
-void XmlReader::ReadVector(std::vector<T>& val, const std::string& data) {
+template <class V>
+void XmlReader::ReadVector(V& val, const std::string& data) {
+	typedef typename V::value_type T;
+	const char* begin = data.data();
+	const char* end = begin + data.size();
+
+	// Count the tokens first to allocate only once
+	size_t count = 0;
+	bool in_token = false;
+	for (const char* p = begin; p != end; ++p) {
+		bool space = IsSpace(*p);
+		if (!space && !in_token)
+			++count;
+		in_token = !space;
+	}
+
 	val.clear();
-	std::istringstream s(data);
-	for (;;) {
-		std::string str;
-		s >> str;
-		if (!s.fail()) {
-			T x;
-			XmlReader::Read<T>(x, str);
-			val.push_back(x);
-		}
-		if (!s.good())
-			break;
+	val.reserve(count);
+	for (const char* p = SkipSpace(begin, end); p != end; p = SkipSpace(p, end)) {
+		const char* token = p;
+		while (p != end && !IsSpace(*p))
+			++p;
+		T x;
+		ParseValue(x, token, p);
+		val.push_back(x);
 	}
 }
 
 template <>
 void XmlReader::Read<std::vector<int> >(std::vector<int>& val, const std::string& data) {
-	ReadVector<int>(val, data);
+	ReadVector(val, data);
+}
+
+template <>
+void XmlReader::Read<SmallVector<int, 4> >(SmallVector<int, 4>& val, const std::string& data) {
+	ReadVector(val, data);
 }
 
 template <>
 void XmlReader::Read<std::vector<bool> >(std::vector<bool>& val, const std::string& data) {
-	ReadVector<bool>(val, data);
+	ReadVector(val, data);
 }
 
 template <>
 void XmlReader::Read<std::vector<uint8_t> >(std::vector<uint8_t>& val, const std::string& data) {
-	ReadVector<uint8_t>(val, data);
+	ReadVector(val, data);
 }
 
 template <>
 void XmlReader::Read<std::vector<int16_t> >(std::vector<int16_t>& val, const std::string& data) {
-	ReadVector<int16_t>(val, data);
+	ReadVector(val, data);
 }
 
 template <>
 void XmlReader::Read<std::vector<uint32_t> >(std::vector<uint32_t>& val, const std::string& data) {
-	ReadVector<uint32_t>(val, data);
+	ReadVector(val, data);
 }
 
 template <>
 void XmlReader::Read<std::vector<double> >(std::vector<double>& val, const std::string& data) {
-	ReadVector<double>(val, data);
+	ReadVector(val, data);
 }
@@ -10,12 +10,15 @@
 #include <string>
 #include <vector>
 #include <cstdio>
+#include <new>
+#include <utility>
 #if defined(LCF_SUPPORT_XML)
 #  include <expat.h>
 #endif
 #include "reader_types.h"
 #include "reader_options.h"
 #include "reader_util.h"
+#include "reader_mmap.h"
 
 /**
  * XmlHandler abstract base class (forward reference).
@@ -35,6 +38,15 @@ public:
 	 */
 	XmlReader(const std::string& filename);
 
+	/**
+	 * Constructs a new Reader over a memory buffer.
+	 * The buffer is not copied and must outlive the reader.
+	 *
+	 * @param data XML document.
+	 * @param size size of the document in bytes.
+	 */
+	XmlReader(const char* data, size_t size);
+
 	/**
 	 * Destructor. Closes the opened file.
 	 */
@@ -68,10 +80,37 @@ public:
 	void Parse();
 
 	/**
-	 * Changes the handler.
+	 * Sets how many bytes are passed to the parser at once.
+	 *
+	 * @param size slice size, 0 parses the document in one call.
+	 */
+	void SetChunkSize(size_t size);
+
+	/**
+	 * Changes the handler of the current element.
+	 *
+	 * Handlers created with MakeHandler are owned by the reader and
+	 * destroyed when the element ends. Any other handler stays owned by
+	 * the caller, which must keep it alive until the element ends and
+	 * destroy it afterwards.
 	 */
 	void SetHandler(XmlHandler* handler);
 
+	/**
+	 * Creates a handler in the handler pool of this reader.
+	 * The handler is destroyed and its memory reused when the
+	 * element it was installed for ends. A handler that is never
+	 * installed with SetHandler is not destroyed.
+	 *
+	 * @param args constructor arguments of the handler.
+	 * @return the new handler.
+	 */
+	template <class H, class... Args>
+	H* MakeHandler(Args&&... args) {
+		static_assert(sizeof(H) <= handler_size, "handler too large for the pool");
+		return new (AllocateHandler()) H(std::forward<Args>(args)...);
+	}
+
 	/**
 	 * Parses a primitive type.
 	 */
@@ -79,10 +118,10 @@ public:
 	static void Read(T& ref, const std::string& data);
 
 	/**
-	 * Parses a vector of primitive type.
+	 * Parses a vector of primitive type, a std::vector or SmallVector.
 	 */
-	template <class T>
-	static void ReadVector(std::vector<T>& ref, const std::string& data);
+	template <class V>
+	static void ReadVector(V& ref, const std::string& data);
 
 	/**
 	 * Start element callback.
@@ -100,10 +139,34 @@ public:
 	void EndElement(const char* name);
 
 protected:
+	/** Default bytes passed to the parser at once. */
+	static const size_t default_chunk_size = 1024 * 1024;
+	/** Size of a handler pool slot. */
+	static const size_t handler_size = 64;
+
+	/**
+	 * Takes a slot from the handler pool.
+	 */
+	void* AllocateHandler();
+
+	/**
+	 * Destroys a handler and returns its slot to the pool. Does nothing
+	 * for handlers not created by MakeHandler.
+	 */
+	void ReleaseHandler(XmlHandler* handler);
+
 	/** Name of the file that is associated with the stream. */
 	std::string filename;
-	/** File-stream managed by this Reader. */
-	FILE* stream;
+	/** Mapped file managed by this Reader. */
+	MappedFile file;
+	/** Document to parse. */
+	const char* data;
+	/** Size of the document. */
+	size_t size;
+	/** Whether the document is available. */
+	bool ok;
+	/** Bytes passed to the parser at once. */
+	size_t chunk_size;
 	/** Expat XML parser object. */
 #if defined(LCF_SUPPORT_XML)
 	XML_Parser parser;
@@ -114,6 +177,10 @@ protected:
 	int nesting;
 	/** Handler stack. */
 	std::vector<XmlHandler*> handlers;
+	/** Unused handler pool slots. */
+	std::vector<void*> free_handlers;
+	/** All handler pool slots, freed on destruction. */
+	std::vector<void*> handler_slots;
 	/** Text buffer. */
 	std::string buffer;
 
@@ -10,12 +10,19 @@
 #include "rpg_system.h"
 #include "rpg_save.h"
 #include "rpg_savemapinfo.h"
+#include "rpg_database.h"
 #include "data.h"
+#include "data_index.h"
 
 void RPG::SaveActor::Fixup(int actor_id) {
+	const RPG::Actor* actor = IDIndex<RPG::Actor>::Find(Data::actors, actor_id);
+	if (actor != NULL)
+		Fixup(*actor);
 	ID = actor_id;
+}
 
-	const RPG::Actor& actor = Data::actors[actor_id - 1];
+void RPG::SaveActor::Fixup(const RPG::Actor& actor) {
+	ID = actor.ID;
 
 	if (name == "\x1") {
 		name = actor.name;
@@ -53,16 +60,20 @@ void RPG::SaveMapEvent::Fixup(const RPG::EventPage& page) {
 }
 
 void RPG::SaveSystem::Fixup() {
-	const RPG::System& system = Data::system;
+	Fixup(Data::data);
+}
+
+void RPG::SaveSystem::Fixup(const RPG::Database& db) {
+	const RPG::System& system = db.system;
 
 	if (graphics_name.empty()) {
 		graphics_name = system.system_name;
 	}
-	if (switches.size() < Data::switches.size()) {
-		switches.resize(Data::switches.size());
+	if (switches.size() < db.switches.size()) {
+		switches.resize(db.switches.size());
 	}
-	if (variables.size() < Data::variables.size()) {
-		variables.resize(Data::variables.size());
+	if (variables.size() < db.variables.size()) {
+		variables.resize(db.variables.size());
 	}
 	if (battle_music.name.empty()) {
 		battle_music.name = system.battle_music.name;
@@ -13,10 +13,23 @@
 #include "rpg_save.h"
 #include "rpg_chipset.h"
 #include "rpg_parameters.h"
+#include "rpg_database.h"
 #include "data.h"
+#include "data_index.h"
 
 void RPG::SaveActor::Setup(int actor_id) {
-	const RPG::Actor& actor = Data::actors[actor_id - 1];
+	const RPG::Actor* actor = IDIndex<RPG::Actor>::Find(Data::actors, actor_id);
+	if (actor == NULL) {
+		// Not in the database, start from an actor with default values
+		RPG::Actor missing;
+		missing.ID = actor_id;
+		Setup(missing);
+		return;
+	}
+	Setup(*actor);
+}
+
+void RPG::SaveActor::Setup(const RPG::Actor& actor) {
 	ID = actor.ID;
 	name = actor.name;
 	title = actor.title;
@@ -56,7 +69,11 @@ void RPG::SaveActor::Setup(int actor_id) {
 }
 
 void RPG::SaveInventory::Setup() {
-	party = Data::system.party;
+	Setup(Data::system);
+}
+
+void RPG::SaveInventory::Setup(const RPG::System& system) {
+	party = system.party;
 	party_size = party.size();
 }
 
@@ -93,14 +110,18 @@ void RPG::SaveMapInfo::Setup(const RPG::MapInfo& map_info) {
 }
 
 void RPG::SaveSystem::Setup() {
-	const RPG::System& system = Data::system;
+	Setup(Data::data);
+}
+
+void RPG::SaveSystem::Setup(const RPG::Database& db) {
+	const RPG::System& system = db.system;
 	screen = 0;
 	frame_count = 0;
 	graphics_name = system.system_name;
-	switches_size = Data::switches.size();
+	switches_size = db.switches.size();
 	switches.clear();
 	switches.resize(switches_size);
-	variables_size = Data::variables.size();
+	variables_size = db.variables.size();
 	variables.clear();
 	variables.resize(variables_size);
 	face_name = "";
@@ -150,7 +171,11 @@ void RPG::SaveSystem::Setup() {
 }
 
 void RPG::Save::Setup() {
-	system.Setup();
+	Setup(Data::data);
+}
+
+void RPG::Save::Setup(const RPG::Database& db) {
+	system.Setup(db);
 	screen = RPG::SaveScreen();
 	pictures.clear();
 	pictures.resize(50);
@@ -158,14 +183,18 @@ void RPG::Save::Setup() {
 		pictures[i - 1].ID = i;
 	}
 	actors.clear();
-	actors.resize(Data::actors.size());
+	actors.resize(db.actors.size());
 	for (int i = 1; i <= (int) actors.size(); i++)
-		actors[i - 1].Setup(i);
+		actors[i - 1].Setup(db.actors[i - 1]);
 	map_info.Setup();
 }
 
 void RPG::Actor::Setup() {
-	if (Data::system.ldb_id == 2003) {
+	Setup(Data::system);
+}
+
+void RPG::Actor::Setup(const RPG::System& system) {
+	if (system.ldb_id == 2003) {
 		final_level = final_level == -1 ? 99 : final_level;
 		exp_base = exp_base == -1 ? 300 : exp_base;
 		exp_inflation = exp_inflation == -1 ? 300 : exp_inflation;
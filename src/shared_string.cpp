@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#include "shared_string.h"
+
+SharedString::SharedString(const std::string& str) : node(NULL) {
+	*this = str;
+}
+
+SharedString::SharedString(const char* str) : node(NULL) {
+	*this = str;
+}
+
+SharedString& SharedString::operator=(const SharedString& other) {
+	if (node != other.node) {
+		if (other.node != NULL)
+			other.node->refs++;
+		Release();
+		node = other.node;
+	}
+	return *this;
+}
+
+SharedString& SharedString::operator=(const std::string& str) {
+	if (str.empty()) {
+		Release();
+	} else if (node != NULL && node->refs == 1) {
+		node->str = str;
+	} else {
+		Release();
+		node = new Node();
+		node->refs = 1;
+		node->str = str;
+	}
+	return *this;
+}
+
+SharedString& SharedString::operator=(const char* str) {
+	return *this = std::string(str);
+}
+
+size_t SharedString::NodeSize() {
+	return sizeof(Node);
+}
+
+const std::string& SharedString::Empty() {
+	static const std::string empty;
+	return empty;
+}
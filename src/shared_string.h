@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#ifndef LCF_SHARED_STRING_H
+#define LCF_SHARED_STRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+/**
+ * Immutable string whose copies share one buffer.
+ *
+ * Used for the file name fields of the RPG structs, such as
+ * character_name, face_name, battler_name or Sound::name, which repeat
+ * thousands of times in a game. A copy only takes a reference, and
+ * strings read through a StringPool (see LcfReader::SetStringPool) share
+ * the buffer of every equal string read through that pool. The object is
+ * one pointer and the empty string needs no allocation.
+ *
+ * The value is read through str() or the conversion to const
+ * std::string&, and changed by assigning a new one.
+ */
+class SharedString {
+public:
+	SharedString() : node(NULL) {}
+	SharedString(const std::string& str);
+	SharedString(const char* str);
+
+	SharedString(const SharedString& other) : node(other.node) {
+		if (node != NULL)
+			node->refs++;
+	}
+
+	SharedString(SharedString&& other) noexcept : node(other.node) {
+		other.node = NULL;
+	}
+
+	~SharedString() {
+		Release();
+	}
+
+	SharedString& operator=(const SharedString& other);
+
+	SharedString& operator=(SharedString&& other) noexcept {
+		if (this != &other) {
+			Release();
+			node = other.node;
+			other.node = NULL;
+		}
+		return *this;
+	}
+
+	/**
+	 * Assigns a new value. A buffer not shared with other strings is
+	 * reused.
+	 */
+	SharedString& operator=(const std::string& str);
+	SharedString& operator=(const char* str);
+
+	const std::string& str() const {
+		return node != NULL ? node->str : Empty();
+	}
+
+	operator const std::string&() const {
+		return str();
+	}
+
+	const char* c_str() const { return str().c_str(); }
+	const char* data() const { return str().data(); }
+	size_t size() const { return node != NULL ? node->str.size() : 0; }
+	size_t length() const { return size(); }
+	bool empty() const { return node == NULL; }
+
+	void clear() {
+		Release();
+	}
+
+	/**
+	 * Returns how many strings share the buffer, 0 for the empty string.
+	 */
+	long UseCount() const {
+		return node != NULL ? (long) node->refs : 0;
+	}
+
+	/**
+	 * Returns whether two strings share their buffer.
+	 */
+	bool Shares(const SharedString& other) const {
+		return node != NULL && node == other.node;
+	}
+
+	/**
+	 * Bytes of the shared block besides the heap buffer of the string.
+	 */
+	static size_t NodeSize();
+
+private:
+	struct Node {
+		std::atomic<long> refs;
+		std::string str;
+	};
+
+	static const std::string& Empty();
+
+	void Release() {
+		if (node != NULL && --node->refs == 0)
+			delete node;
+		node = NULL;
+	}
+
+	Node* node;
+};
+
+inline bool operator==(const SharedString& a, const SharedString& b) {
+	return a.Shares(b) || a.str() == b.str();
+}
+
+inline bool operator==(const SharedString& a, const std::string& b) {
+	return a.str() == b;
+}
+
+inline bool operator==(const std::string& a, const SharedString& b) {
+	return a == b.str();
+}
+
+inline bool operator==(const SharedString& a, const char* b) {
+	return a.str() == b;
+}
+
+inline bool operator==(const char* a, const SharedString& b) {
+	return a == b.str();
+}
+
+template <class T>
+inline bool operator!=(const SharedString& a, const T& b) {
+	return !(a == b);
+}
+
+inline bool operator!=(const std::string& a, const SharedString& b) {
+	return !(a == b);
+}
+
+inline bool operator!=(const char* a, const SharedString& b) {
+	return !(a == b);
+}
+
+inline bool operator<(const SharedString& a, const SharedString& b) {
+	return a.str() < b.str();
+}
+
+inline std::ostream& operator<<(std::ostream& os, const SharedString& str) {
+	return os << str.str();
+}
+
+#endif
@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#ifndef LCF_SMALL_VECTOR_H
+#define LCF_SMALL_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "reader_types.h"
+
+/**
+ * Vector of trivial values that keeps up to N of them inside the object.
+ *
+ * Only longer contents are allocated on the heap. The interface is the
+ * one of std::vector and iterators are plain pointers. A std::vector
+ * converts to it implicitly, the other way is an explicit ToVector.
+ */
+template <class T, size_t N>
+class SmallVector {
+	static_assert(std::is_trivial<T>::value, "SmallVector only holds trivial types");
+	static_assert(N > 0, "SmallVector needs inline space");
+
+	template <class It>
+	using EnableIfIterator = typename std::enable_if<!std::is_integral<It>::value>::type;
+
+public:
+	typedef T value_type;
+	typedef size_t size_type;
+	typedef ptrdiff_t difference_type;
+	typedef T& reference;
+	typedef const T& const_reference;
+	typedef T* pointer;
+	typedef const T* const_pointer;
+	typedef T* iterator;
+	typedef const T* const_iterator;
+	typedef std::reverse_iterator<iterator> reverse_iterator;
+	typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+	SmallVector() : count(0), cap(N) {}
+
+	explicit SmallVector(size_type n) : count(0), cap(N) {
+		resize(n);
+	}
+
+	SmallVector(size_type n, const T& val) : count(0), cap(N) {
+		assign(n, val);
+	}
+
+	template <class It, class = EnableIfIterator<It> >
+	SmallVector(It first, It last) : count(0), cap(N) {
+		assign(first, last);
+	}
+
+	SmallVector(std::initializer_list<T> list) : count(0), cap(N) {
+		assign(list.begin(), list.end());
+	}
+
+	SmallVector(const std::vector<T>& vec) : count(0), cap(N) {
+		assign(vec.begin(), vec.end());
+	}
+
+	SmallVector(const SmallVector& other) : count(0), cap(N) {
+		assign(other.begin(), other.end());
+	}
+
+	SmallVector(SmallVector&& other) noexcept : count(0), cap(N) {
+		Steal(other);
+	}
+
+	~SmallVector() {
+		Release();
+	}
+
+	SmallVector& operator=(const SmallVector& other) {
+		if (this != &other)
+			assign(other.begin(), other.end());
+		return *this;
+	}
+
+	SmallVector& operator=(SmallVector&& other) noexcept {
+		if (this != &other) {
+			Release();
+			count = 0;
+			cap = N;
+			Steal(other);
+		}
+		return *this;
+	}
+
+	SmallVector& operator=(std::initializer_list<T> list) {
+		assign(list.begin(), list.end());
+		return *this;
+	}
+
+	/**
+	 * Returns a heap allocated copy as std::vector. Named rather than a
+	 * conversion so the copy is visible where it is made.
+	 */
+	std::vector<T> ToVector() const {
+		return std::vector<T>(begin(), end());
+	}
+
+	void assign(size_type n, const T& val) {
+		T copy = val;
+		clear();
+		resize(n, copy);
+	}
+
+	template <class It, class = EnableIfIterator<It> >
+	void assign(It first, It last) {
+		clear();
+		insert(end(), first, last);
+	}
+
+	void assign(std::initializer_list<T> list) {
+		assign(list.begin(), list.end());
+	}
+
+	reference at(size_type pos) {
+		if (pos >= count)
+			throw std::out_of_range("SmallVector::at");
+		return data()[pos];
+	}
+
+	const_reference at(size_type pos) const {
+		if (pos >= count)
+			throw std::out_of_range("SmallVector::at");
+		return data()[pos];
+	}
+
+	reference operator[](size_type pos) { return data()[pos]; }
+	const_reference operator[](size_type pos) const { return data()[pos]; }
+	reference front() { return data()[0]; }
+	const_reference front() const { return data()[0]; }
+	reference back() { return data()[count - 1]; }
+	const_reference back() const { return data()[count - 1]; }
+
+	T* data() { return IsInline() ? storage.local : storage.heap; }
+	const T* data() const { return IsInline() ? storage.local : storage.heap; }
+
+	iterator begin() { return data(); }
+	const_iterator begin() const { return data(); }
+	const_iterator cbegin() const { return data(); }
+	iterator end() { return data() + count; }
+	const_iterator end() const { return data() + count; }
+	const_iterator cend() const { return data() + count; }
+	reverse_iterator rbegin() { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+	reverse_iterator rend() { return reverse_iterator(begin()); }
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+	bool empty() const { return count == 0; }
+	size_type size() const { return count; }
+	size_type max_size() const { return 0xFFFFFFFFU / sizeof(T); }
+	size_type capacity() const { return cap; }
+
+	/**
+	 * Checks if the contents are stored inside the object.
+	 */
+	bool IsInline() const { return cap <= N; }
+
+	void reserve(size_type n) {
+		if (n > cap)
+			Reallocate(n);
+	}
+
+	void shrink_to_fit() {
+		if (!IsInline() && count < cap)
+			Reallocate(count);
+	}
+
+	void clear() {
+		count = 0;
+	}
+
+	iterator insert(const_iterator pos, const T& val) {
+		return insert(pos, 1, val);
+	}
+
+	iterator insert(const_iterator pos, size_type n, const T& val) {
+		T copy = val;
+		iterator it = Open(pos, n);
+		std::fill(it, it + n, copy);
+		return it;
+	}
+
+	template <class It, class = EnableIfIterator<It> >
+	iterator insert(const_iterator pos, It first, It last) {
+		typename std::iterator_traits<It>::iterator_category category;
+		return InsertRange(pos, first, last, category);
+	}
+
+	iterator insert(const_iterator pos, std::initializer_list<T> list) {
+		return insert(pos, list.begin(), list.end());
+	}
+
+	iterator erase(const_iterator pos) {
+		return erase(pos, pos + 1);
+	}
+
+	iterator erase(const_iterator first, const_iterator last) {
+		iterator it = begin() + (first - begin());
+		size_type n = last - first;
+		if (n > 0) {
+			memmove(it, it + n, (end() - (it + n)) * sizeof(T));
+			count -= (uint32_t) n;
+		}
+		return it;
+	}
+
+	void push_back(const T& val) {
+		if (count == cap) {
+			T copy = val;
+			Reallocate(cap * 2);
+			data()[count++] = copy;
+		} else {
+			data()[count++] = val;
+		}
+	}
+
+	template <class... Args>
+	reference emplace_back(Args&&... args) {
+		push_back(T(std::forward<Args>(args)...));
+		return back();
+	}
+
+	void pop_back() {
+		count--;
+	}
+
+	void resize(size_type n) {
+		resize(n, T());
+	}
+
+	void resize(size_type n, const T& val) {
+		if (n > count) {
+			T copy = val;
+			reserve(n);
+			std::fill(data() + count, data() + n, copy);
+		}
+		count = (uint32_t) n;
+	}
+
+	void swap(SmallVector& other) {
+		SmallVector tmp(std::move(other));
+		other = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+private:
+	void Release() {
+		if (!IsInline())
+			::operator delete(storage.heap);
+	}
+
+	/** Takes the contents of other and leaves it empty. */
+	void Steal(SmallVector& other) {
+		if (other.IsInline()) {
+			memcpy(storage.local, other.storage.local, other.count * sizeof(T));
+		} else {
+			storage.heap = other.storage.heap;
+			cap = other.cap;
+		}
+		count = other.count;
+		other.count = 0;
+		other.cap = N;
+	}
+
+	/** Moves the contents to a buffer of n values, inline if they fit. */
+	void Reallocate(size_type n) {
+		if (n < count)
+			n = count;
+		if (n <= N && IsInline())
+			return;
+		T* old = data();
+		bool old_inline = IsInline();
+		if (n <= N) {
+			T* heap = storage.heap;
+			memcpy(storage.local, heap, count * sizeof(T));
+			::operator delete(heap);
+			cap = N;
+			return;
+		}
+		T* buffer = static_cast<T*>(::operator new(n * sizeof(T)));
+		memcpy(buffer, old, count * sizeof(T));
+		if (!old_inline)
+			::operator delete(old);
+		storage.heap = buffer;
+		cap = (uint32_t) n;
+	}
+
+	/** Makes room for n values at pos and returns their position. */
+	iterator Open(const_iterator pos, size_type n) {
+		size_type index = pos - begin();
+		if (count + n > cap)
+			Reallocate(std::max<size_type>(count + n, (size_type) cap * 2));
+		iterator it = begin() + index;
+		memmove(it + n, it, (count - index) * sizeof(T));
+		count += (uint32_t) n;
+		return it;
+	}
+
+	template <class It>
+	iterator InsertRange(const_iterator pos, It first, It last, std::input_iterator_tag) {
+		std::vector<T> values(first, last);
+		return InsertRange(pos, values.begin(), values.end(), std::forward_iterator_tag());
+	}
+
+	template <class It>
+	iterator InsertRange(const_iterator pos, It first, It last, std::forward_iterator_tag) {
+		// Open invalidates pointers into this vector, copy them first
+		if (Contains(first)) {
+			std::vector<T> values(first, last);
+			return InsertRange(pos, values.begin(), values.end(), std::forward_iterator_tag());
+		}
+		iterator it = Open(pos, std::distance(first, last));
+		std::copy(first, last, it);
+		return it;
+	}
+
+	template <class It>
+	bool Contains(It) const { return false; }
+	bool Contains(T* p) const { return p >= begin() && p < end(); }
+	bool Contains(const T* p) const { return p >= begin() && p < end(); }
+
+	uint32_t count;
+	uint32_t cap;
+	union {
+		T* heap;
+		T local[N];
+	} storage;
+};
+
+template <class T, size_t N>
+bool operator==(const SmallVector<T, N>& a, const SmallVector<T, N>& b) {
+	return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+template <class T, size_t N>
+bool operator!=(const SmallVector<T, N>& a, const SmallVector<T, N>& b) {
+	return !(a == b);
+}
+
+template <class T, size_t N>
+bool operator<(const SmallVector<T, N>& a, const SmallVector<T, N>& b) {
+	return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+}
+
+template <class T, size_t N>
+bool operator>(const SmallVector<T, N>& a, const SmallVector<T, N>& b) {
+	return b < a;
+}
+
+template <class T, size_t N>
+bool operator<=(const SmallVector<T, N>& a, const SmallVector<T, N>& b) {
+	return !(b < a);
+}
+
+template <class T, size_t N>
+bool operator>=(const SmallVector<T, N>& a, const SmallVector<T, N>& b) {
+	return !(a < b);
+}
+
+#endif
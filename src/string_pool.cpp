@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#include "string_pool.h"
+#include "reader_util.h"
+
+/**
+ * Returns the heap bytes of a string, 0 when it is stored inside the
+ * string object.
+ */
+static size_t HeapBytes(const std::string& str) {
+	const char* data = str.data();
+	if (data >= (const char*) &str && data < (const char*) (&str + 1))
+		return 0;
+	return str.capacity() + 1;
+}
+
+StringPool::StringPool() {
+	Clear();
+}
+
+const SharedString& StringPool::Intern(const std::string& raw, const std::string& encoding) {
+	if (encoding != this->encoding) {
+		table.clear();
+		this->encoding = encoding;
+	}
+	std::unordered_map<std::string, SharedString>::iterator it = table.find(raw);
+	if (it == table.end()) {
+		it = table.emplace(raw, SharedString(ReaderUtil::Recode(raw, encoding, "UTF-8"))).first;
+		stats.distinct++;
+		stats.distinct_bytes += it->second.size();
+	} else {
+		stats.saved_bytes += SharedString::NodeSize() + HeapBytes(it->second.str());
+	}
+	stats.strings++;
+	stats.bytes += it->second.size();
+	return it->second;
+}
+
+StringPool::Stats StringPool::GetStats() const {
+	typedef std::unordered_map<std::string, SharedString> Table;
+	// A node holds the key and value pair, the next pointer and the hash
+	const size_t node_size = sizeof(Table::value_type) + sizeof(void*) + sizeof(size_t);
+
+	Stats result = stats;
+	result.pool_bytes = 0;
+	if (!table.empty())
+		result.pool_bytes += table.bucket_count() * sizeof(void*) + table.size() * node_size;
+	for (Table::const_iterator it = table.begin(); it != table.end(); ++it)
+		result.pool_bytes += HeapBytes(it->first);
+	return result;
+}
+
+void StringPool::Clear() {
+	// Swapped to free the buckets too
+	std::unordered_map<std::string, SharedString>().swap(table);
+	stats.strings = 0;
+	stats.bytes = 0;
+	stats.distinct = 0;
+	stats.distinct_bytes = 0;
+	stats.saved_bytes = 0;
+	stats.pool_bytes = 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#ifndef LCF_STRING_POOL_H
+#define LCF_STRING_POOL_H
+
+#include <string>
+#include <unordered_map>
+#include "reader_types.h"
+#include "shared_string.h"
+
+/**
+ * Shares equal file name strings read by LcfReader.
+ *
+ * File names such as character, face, battler, sound and music names are
+ * SharedString fields and repeat thousands of times in a game. When a
+ * pool is set with LcfReader::SetStringPool, such a field is looked up by
+ * its bytes in the file. A string seen before is not converted again and
+ * the field shares its buffer with all equal ones.
+ *
+ * The strings stay alive as long as a field refers to them, so the pool
+ * can be cleared after loading to free its table, the fields keep
+ * sharing. Other string fields are not affected.
+ *
+ * A pool holds strings of one encoding, reading with another one clears
+ * its table. A pool is not thread safe, use one per thread.
+ */
+class StringPool {
+public:
+	struct Stats {
+		/** Strings read through the pool. */
+		size_t strings;
+		/** Bytes of these strings. */
+		size_t bytes;
+		/** Distinct strings stored in the pool. */
+		size_t distinct;
+		/** Bytes of the distinct strings. */
+		size_t distinct_bytes;
+		/**
+		 * Heap bytes the repeated strings did not allocate because they
+		 * share the buffer of a stored one, without allocator overhead.
+		 */
+		size_t saved_bytes;
+		/**
+		 * Heap bytes of the pool table itself, freed by Clear. Counts
+		 * the buckets, nodes and file bytes of the stored strings, not
+		 * the shared buffers.
+		 */
+		size_t pool_bytes;
+	};
+
+	StringPool();
+
+	/**
+	 * Returns the shared string for a string from a file, converting
+	 * and storing it if it is new.
+	 *
+	 * @param raw bytes of the string in the file.
+	 * @param encoding encoding of the file.
+	 */
+	const SharedString& Intern(const std::string& raw, const std::string& encoding);
+
+	Stats GetStats() const;
+
+	/**
+	 * Removes all strings from the table and resets the statistics.
+	 * Fields keep the strings they share.
+	 */
+	void Clear();
+
+private:
+	/** Shared strings by their bytes in the file. */
+	std::unordered_map<std::string, SharedString> table;
+	/** Encoding of the strings in the table. */
+	std::string encoding;
+	Stats stats;
+};
+
+#endif
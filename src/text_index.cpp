@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include "reader_lcf.h"
+#include "reader_mmap.h"
+#include "reader_struct.h"
+#include "text_index.h"
+#include "writer_lcf.h"
+
+typedef RPG::EventCommand::Code Code;
+
+// File layout: magic, version, number of segments, then per segment the
+// map ID, the entries (fields as compressed integers, text as length and
+// bytes) and the keys, offsets and ids arrays, each with its length.
+
+static const char text_magic[8] = { 'L', 'c', 'f', 'T', 'e', 'x', 't', 0 };
+
+/**
+ * Index format version. Increase when the layout changes or other
+ * strings are indexed, old indices are then rebuilt.
+ */
+static const uint32_t text_version = 1;
+
+static unsigned char Fold(char ch) {
+	unsigned char c = (unsigned char) ch;
+	return (c >= 'A' && c <= 'Z') ? (unsigned char) (c - 'A' + 'a') : c;
+}
+
+static uint32_t Trigram(const std::string& text, size_t pos) {
+	return ((uint32_t) Fold(text[pos]) << 16) | ((uint32_t) Fold(text[pos + 1]) << 8) | Fold(text[pos + 2]);
+}
+
+static bool IsWordChar(char ch) {
+	unsigned char c = (unsigned char) ch;
+	return c >= 0x80 || (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+}
+
+/**
+ * Checks if text contains needle, ignoring ASCII case. With word set
+ * the match must not be part of a longer word.
+ */
+static bool Contains(const std::string& text, const std::string& needle, bool word) {
+	if (needle.size() > text.size())
+		return false;
+	for (size_t i = 0; i + needle.size() <= text.size(); i++) {
+		size_t j = 0;
+		while (j < needle.size() && Fold(text[i + j]) == Fold(needle[j]))
+			j++;
+		if (j < needle.size())
+			continue;
+		if (!word)
+			return true;
+		size_t end = i + needle.size();
+		if ((i == 0 || !IsWordChar(text[i - 1])) && (end == text.size() || !IsWordChar(text[end])))
+			return true;
+	}
+	return false;
+}
+
+static void AddEntry(std::vector<TextIndex::Entry>& entries, int source, int map_id, int event_id, int page_id, int position, const std::string& text) {
+	if (text.empty())
+		return;
+	TextIndex::Entry entry;
+	entry.source = source;
+	entry.map_id = map_id;
+	entry.event_id = event_id;
+	entry.page_id = page_id;
+	entry.position = position;
+	entry.text = text;
+	entries.push_back(entry);
+}
+
+static void CollectCommands(std::vector<TextIndex::Entry>& entries, int source, int map_id, int event_id, int page_id, const std::vector<RPG::EventCommand>& commands) {
+	for (size_t i = 0; i < commands.size(); i++) {
+		const RPG::EventCommand& com = commands[i];
+		switch (com.code) {
+			case Code::ShowMessage:
+			case Code::ShowMessage_2:
+			case Code::ShowChoiceOption:
+				AddEntry(entries, source, map_id, event_id, page_id, (int) i, com.string);
+				break;
+		}
+	}
+}
+
+/**
+ * Adds the name (chunk 0x01) and description (chunk 0x02) of items and
+ * skills.
+ */
+template <class T>
+static void CollectDescriptions(std::vector<TextIndex::Entry>& entries, int source, const std::vector<T>& list) {
+	for (size_t i = 0; i < list.size(); i++) {
+		AddEntry(entries, source, 0, list[i].ID, 0, 0x01, list[i].name);
+		AddEntry(entries, source, 0, list[i].ID, 0, 0x02, list[i].description);
+	}
+}
+
+TextIndex::TextIndex() {
+}
+
+void TextIndex::Collect(const RPG::Database& db, std::vector<Entry>& entries) {
+	std::vector<std::pair<int, const std::string*> > terms;
+	Struct<RPG::Terms>::GetStrings(db.terms, terms);
+	for (size_t i = 0; i < terms.size(); i++)
+		AddEntry(entries, Source_terms, 0, 0, 0, terms[i].first, *terms[i].second);
+
+	CollectDescriptions(entries, Source_item, db.items);
+	CollectDescriptions(entries, Source_skill, db.skills);
+
+	for (size_t i = 0; i < db.commonevents.size(); i++) {
+		const RPG::CommonEvent& event = db.commonevents[i];
+		CollectCommands(entries, Source_common_event, 0, event.ID, 0, event.event_commands);
+	}
+	for (size_t i = 0; i < db.troops.size(); i++) {
+		const RPG::Troop& troop = db.troops[i];
+		for (size_t j = 0; j < troop.pages.size(); j++)
+			CollectCommands(entries, Source_troop, 0, troop.ID, troop.pages[j].ID, troop.pages[j].event_commands);
+	}
+}
+
+void TextIndex::Collect(int map_id, const RPG::Map& map, std::vector<Entry>& entries) {
+	for (size_t i = 0; i < map.events.size(); i++) {
+		const RPG::Event& event = map.events[i];
+		for (size_t j = 0; j < event.pages.size(); j++)
+			CollectCommands(entries, Source_map_event, map_id, event.ID, event.pages[j].ID, event.pages[j].event_commands);
+	}
+}
+
+void TextIndex::SetDatabase(const RPG::Database& db) {
+	std::vector<Entry> entries;
+	Collect(db, entries);
+	SetEntries(0, entries);
+}
+
+void TextIndex::SetMap(int map_id, const RPG::Map& map) {
+	std::vector<Entry> entries;
+	Collect(map_id, map, entries);
+	SetEntries(map_id, entries);
+}
+
+void TextIndex::SetEntries(int map_id, const std::vector<Entry>& entries) {
+	Segment& segment = files[map_id];
+	segment.entries = entries;
+	for (size_t i = 0; i < segment.entries.size(); i++)
+		segment.entries[i].map_id = map_id;
+	BuildPostings(segment);
+}
+
+void TextIndex::RemoveMap(int map_id) {
+	files.erase(map_id);
+}
+
+void TextIndex::Clear() {
+	files.clear();
+}
+
+void TextIndex::BuildPostings(Segment& segment) {
+	std::vector<std::pair<uint32_t, uint32_t> > pairs;
+	for (size_t i = 0; i < segment.entries.size(); i++) {
+		const std::string& text = segment.entries[i].text;
+		for (size_t pos = 0; pos + 3 <= text.size(); pos++)
+			pairs.push_back(std::make_pair(Trigram(text, pos), (uint32_t) i));
+	}
+	std::sort(pairs.begin(), pairs.end());
+	pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+	segment.keys.clear();
+	segment.offsets.clear();
+	segment.ids.clear();
+	segment.ids.reserve(pairs.size());
+	for (size_t i = 0; i < pairs.size(); i++) {
+		if (segment.keys.empty() || segment.keys.back() != pairs[i].first) {
+			segment.keys.push_back(pairs[i].first);
+			segment.offsets.push_back((uint32_t) i);
+		}
+		segment.ids.push_back(pairs[i].second);
+	}
+	segment.offsets.push_back((uint32_t) pairs.size());
+}
+
+void TextIndex::Find(const Segment& segment, const std::string& text, bool word, std::vector<const Entry*>& results) {
+	// Texts shorter than a trigram are checked against every string
+	if (text.size() < 3) {
+		for (size_t i = 0; i < segment.entries.size(); i++) {
+			if (Contains(segment.entries[i].text, text, word))
+				results.push_back(&segment.entries[i]);
+		}
+		return;
+	}
+
+	// Postings of every distinct trigram, shortest first
+	std::vector<std::pair<uint32_t, uint32_t> > ranges;
+	for (size_t pos = 0; pos + 3 <= text.size(); pos++) {
+		uint32_t key = Trigram(text, pos);
+		std::vector<uint32_t>::const_iterator it = std::lower_bound(segment.keys.begin(), segment.keys.end(), key);
+		if (it == segment.keys.end() || *it != key)
+			return;
+		size_t k = it - segment.keys.begin();
+		ranges.push_back(std::make_pair(segment.offsets[k + 1] - segment.offsets[k], segment.offsets[k]));
+	}
+	std::sort(ranges.begin(), ranges.end());
+	ranges.erase(std::unique(ranges.begin(), ranges.end()), ranges.end());
+
+	const uint32_t* first = &segment.ids[ranges[0].second];
+	std::vector<uint32_t> candidates(first, first + ranges[0].first);
+	std::vector<uint32_t> common;
+	for (size_t r = 1; r < ranges.size() && !candidates.empty(); r++) {
+		const uint32_t* begin = &segment.ids[ranges[r].second];
+		common.clear();
+		std::set_intersection(candidates.begin(), candidates.end(), begin, begin + ranges[r].first,
+			std::back_inserter(common));
+		candidates.swap(common);
+	}
+
+	for (size_t i = 0; i < candidates.size(); i++) {
+		const Entry& entry = segment.entries[candidates[i]];
+		if (Contains(entry.text, text, word))
+			results.push_back(&entry);
+	}
+}
+
+void TextIndex::Find(const std::string& text, std::vector<const Entry*>& results) const {
+	std::map<int, Segment>::const_iterator it;
+	for (it = files.begin(); it != files.end(); ++it)
+		Find(it->second, text, false, results);
+}
+
+void TextIndex::FindWord(const std::string& word, std::vector<const Entry*>& results) const {
+	std::map<int, Segment>::const_iterator it;
+	for (it = files.begin(); it != files.end(); ++it)
+		Find(it->second, word, true, results);
+}
+
+const std::vector<TextIndex::Entry>& TextIndex::GetEntries(int map_id) const {
+	static const std::vector<Entry> empty;
+	std::map<int, Segment>::const_iterator it = files.find(map_id);
+	return it == files.end() ? empty : it->second.entries;
+}
+
+static void WriteArray(LcfWriter& writer, const std::vector<uint32_t>& values) {
+	writer.Write<int>((int) values.size());
+	for (size_t i = 0; i < values.size(); i++)
+		writer.Write<int>((int) values[i]);
+}
+
+static void ReadArray(LcfReader& reader, std::vector<uint32_t>& values) {
+	int size = reader.ReadInt();
+	values.clear();
+	for (int i = 0; i < size && !reader.Eof(); i++)
+		values.push_back((uint32_t) reader.ReadInt());
+}
+
+bool TextIndex::Save(const std::string& filename) const {
+	LcfWriter writer(filename, "");
+	if (!writer.IsOk()) {
+		LcfReader::SetError("Couldn't open %s index file.\n", filename.c_str());
+		return false;
+	}
+	writer.Write(text_magic, 1, sizeof(text_magic));
+	writer.Write<uint32_t>(text_version);
+	writer.Write<int>((int) files.size());
+	std::map<int, Segment>::const_iterator it;
+	for (it = files.begin(); it != files.end(); ++it) {
+		const Segment& segment = it->second;
+		writer.Write<int>(it->first);
+		writer.Write<int>((int) segment.entries.size());
+		for (size_t i = 0; i < segment.entries.size(); i++) {
+			const Entry& entry = segment.entries[i];
+			writer.Write<int>(entry.source);
+			writer.Write<int>(entry.event_id);
+			writer.Write<int>(entry.page_id);
+			writer.Write<int>(entry.position);
+			writer.Write<int>((int) entry.text.size());
+			writer.Write(entry.text.data(), 1, entry.text.size());
+		}
+		WriteArray(writer, segment.keys);
+		WriteArray(writer, segment.offsets);
+		WriteArray(writer, segment.ids);
+	}
+	return true;
+}
+
+/**
+ * Checks that loaded postings only refer to existing entries.
+ */
+static bool IsConsistent(const std::vector<uint32_t>& keys, const std::vector<uint32_t>& offsets,
+		const std::vector<uint32_t>& ids, size_t entries) {
+	if (offsets.size() != keys.size() + 1 || offsets.front() != 0 || offsets.back() != ids.size())
+		return false;
+	for (size_t i = 0; i < keys.size(); i++) {
+		if (offsets[i] > offsets[i + 1] || (i > 0 && keys[i - 1] >= keys[i]))
+			return false;
+	}
+	for (size_t i = 0; i < ids.size(); i++) {
+		if (ids[i] >= entries)
+			return false;
+	}
+	return true;
+}
+
+bool TextIndex::Load(const std::string& filename) {
+	MappedFile file;
+	if (!file.Open(filename)) {
+		LcfReader::SetError("Couldn't find %s index file.\n", filename.c_str());
+		return false;
+	}
+	LcfReader reader(file.Data(), file.Size());
+	char magic[sizeof(text_magic)];
+	uint32_t version = 0;
+	if (reader.Read0(magic, 1, sizeof(magic)) != sizeof(magic) ||
+		memcmp(magic, text_magic, sizeof(magic)) != 0) {
+		LcfReader::SetError("%s is not a valid index file.\n", filename.c_str());
+		return false;
+	}
+	reader.Read(version);
+	if (version != text_version) {
+		LcfReader::SetError("%s is an index of a different version.\n", filename.c_str());
+		return false;
+	}
+
+	Clear();
+	int count = reader.ReadInt();
+	for (int i = 0; i < count && !reader.Eof(); i++) {
+		int map_id = reader.ReadInt();
+		Segment& segment = files[map_id];
+		int size = reader.ReadInt();
+		for (int j = 0; j < size && !reader.Eof(); j++) {
+			Entry entry;
+			entry.source = reader.ReadInt();
+			entry.map_id = map_id;
+			entry.event_id = reader.ReadInt();
+			entry.page_id = reader.ReadInt();
+			entry.position = reader.ReadInt();
+			int length = reader.ReadInt();
+			if (length < 0 || (size_t) length > file.Size() - reader.Tell()) {
+				LcfReader::SetError("%s is corrupted.\n", filename.c_str());
+				Clear();
+				return false;
+			}
+			entry.text.resize(length);
+			if (length > 0)
+				reader.Read0(&entry.text[0], 1, length);
+			segment.entries.push_back(entry);
+		}
+		ReadArray(reader, segment.keys);
+		ReadArray(reader, segment.offsets);
+		ReadArray(reader, segment.ids);
+		if (!IsConsistent(segment.keys, segment.offsets, segment.ids, segment.entries.size())) {
+			LcfReader::SetError("%s is corrupted.\n", filename.c_str());
+			Clear();
+			return false;
+		}
+	}
+	if (reader.Eof()) {
+		LcfReader::SetError("%s is truncated.\n", filename.c_str());
+		Clear();
+		return false;
+	}
+	return true;
+}
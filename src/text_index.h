@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#ifndef LCF_TEXT_INDEX_H
+#define LCF_TEXT_INDEX_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "reader_types.h"
+#include "rpg_database.h"
+#include "rpg_map.h"
+
+/**
+ * Searches the text shown to the player.
+ *
+ * The index holds the strings of ShowMessage, ShowMessage_2 and
+ * ShowChoiceOption commands of map events, common events and troop
+ * pages, all terms and the names and descriptions of items and skills.
+ *
+ * Every file, the database with map ID 0 and the maps with their own
+ * ID, has its own segment: its strings and, for every three byte
+ * sequence, the strings containing it. A search only checks the strings
+ * containing all sequences of the searched text. A saved file is
+ * indexed again on its own with SetMap.
+ *
+ * Searches ignore the case of ASCII letters.
+ */
+class TextIndex {
+public:
+	enum Source {
+		Source_map_event = 0,
+		Source_common_event = 1,
+		Source_troop = 2,
+		Source_terms = 3,
+		Source_item = 4,
+		Source_skill = 5
+	};
+
+	/**
+	 * One indexed string and where it is.
+	 */
+	struct Entry {
+		int source;
+		/** ID of the map, 0 for the database. */
+		int map_id;
+		/** ID of the map event, common event, troop, item or skill. */
+		int event_id;
+		/** ID of the page, 0 when there are no pages. */
+		int page_id;
+		/**
+		 * Position of the command for events, LCF chunk ID of the field
+		 * for terms, items and skills.
+		 */
+		int position;
+		std::string text;
+	};
+
+	TextIndex();
+
+	/**
+	 * Collects the strings of a database.
+	 */
+	static void Collect(const RPG::Database& db, std::vector<Entry>& entries);
+
+	/**
+	 * Collects the strings of the events of a map.
+	 */
+	static void Collect(int map_id, const RPG::Map& map, std::vector<Entry>& entries);
+
+	/**
+	 * Replaces the segment of the database.
+	 */
+	void SetDatabase(const RPG::Database& db);
+
+	/**
+	 * Replaces the segment of a map.
+	 */
+	void SetMap(int map_id, const RPG::Map& map);
+
+	/**
+	 * Replaces the segment of a file with collected strings.
+	 *
+	 * @param map_id ID of the map, 0 for the database.
+	 * @param entries strings, their map_id is ignored.
+	 */
+	void SetEntries(int map_id, const std::vector<Entry>& entries);
+
+	/**
+	 * Removes the segment of a map, 0 for the database.
+	 */
+	void RemoveMap(int map_id);
+
+	void Clear();
+
+	/**
+	 * Finds the strings containing a text.
+	 *
+	 * @param text text to search.
+	 * @param results receives the strings, by map ID and then in file
+	 *                order. They stay valid until the index changes.
+	 */
+	void Find(const std::string& text, std::vector<const Entry*>& results) const;
+
+	/**
+	 * Finds the strings containing a text as a whole word, not
+	 * directly preceded or followed by a letter, digit or non-ASCII
+	 * character.
+	 */
+	void FindWord(const std::string& word, std::vector<const Entry*>& results) const;
+
+	/**
+	 * Returns the strings of a file, empty if it was not indexed.
+	 */
+	const std::vector<Entry>& GetEntries(int map_id) const;
+
+	/**
+	 * Saves the index to a file.
+	 */
+	bool Save(const std::string& filename) const;
+
+	/**
+	 * Loads an index saved with Save, replacing the current one.
+	 */
+	bool Load(const std::string& filename);
+
+private:
+	/** Strings of one file and their trigram postings. */
+	struct Segment {
+		std::vector<Entry> entries;
+		/** Sorted trigrams. */
+		std::vector<uint32_t> keys;
+		/** Start of the postings of each key in ids, one more than keys. */
+		std::vector<uint32_t> offsets;
+		/** Positions in entries, sorted per key. */
+		std::vector<uint32_t> ids;
+	};
+
+	static void BuildPostings(Segment& segment);
+	static void Find(const Segment& segment, const std::string& text, bool word, std::vector<const Entry*>& results);
+
+	std::map<int, Segment> files;
+};
+
+#endif
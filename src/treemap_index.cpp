@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <climits>
+#include <unordered_set>
+#include <utility>
+#include "treemap_index.h"
+
+TreeMapIndex::TreeMapIndex() : treemap(NULL) {
+}
+
+TreeMapIndex::TreeMapIndex(RPG::TreeMap& treemap) : treemap(NULL) {
+	Build(treemap);
+}
+
+void TreeMapIndex::Build(RPG::TreeMap& treemap) {
+	this->treemap = &treemap;
+	Reindex();
+}
+
+void TreeMapIndex::Reindex() {
+	const std::vector<RPG::MapInfo>& maps = treemap->maps;
+	const int count = (int) maps.size();
+
+	positions.clear();
+	for (int i = 0; i < count; i++)
+		positions.insert(std::make_pair(maps[i].ID, i));
+
+	nodes.assign(count, Node());
+	for (int i = 0; i < count; i++) {
+		// The root is its own parent
+		int parent = Find(maps[i].parent_map);
+		nodes[i].parent = parent == i ? -1 : parent;
+		nodes[i].depth = INT_MIN;
+	}
+
+	// Depths, breaking the parent links of broken files with cycles
+	const int in_progress = INT_MIN + 1;
+	std::vector<int> path;
+	for (int i = 0; i < count; i++) {
+		int pos = i;
+		while (pos != -1 && nodes[pos].depth == INT_MIN) {
+			nodes[pos].depth = in_progress;
+			path.push_back(pos);
+			pos = nodes[pos].parent;
+		}
+		if (pos != -1 && nodes[pos].depth == in_progress) {
+			nodes[path.back()].parent = -1;
+			pos = -1;
+		}
+		int depth = pos == -1 ? -1 : nodes[pos].depth;
+		while (!path.empty()) {
+			nodes[path.back()].depth = ++depth;
+			path.pop_back();
+		}
+	}
+
+	// Children in tree order, maps missing in it last
+	std::unordered_map<int, int> ranks;
+	for (size_t i = 0; i < treemap->tree_order.size(); i++)
+		ranks.insert(std::make_pair(treemap->tree_order[i], (int) i));
+	std::vector<std::pair<int, int> > order;
+	order.reserve(count);
+	for (int i = 0; i < count; i++) {
+		std::unordered_map<int, int>::const_iterator it = ranks.find(maps[i].ID);
+		order.push_back(std::make_pair(it == ranks.end() ? INT_MAX : it->second, i));
+	}
+	std::sort(order.begin(), order.end());
+	for (size_t i = 0; i < order.size(); i++) {
+		int pos = order[i].second;
+		if (nodes[pos].parent != -1)
+			nodes[nodes[pos].parent].children.push_back(maps[pos].ID);
+	}
+}
+
+int TreeMapIndex::Find(int id) const {
+	std::unordered_map<int, int>::const_iterator it = positions.find(id);
+	return it == positions.end() ? -1 : it->second;
+}
+
+const RPG::MapInfo* TreeMapIndex::Get(int id) const {
+	int pos = Find(id);
+	return pos == -1 ? NULL : &treemap->maps[pos];
+}
+
+int TreeMapIndex::GetParent(int id) const {
+	int pos = Find(id);
+	if (pos == -1 || nodes[pos].parent == -1)
+		return -1;
+	return treemap->maps[nodes[pos].parent].ID;
+}
+
+const std::vector<int>& TreeMapIndex::GetChildren(int id) const {
+	static const std::vector<int> none;
+	int pos = Find(id);
+	return pos == -1 ? none : nodes[pos].children;
+}
+
+std::vector<int> TreeMapIndex::GetAncestors(int id) const {
+	std::vector<int> ancestors;
+	int pos = Find(id);
+	if (pos == -1)
+		return ancestors;
+	ancestors.reserve(nodes[pos].depth);
+	for (pos = nodes[pos].parent; pos != -1; pos = nodes[pos].parent)
+		ancestors.push_back(treemap->maps[pos].ID);
+	return ancestors;
+}
+
+int TreeMapIndex::GetDepth(int id) const {
+	int pos = Find(id);
+	return pos == -1 ? -1 : nodes[pos].depth;
+}
+
+bool TreeMapIndex::IsAncestor(int ancestor, int id) const {
+	int target = Find(ancestor);
+	int pos = Find(id);
+	if (target == -1 || pos == -1 || nodes[target].depth >= nodes[pos].depth)
+		return false;
+	while (nodes[pos].depth > nodes[target].depth)
+		pos = nodes[pos].parent;
+	return pos == target;
+}
+
+const RPG::MapInfo* TreeMapIndex::GetMusicInfo(int id) const {
+	for (int pos = Find(id); pos != -1; pos = nodes[pos].parent) {
+		if (treemap->maps[pos].music_type != RPG::MapInfo::MusicType_parent)
+			return &treemap->maps[pos];
+	}
+	return NULL;
+}
+
+const RPG::MapInfo* TreeMapIndex::GetBackgroundInfo(int id) const {
+	for (int pos = Find(id); pos != -1; pos = nodes[pos].parent) {
+		if (treemap->maps[pos].background_type != RPG::MapInfo::BGMType_parent)
+			return &treemap->maps[pos];
+	}
+	return NULL;
+}
+
+int TreeMapIndex::GetTriState(int id, int RPG::MapInfo::*setting) const {
+	for (int pos = Find(id); pos != -1; pos = nodes[pos].parent) {
+		int value = treemap->maps[pos].*setting;
+		if (value != RPG::MapInfo::TriState_parent)
+			return value;
+	}
+	return RPG::MapInfo::TriState_allow;
+}
+
+int TreeMapIndex::GetTeleport(int id) const {
+	return GetTriState(id, &RPG::MapInfo::teleport);
+}
+
+int TreeMapIndex::GetEscape(int id) const {
+	return GetTriState(id, &RPG::MapInfo::escape);
+}
+
+int TreeMapIndex::GetSave(int id) const {
+	return GetTriState(id, &RPG::MapInfo::save);
+}
+
+void TreeMapIndex::CollectSubtree(int id, std::vector<int>& ids) const {
+	std::vector<int> stack(1, id);
+	while (!stack.empty()) {
+		int current = stack.back();
+		stack.pop_back();
+		ids.push_back(current);
+		const std::vector<int>& children = GetChildren(current);
+		// Reversed so the children come out in tree order
+		stack.insert(stack.end(), children.rbegin(), children.rend());
+	}
+}
+
+void TreeMapIndex::InsertIntoOrder(const std::vector<int>& ids, int parent) {
+	std::vector<int>& tree_order = treemap->tree_order;
+	std::vector<int>::iterator it = std::find(tree_order.begin(), tree_order.end(), parent);
+	if (it != tree_order.end()) {
+		++it;
+		while (it != tree_order.end() && IsAncestor(parent, *it))
+			++it;
+	}
+	tree_order.insert(it, ids.begin(), ids.end());
+}
+
+RPG::MapInfo* TreeMapIndex::AddMap(const RPG::MapInfo& info) {
+	if (Find(info.ID) != -1 || Find(info.parent_map) == -1)
+		return NULL;
+
+	treemap->maps.push_back(info);
+	InsertIntoOrder(std::vector<int>(1, info.ID), info.parent_map);
+	Reindex();
+
+	int pos = Find(info.ID);
+	treemap->maps[pos].indentation = nodes[pos].depth;
+	return &treemap->maps[pos];
+}
+
+bool TreeMapIndex::RemoveMap(int id) {
+	int pos = Find(id);
+	if (pos == -1 || nodes[pos].parent == -1)
+		return false;
+	int parent = treemap->maps[nodes[pos].parent].ID;
+
+	std::vector<int> subtree;
+	CollectSubtree(id, subtree);
+	std::unordered_set<int> removed(subtree.begin(), subtree.end());
+
+	std::vector<RPG::MapInfo>& maps = treemap->maps;
+	size_t kept = 0;
+	for (size_t i = 0; i < maps.size(); i++) {
+		if (removed.count(maps[i].ID) == 0) {
+			if (kept != i)
+				maps[kept] = std::move(maps[i]);
+			kept++;
+		}
+	}
+	maps.erase(maps.begin() + kept, maps.end());
+
+	std::vector<int>& tree_order = treemap->tree_order;
+	kept = 0;
+	for (size_t i = 0; i < tree_order.size(); i++) {
+		if (removed.count(tree_order[i]) == 0)
+			tree_order[kept++] = tree_order[i];
+	}
+	tree_order.resize(kept);
+
+	if (removed.count(treemap->active_node) != 0)
+		treemap->active_node = parent;
+
+	Reindex();
+	return true;
+}
+
+bool TreeMapIndex::SetParent(int id, int parent) {
+	int pos = Find(id);
+	if (pos == -1 || nodes[pos].parent == -1 || Find(parent) == -1)
+		return false;
+	if (id == parent || IsAncestor(id, parent))
+		return false;
+
+	std::vector<int> subtree;
+	CollectSubtree(id, subtree);
+	std::unordered_set<int> moved(subtree.begin(), subtree.end());
+
+	std::vector<int>& tree_order = treemap->tree_order;
+	size_t kept = 0;
+	for (size_t i = 0; i < tree_order.size(); i++) {
+		if (moved.count(tree_order[i]) == 0)
+			tree_order[kept++] = tree_order[i];
+	}
+	tree_order.resize(kept);
+
+	InsertIntoOrder(subtree, parent);
+	treemap->maps[pos].parent_map = parent;
+	Reindex();
+
+	for (size_t i = 0; i < subtree.size(); i++) {
+		int child = Find(subtree[i]);
+		treemap->maps[child].indentation = nodes[child].depth;
+	}
+	return true;
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#ifndef LCF_TREEMAP_INDEX_H
+#define LCF_TREEMAP_INDEX_H
+
+#include <unordered_map>
+#include <vector>
+#include "reader_types.h"
+#include "rpg_treemap.h"
+
+/**
+ * Hierarchy of a map tree.
+ *
+ * The map tree stores its maps as a flat vector linked by parent_map.
+ * The index keeps the parent and children of every map, so walking the
+ * hierarchy and resolving settings inherited from parent maps takes time
+ * proportional to the depth of a map.
+ *
+ * The index refers to the map tree it was built from. It must be rebuilt
+ * when the map tree is changed directly; changes through AddMap,
+ * RemoveMap and SetParent keep map tree and index consistent.
+ */
+class TreeMapIndex {
+public:
+	TreeMapIndex();
+	explicit TreeMapIndex(RPG::TreeMap& treemap);
+
+	/**
+	 * Indexes a map tree, usually right after loading it.
+	 */
+	void Build(RPG::TreeMap& treemap);
+
+	/**
+	 * Returns the map or area with the ID or NULL if there is none.
+	 */
+	const RPG::MapInfo* Get(int id) const;
+
+	/**
+	 * Returns the ID of the parent or -1 for the root and unknown maps.
+	 */
+	int GetParent(int id) const;
+
+	/**
+	 * Returns the IDs of the direct children in tree order.
+	 */
+	const std::vector<int>& GetChildren(int id) const;
+
+	/**
+	 * Returns the IDs of all ancestors, parent first and root last.
+	 */
+	std::vector<int> GetAncestors(int id) const;
+
+	/**
+	 * Returns the number of ancestors, -1 for unknown maps.
+	 */
+	int GetDepth(int id) const;
+
+	/**
+	 * Checks if ancestor is a parent, grandparent, ... of id.
+	 */
+	bool IsAncestor(int ancestor, int id) const;
+
+	/**
+	 * Returns the map whose music settings apply to the map, following
+	 * music_type "parent" upwards. NULL if no map sets the music.
+	 */
+	const RPG::MapInfo* GetMusicInfo(int id) const;
+
+	/**
+	 * Returns the map whose battle background applies to the map,
+	 * following background_type "parent" upwards. NULL if no map sets it.
+	 */
+	const RPG::MapInfo* GetBackgroundInfo(int id) const;
+
+	/**
+	 * Returns the effective teleport, escape and save setting of the map,
+	 * following "parent" upwards: TriState_allow or TriState_forbid.
+	 * Allowed when no map decides.
+	 */
+	int GetTeleport(int id) const;
+	int GetEscape(int id) const;
+	int GetSave(int id) const;
+
+	/**
+	 * Adds a map below the parent given by its parent_map, as the last
+	 * child in tree order. The indentation is set from the parent.
+	 *
+	 * @return the added map or NULL if the ID is used or the parent
+	 *         does not exist.
+	 */
+	RPG::MapInfo* AddMap(const RPG::MapInfo& info);
+
+	/**
+	 * Removes a map with all its descendants. The root can't be removed.
+	 *
+	 * @return true if the map was removed.
+	 */
+	bool RemoveMap(int id);
+
+	/**
+	 * Moves a map with its descendants below another parent, as the last
+	 * child in tree order.
+	 *
+	 * @return false if a map does not exist or parent is the map itself
+	 *         or one of its descendants.
+	 */
+	bool SetParent(int id, int parent);
+
+private:
+	struct Node {
+		/** Position of the parent in maps, -1 for none. */
+		int parent;
+		int depth;
+		std::vector<int> children;
+	};
+
+	int Find(int id) const;
+	int GetTriState(int id, int RPG::MapInfo::*setting) const;
+	void CollectSubtree(int id, std::vector<int>& ids) const;
+	void InsertIntoOrder(const std::vector<int>& ids, int parent);
+	void Reindex();
+
+	RPG::TreeMap* treemap;
+	/** Position in maps per map ID. */
+	std::unordered_map<int, int> positions;
+	/** Same order as maps. */
+	std::vector<Node> nodes;
+};
+
+#endif
@@ -114,6 +114,10 @@ void LcfWriter::Write(const std::string& _str) {
 	}
 }
 
+uint32_t LcfWriter::Tell() {
+	return (uint32_t)ftell(stream);
+}
+
 bool LcfWriter::IsOk() const {
 	return (stream != NULL && !ferror(stream));
 }
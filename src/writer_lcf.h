@@ -89,6 +89,13 @@ public:
 	template <class T>
 	void Write(const std::vector<T>& buffer);
 
+	/**
+	 * Returns the current position of the write pointer.
+	 *
+	 * @return number of bytes written.
+	 */
+	uint32_t Tell();
+
 	/**
 	 * Checks if the file is writable and if no error occurred.
 	 *
@@ -5,8 +5,90 @@
  */
 
 #include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <clocale>
+#include "small_vector.h"
 #include "writer_xml.h"
 
+// Number formatting
+
+static const char digit_pairs[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+/**
+ * Formats an unsigned integer backwards, two digits at a time.
+ *
+ * @param end one past the last character of the output buffer.
+ * @param val the integer.
+ * @return pointer to the first written character.
+ */
+static char* FormatUnsigned(char* end, uint32_t val) {
+	while (val >= 100) {
+		uint32_t i = (val % 100) * 2;
+		val /= 100;
+		*--end = digit_pairs[i + 1];
+		*--end = digit_pairs[i];
+	}
+	if (val >= 10) {
+		*--end = digit_pairs[val * 2 + 1];
+		*--end = digit_pairs[val * 2];
+	} else {
+		*--end = (char) ('0' + val);
+	}
+	return end;
+}
+
+/**
+ * Formats a signed integer backwards.
+ *
+ * @param end one past the last character of the output buffer.
+ * @param val the integer.
+ * @return pointer to the first written character.
+ */
+static char* FormatInt(char* end, int val) {
+	uint32_t abs_val = val < 0 ? 0U - (uint32_t) val : (uint32_t) val;
+	char* begin = FormatUnsigned(end, abs_val);
+	if (val < 0)
+		*--begin = '-';
+	return begin;
+}
+
+/**
+ * Formats a double with the fewest digits (15 to 17) that read back
+ * to the same value. The decimal point is always '.'.
+ *
+ * @param buf output buffer.
+ * @param size size of the output buffer.
+ * @param val the double.
+ * @return number of written characters.
+ */
+static int FormatDouble(char* buf, size_t size, double val) {
+	int len = 0;
+	for (int precision = 15; precision <= 17; precision++) {
+		len = snprintf(buf, size, "%.*g", precision, val);
+		if (strtod(buf, NULL) == val)
+			break;
+	}
+
+	const char point = *localeconv()->decimal_point;
+	if (point != '.') {
+		char* p = strchr(buf, point);
+		if (p != NULL)
+			*p = '.';
+	}
+	return len;
+}
+
 XmlWriter::XmlWriter(const char* filename) :
 	filename(filename),
 	indent(0),
@@ -29,25 +111,49 @@ XmlWriter::~XmlWriter() {
 
 void XmlWriter::Open() {
 	stream = fopen(filename.c_str(), "w");
-	fputs("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n", stream);
+	buffer.reserve(buffer_size + 256);
+	static const char header[] = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+	Put(header, sizeof(header) - 1);
 }
 
 void XmlWriter::Close() {
+	Flush();
 	if (stream != NULL)
 		fclose(stream);
 	stream = NULL;
 }
 
+void XmlWriter::Put(char c) {
+	buffer.push_back(c);
+	if (buffer.size() >= buffer_size)
+		Flush();
+}
+
+void XmlWriter::Put(const char* s, size_t len) {
+	buffer.append(s, len);
+	if (buffer.size() >= buffer_size)
+		Flush();
+}
+
+void XmlWriter::Flush() {
+	if (stream != NULL && !buffer.empty())
+		fwrite(buffer.data(), 1, buffer.size(), stream);
+	buffer.clear();
+}
+
 template <>
 void XmlWriter::Write<bool>(const bool& val) {
 	Indent();
-	fputs(val ? "T" : "F", stream);
+	Put(val ? 'T' : 'F');
 }
 
 template <>
 void XmlWriter::Write<int>(const int& val) {
 	Indent();
-	fprintf(stream, "%d", val);
+	char buf[16];
+	char* end = buf + sizeof(buf);
+	char* begin = FormatInt(end, val);
+	Put(begin, end - begin);
 }
 
 template <>
@@ -63,91 +169,116 @@ void XmlWriter::Write<int16_t>(const int16_t& val) {
 template <>
 void XmlWriter::Write<uint32_t>(const uint32_t& val) {
 	Indent();
-	fprintf(stream, "%u", val);
+	char buf[16];
+	char* end = buf + sizeof(buf);
+	char* begin = FormatUnsigned(end, val);
+	Put(begin, end - begin);
 }
 
 template <>
 void XmlWriter::Write<double>(const double& val) {
 	Indent();
-	fprintf(stream, "%g", val);
+	char buf[32];
+	int len = FormatDouble(buf, sizeof(buf), val);
+	Put(buf, len);
 }
 
 template <>
 void XmlWriter::Write<std::string>(const std::string& val) {
+	static const char hex_digits[] = "0123456789abcdef";
+
 	Indent();
-	std::string::const_iterator it;
-	for (it = val.begin(); it != val.end(); it++) {
+	const char* run = val.data();
+	const char* end = run + val.size();
+	for (const char* it = run; it != end; it++) {
 		int c = (int) *it;
+		// Copy runs of characters which need no escaping in one block
+		if ((c < 0 || c >= 32) && c != '<' && c != '>' && c != '&')
+			continue;
+		Put(run, it - run);
+		run = it + 1;
 		switch (c) {
 			case '<':
-				fputs("&lt;", stream);
+				Put("&lt;", 4);
 				break;
 			case '>':
-				fputs("&gt;", stream);
+				Put("&gt;", 4);
 				break;
 			case '&':
-				fputs("&amp;", stream);
+				Put("&amp;", 5);
 				break;
 			case '\n':
-				fputc(c, stream);
+				Put((char) c);
 				at_bol = true;
 				Indent();
 			case '\r':
 			case '\t':
-				fputc(c, stream);
+				Put((char) c);
 				break;
-			default:
-				if (c >= 0 && c < 32)
-					fprintf(stream, "&#x%04x;", 0xE000 + c);
-				else
-					fputc(c, stream);
+			default: {
+				// C0 control codes are re-mapped to U+E000 (see XmlReader)
+				int code = 0xE000 + c;
+				char escape[] = "&#x0000;";
+				escape[3] = hex_digits[(code >> 12) & 0xF];
+				escape[4] = hex_digits[(code >> 8) & 0xF];
+				escape[5] = hex_digits[(code >> 4) & 0xF];
+				escape[6] = hex_digits[code & 0xF];
+				Put(escape, 8);
 				break;
+			}
 		}
 	}
+	Put(run, end - run);
 }
 
 template <>
 void XmlWriter::Write<std::vector<int> >(const std::vector<int>& val) {
-	WriteVector<int>(val);
+	WriteVector(val);
+}
+
+template <>
+void XmlWriter::Write<SmallVector<int, 4> >(const SmallVector<int, 4>& val) {
+	WriteVector(val);
 }
 
 template <>
 void XmlWriter::Write<std::vector<bool> >(const std::vector<bool>& val) {
-	WriteVector<bool>(val);
+	WriteVector(val);
 }
 
 template <>
 void XmlWriter::Write<std::vector<uint8_t> >(const std::vector<uint8_t>& val) {
-	WriteVector<uint8_t>(val);
+	WriteVector(val);
 }
 
 template <>
 void XmlWriter::Write<std::vector<int16_t> >(const std::vector<int16_t>& val) {
-	WriteVector<int16_t>(val);
+	WriteVector(val);
 }
 
 template <>
 void XmlWriter::Write<std::vector<uint32_t> >(const std::vector<uint32_t>& val) {
-	WriteVector<uint32_t>(val);
+	WriteVector(val);
 }
 
 template <>
 void XmlWriter::Write<std::vector<double> >(const std::vector<double>& val) {
-	WriteVector<double>(val);
+	WriteVector(val);
 }
 
 void XmlWriter::WriteInt(int val) {
 	Write<int>(val);
 }
 
-template <class T>
-void XmlWriter::WriteVector(const std::vector<T>& val) {
+template <class V>
+void XmlWriter::WriteVector(const V& val) {
+	typedef typename V::value_type T;
 	Indent();
-	typename std::vector<T>::const_iterator it;
+	typename V::const_iterator it;
 	bool first = true;
 	for (it = val.begin(); it != val.end(); it++) {
 		if (!first)
-			fputc(' ', stream);
+			Put(' ');
 		first = false;
 		Write<T>(*it);
 	}
@@ -161,38 +292,65 @@ void XmlWriter::WriteNode(const std::string& name, const T& val) {
 }
 
 void XmlWriter::BeginElement(const std::string& name) {
+	BeginElement(name.c_str());
+}
+
+void XmlWriter::BeginElement(const char* name) {
 	NewLine();
 	Indent();
-	fprintf(stream, "<%s>", name.c_str());
+	Put('<');
+	Put(name, strlen(name));
+	Put('>');
 	indent++;
 }
 
 void XmlWriter::BeginElement(const std::string& name, int ID) {
 	NewLine();
 	Indent();
-	fprintf(stream, "<%s id=\"%04d\">", name.c_str(), ID);
+	Put('<');
+	Put(name.data(), name.size());
+	Put(" id=\"", 5);
+
+	// Same output as "%04d"
+	char buf[16];
+	char* end = buf + sizeof(buf);
+	char* begin = FormatUnsigned(end, ID < 0 ? 0U - (uint32_t) ID : (uint32_t) ID);
+	int width = ID < 0 ? 3 : 4;
+	while (end - begin < width)
+		*--begin = '0';
+	if (ID < 0)
+		*--begin = '-';
+	Put(begin, end - begin);
+
+	Put("\">", 2);
 	indent++;
 }
 
 void XmlWriter::EndElement(const std::string& name) {
+	EndElement(name.c_str());
+}
+
+void XmlWriter::EndElement(const char* name) {
 	indent--;
 	Indent();
-	fprintf(stream, "</%s>", name.c_str());
+	Put("</", 2);
+	Put(name, strlen(name));
+	Put('>');
 	NewLine();
 }
 
 void XmlWriter::NewLine() {
 	if (at_bol)
 		return;
-	fputc('\n', stream);
+	Put('\n');
 	at_bol = true;
 }
 
 void XmlWriter::Indent() {
 	if (!at_bol)
 		return;
-	for (int i = 0; i < indent; i++)
-		fputc(' ', stream);
+	if (indent > 0)
+		buffer.append(indent, ' ');
 	at_bol = false;
 }
 
@@ -213,3 +371,4 @@ template void XmlWriter::WriteNode<std::vector<bool> >(const std::string& name,
 template void XmlWriter::WriteNode<std::vector<uint8_t> >(const std::string& name, const std::vector<uint8_t>& val);
 template void XmlWriter::WriteNode<std::vector<int16_t> >(const std::string& name, const std::vector<int16_t>& val);
 template void XmlWriter::WriteNode<std::vector<uint32_t> >(const std::string& name, const std::vector<uint32_t>& val);
+template void XmlWriter::WriteNode<SmallVector<int, 4> >(const std::string& name, const SmallVector<int, 4>& val);
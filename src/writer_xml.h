@@ -79,6 +79,13 @@ public:
 	 */
 	void BeginElement(const std::string& name);
 
+	/**
+	 * Writes element starting tag to the stream.
+	 *
+	 * @param name the element name string.
+	 */
+	void BeginElement(const char* name);
+
 	/**
 	 * Writes element starting tag and attribute id to the stream.
 	 *
@@ -94,6 +101,13 @@ public:
 	 */
 	void EndElement(const std::string& name);
 
+	/**
+	 * Writes element ending tag to the stream.
+	 *
+	 * @param name the element name string.
+	 */
+	void EndElement(const char* name);
+
 	/**
 	 * Writes a line break to the stream.
 	 */
@@ -116,19 +130,44 @@ protected:
 	int indent;
 	/** Indicates if writer cursor is at the beginning of the line. */
 	bool at_bol;
+	/** Output buffer, written to the file when full or on close. */
+	std::string buffer;
+
+	/** Size at which the output buffer is flushed. */
+	static const size_t buffer_size = 64 * 1024;
 
 	/**
 	 * Writes an indentation to the stream.
 	 */
 	void Indent();
 
+	/**
+	 * Appends a character to the output buffer.
+	 *
+	 * @param c the character.
+	 */
+	void Put(char c);
+
+	/**
+	 * Appends a block of characters to the output buffer.
+	 *
+	 * @param s pointer to the characters.
+	 * @param len number of characters.
+	 */
+	void Put(const char* s, size_t len);
+
+	/**
+	 * Writes the output buffer to the file.
+	 */
+	void Flush();
+
 	/**
 	 * Writes a vector of primitive values to the stream.
 	 *
-	 * @param val vector to write.
+	 * @param val std::vector or SmallVector to write.
 	 */
-	template <class T>
-	void WriteVector(const std::vector<T>& val);
+	template <class V>
+	void WriteVector(const V& val);
 
 };
 
@@ -0,0 +1,533 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "reader_lcf.h"
+#include "reader_mmap.h"
+#include "writer_lcf.h"
+#include "xref_index.h"
+
+typedef RPG::EventCommand::Code Code;
+
+// File layout: magic, version, number of files, then per file the map
+// ID, the number of references and their fields as compressed integers.
+
+static const char xref_magic[8] = { 'L', 'c', 'f', 'X', 'r', 'e', 'f', 0 };
+
+/**
+ * Index format version. Increase when the layout changes or commands
+ * are indexed differently, old indices are then rebuilt.
+ */
+static const uint32_t xref_version = 1;
+
+namespace {
+	/** ControlSwitches, ControlVars and friends: target selection. */
+	enum Target {
+		Target_single = 0,
+		Target_range = 1,
+		Target_variable = 2
+	};
+
+	/** Actor selection of the actor commands. */
+	enum ActorTarget {
+		ActorTarget_party = 0,
+		ActorTarget_fixed = 1,
+		ActorTarget_variable = 2
+	};
+
+	/** ConditionalBranch condition types. */
+	enum Branch {
+		Branch_switch = 0,
+		Branch_variable = 1,
+		Branch_item = 4,
+		Branch_actor = 5
+	};
+
+	/** ControlVars operand types. */
+	enum Operand {
+		Operand_variable = 1,
+		Operand_variable_indirect = 2,
+		Operand_item = 4,
+		Operand_actor = 5
+	};
+
+	/** CallEvent target types. */
+	enum CallTarget {
+		CallTarget_common_event = 0,
+		CallTarget_variable = 2
+	};
+
+	/**
+	 * Appends references of one page or common event.
+	 */
+	struct Collector {
+		std::vector<XrefIndex::Reference>& refs;
+		XrefIndex::Reference base;
+
+		Collector(std::vector<XrefIndex::Reference>& refs, int source, int map_id, int event_id, int page_id) :
+			refs(refs) {
+			base.kind = 0;
+			base.id = 0;
+			base.access = XrefIndex::Access_read;
+			base.source = source;
+			base.map_id = map_id;
+			base.event_id = event_id;
+			base.page_id = page_id;
+			base.command = -1;
+		}
+
+		void Add(int kind, int id, int access) {
+			XrefIndex::Reference ref = base;
+			ref.kind = kind;
+			ref.id = id;
+			ref.access = access;
+			refs.push_back(ref);
+		}
+
+		void AddRange(int kind, int first, int last, int access) {
+			for (int id = first; id <= last; id++)
+				Add(kind, id, access);
+		}
+	};
+}
+
+/**
+ * Returns a parameter of a command, 0 when it is missing.
+ */
+static int Param(const RPG::EventCommand& com, size_t index) {
+	return index < com.parameters.size() ? com.parameters[index] : 0;
+}
+
+/**
+ * Adds the \V[n] variables shown in a message.
+ */
+static void CollectMessage(Collector& out, const std::string& text) {
+	for (size_t i = 0; i + 3 < text.size(); i++) {
+		if (text[i] != '\\' || (text[i + 1] != 'V' && text[i + 1] != 'v') || text[i + 2] != '[')
+			continue;
+		int id = 0;
+		size_t j = i + 3;
+		for (; j < text.size() && text[j] >= '0' && text[j] <= '9'; j++)
+			id = id * 10 + (text[j] - '0');
+		if (j > i + 3 && j < text.size() && text[j] == ']')
+			out.Add(XrefIndex::Kind_variable, id, XrefIndex::Access_read);
+	}
+}
+
+/**
+ * Adds the switches or variables selected by the first three parameters
+ * of ControlSwitches and ControlVars.
+ */
+static void CollectTarget(Collector& out, const RPG::EventCommand& com, int kind) {
+	switch (Param(com, 0)) {
+		case Target_single:
+			out.Add(kind, Param(com, 1), XrefIndex::Access_write);
+			break;
+		case Target_range:
+			out.AddRange(kind, Param(com, 1), Param(com, 2), XrefIndex::Access_write);
+			break;
+		case Target_variable:
+			out.Add(XrefIndex::Kind_variable, Param(com, 1), XrefIndex::Access_read);
+			break;
+	}
+}
+
+/**
+ * Adds the actor selected by the parameters at index and index + 1.
+ */
+static void CollectActor(Collector& out, const RPG::EventCommand& com, size_t index) {
+	switch (Param(com, index)) {
+		case ActorTarget_fixed:
+			out.Add(XrefIndex::Kind_actor, Param(com, index + 1), XrefIndex::Access_write);
+			break;
+		case ActorTarget_variable:
+			out.Add(XrefIndex::Kind_variable, Param(com, index + 1), XrefIndex::Access_read);
+			break;
+	}
+}
+
+/**
+ * Adds the variable of an operand that is a constant (0) or a variable
+ * (1), selected by the parameter at index.
+ */
+static void CollectOperand(Collector& out, const RPG::EventCommand& com, size_t index) {
+	if (Param(com, index) == 1)
+		out.Add(XrefIndex::Kind_variable, Param(com, index + 1), XrefIndex::Access_read);
+}
+
+static void CollectCommand(Collector& out, const RPG::EventCommand& com) {
+	switch (com.code) {
+		case Code::ShowMessage:
+		case Code::ShowMessage_2:
+		case Code::ShowChoiceOption:
+			CollectMessage(out, com.string);
+			break;
+		case Code::InputNumber:
+			out.Add(XrefIndex::Kind_variable, Param(com, 1), XrefIndex::Access_write);
+			break;
+		case Code::ControlSwitches:
+			CollectTarget(out, com, XrefIndex::Kind_switch);
+			break;
+		case Code::ControlVars:
+			CollectTarget(out, com, XrefIndex::Kind_variable);
+			switch (Param(com, 4)) {
+				case Operand_variable:
+				case Operand_variable_indirect:
+					out.Add(XrefIndex::Kind_variable, Param(com, 5), XrefIndex::Access_read);
+					break;
+				case Operand_item:
+					out.Add(XrefIndex::Kind_item, Param(com, 5), XrefIndex::Access_read);
+					break;
+				case Operand_actor:
+					out.Add(XrefIndex::Kind_actor, Param(com, 5), XrefIndex::Access_read);
+					break;
+			}
+			break;
+		case Code::TimerOperation:
+			if (Param(com, 0) == 0)
+				CollectOperand(out, com, 1);
+			break;
+		case Code::ChangeGold:
+			CollectOperand(out, com, 1);
+			break;
+		case Code::ChangeItems:
+			if (Param(com, 1) == 0)
+				out.Add(XrefIndex::Kind_item, Param(com, 2), XrefIndex::Access_write);
+			else
+				out.Add(XrefIndex::Kind_variable, Param(com, 2), XrefIndex::Access_read);
+			CollectOperand(out, com, 3);
+			break;
+		case Code::ChangePartyMembers:
+			if (Param(com, 1) == 0)
+				out.Add(XrefIndex::Kind_actor, Param(com, 2), XrefIndex::Access_write);
+			else
+				out.Add(XrefIndex::Kind_variable, Param(com, 2), XrefIndex::Access_read);
+			break;
+		case Code::ChangeExp:
+		case Code::ChangeLevel:
+		case Code::ChangeHP:
+		case Code::ChangeSP:
+			CollectActor(out, com, 0);
+			CollectOperand(out, com, 3);
+			break;
+		case Code::ChangeParameters:
+			CollectActor(out, com, 0);
+			CollectOperand(out, com, 4);
+			break;
+		case Code::ChangeSkills:
+			CollectActor(out, com, 0);
+			CollectOperand(out, com, 3);
+			break;
+		case Code::ChangeEquipment:
+			CollectActor(out, com, 0);
+			if (Param(com, 2) == 0) {
+				if (Param(com, 3) == 0)
+					out.Add(XrefIndex::Kind_item, Param(com, 4), XrefIndex::Access_read);
+				else
+					out.Add(XrefIndex::Kind_variable, Param(com, 4), XrefIndex::Access_read);
+			}
+			break;
+		case Code::ChangeCondition:
+		case Code::FullHeal:
+		case Code::SimulatedAttack:
+		case Code::ChangeClass:
+		case Code::ChangeBattleCommands:
+			CollectActor(out, com, 0);
+			break;
+		case Code::ChangeHeroName:
+		case Code::ChangeHeroTitle:
+		case Code::ChangeSpriteAssociation:
+		case Code::ChangeActorFace:
+		case Code::EnterHeroName:
+			out.Add(XrefIndex::Kind_actor, Param(com, 0), XrefIndex::Access_write);
+			break;
+		case Code::OpenShop:
+			for (size_t i = 4; i < com.parameters.size(); i++)
+				out.Add(XrefIndex::Kind_item, com.parameters[i], XrefIndex::Access_read);
+			break;
+		case Code::MemorizeLocation:
+			for (size_t i = 0; i < 3; i++)
+				out.Add(XrefIndex::Kind_variable, Param(com, i), XrefIndex::Access_write);
+			break;
+		case Code::RecallToLocation:
+			for (size_t i = 0; i < 3; i++)
+				out.Add(XrefIndex::Kind_variable, Param(com, i), XrefIndex::Access_read);
+			break;
+		case Code::SetVehicleLocation:
+			// Map, x and y
+			if (Param(com, 1) == 1) {
+				for (size_t i = 2; i < 5; i++)
+					out.Add(XrefIndex::Kind_variable, Param(com, i), XrefIndex::Access_read);
+			}
+			break;
+		case Code::ChangeEventLocation:
+			// x and y, parameter 4 is the direction in RPG2003
+			if (Param(com, 1) == 1) {
+				for (size_t i = 2; i < 4; i++)
+					out.Add(XrefIndex::Kind_variable, Param(com, i), XrefIndex::Access_read);
+			}
+			break;
+		case Code::StoreTerrainID:
+		case Code::StoreEventID:
+			if (Param(com, 0) == 1) {
+				out.Add(XrefIndex::Kind_variable, Param(com, 1), XrefIndex::Access_read);
+				out.Add(XrefIndex::Kind_variable, Param(com, 2), XrefIndex::Access_read);
+			}
+			out.Add(XrefIndex::Kind_variable, Param(com, 3), XrefIndex::Access_write);
+			break;
+		case Code::KeyInputProc:
+			out.Add(XrefIndex::Kind_variable, Param(com, 0), XrefIndex::Access_write);
+			break;
+		case Code::ConditionalBranch:
+		case Code::ConditionalBranch_B:
+			switch (Param(com, 0)) {
+				case Branch_switch:
+					out.Add(XrefIndex::Kind_switch, Param(com, 1), XrefIndex::Access_read);
+					break;
+				case Branch_variable:
+					out.Add(XrefIndex::Kind_variable, Param(com, 1), XrefIndex::Access_read);
+					CollectOperand(out, com, 2);
+					break;
+				case Branch_item:
+					if (com.code == Code::ConditionalBranch)
+						out.Add(XrefIndex::Kind_item, Param(com, 1), XrefIndex::Access_read);
+					break;
+				case Branch_actor:
+					if (com.code == Code::ConditionalBranch)
+						out.Add(XrefIndex::Kind_actor, Param(com, 1), XrefIndex::Access_read);
+					break;
+			}
+			break;
+		case Code::CallCommonEvent:
+			out.Add(XrefIndex::Kind_common_event, Param(com, 0), XrefIndex::Access_read);
+			break;
+		case Code::CallEvent:
+			if (Param(com, 0) == CallTarget_common_event) {
+				out.Add(XrefIndex::Kind_common_event, Param(com, 1), XrefIndex::Access_read);
+			} else if (Param(com, 0) == CallTarget_variable) {
+				out.Add(XrefIndex::Kind_variable, Param(com, 1), XrefIndex::Access_read);
+				out.Add(XrefIndex::Kind_variable, Param(com, 2), XrefIndex::Access_read);
+			}
+			break;
+	}
+}
+
+static void CollectCommands(Collector& out, const std::vector<RPG::EventCommand>& commands) {
+	for (size_t i = 0; i < commands.size(); i++) {
+		out.base.command = (int) i;
+		CollectCommand(out, commands[i]);
+	}
+	out.base.command = -1;
+}
+
+XrefIndex::XrefIndex() {
+}
+
+void XrefIndex::Collect(const RPG::Database& db, std::vector<Reference>& refs) {
+	for (size_t i = 0; i < db.commonevents.size(); i++) {
+		const RPG::CommonEvent& event = db.commonevents[i];
+		Collector out(refs, Source_common_event, 0, event.ID, 0);
+		if (event.switch_flag)
+			out.Add(Kind_switch, event.switch_id, Access_read);
+		CollectCommands(out, event.event_commands);
+	}
+
+	for (size_t i = 0; i < db.troops.size(); i++) {
+		const RPG::Troop& troop = db.troops[i];
+		for (size_t j = 0; j < troop.pages.size(); j++) {
+			const RPG::TroopPage& page = troop.pages[j];
+			const RPG::TroopPageCondition& cond = page.condition;
+			Collector out(refs, Source_troop, 0, troop.ID, page.ID);
+			if (cond.flags.switch_a)
+				out.Add(Kind_switch, cond.switch_a_id, Access_read);
+			if (cond.flags.switch_b)
+				out.Add(Kind_switch, cond.switch_b_id, Access_read);
+			if (cond.flags.variable)
+				out.Add(Kind_variable, cond.variable_id, Access_read);
+			if (cond.flags.actor_hp)
+				out.Add(Kind_actor, cond.actor_id, Access_read);
+			if (cond.flags.turn_actor)
+				out.Add(Kind_actor, cond.turn_actor_id, Access_read);
+			if (cond.flags.command_actor)
+				out.Add(Kind_actor, cond.command_actor_id, Access_read);
+			CollectCommands(out, page.event_commands);
+		}
+	}
+}
+
+void XrefIndex::Collect(int map_id, const RPG::Map& map, std::vector<Reference>& refs) {
+	for (size_t i = 0; i < map.events.size(); i++) {
+		const RPG::Event& event = map.events[i];
+		for (size_t j = 0; j < event.pages.size(); j++) {
+			const RPG::EventPage& page = event.pages[j];
+			const RPG::EventPageCondition& cond = page.condition;
+			Collector out(refs, Source_map_event, map_id, event.ID, page.ID);
+			if (cond.flags.switch_a)
+				out.Add(Kind_switch, cond.switch_a_id, Access_read);
+			if (cond.flags.switch_b)
+				out.Add(Kind_switch, cond.switch_b_id, Access_read);
+			if (cond.flags.variable)
+				out.Add(Kind_variable, cond.variable_id, Access_read);
+			if (cond.flags.item)
+				out.Add(Kind_item, cond.item_id, Access_read);
+			if (cond.flags.actor)
+				out.Add(Kind_actor, cond.actor_id, Access_read);
+			CollectCommands(out, page.event_commands);
+		}
+	}
+}
+
+void XrefIndex::SetDatabase(const RPG::Database& db) {
+	std::vector<Reference> refs;
+	Collect(db, refs);
+	SetReferences(0, refs);
+}
+
+void XrefIndex::SetMap(int map_id, const RPG::Map& map) {
+	std::vector<Reference> refs;
+	Collect(map_id, map, refs);
+	SetReferences(map_id, refs);
+}
+
+void XrefIndex::SetReferences(int map_id, const std::vector<Reference>& refs) {
+	RemoveMap(map_id);
+	std::vector<Reference>& file = files[map_id];
+	file = refs;
+	for (size_t i = 0; i < file.size(); i++)
+		file[i].map_id = map_id;
+	AddPostings(file);
+}
+
+void XrefIndex::RemoveMap(int map_id) {
+	std::map<int, std::vector<Reference> >::iterator it = files.find(map_id);
+	if (it == files.end())
+		return;
+	RemovePostings(map_id, it->second);
+	files.erase(it);
+}
+
+void XrefIndex::Clear() {
+	files.clear();
+	postings.clear();
+}
+
+const std::vector<XrefIndex::Reference>& XrefIndex::Find(Kind kind, int id) const {
+	static const std::vector<Reference> empty;
+	std::unordered_map<uint64_t, std::vector<Reference> >::const_iterator it = postings.find(Key(kind, id));
+	return it == postings.end() ? empty : it->second;
+}
+
+const std::vector<XrefIndex::Reference>& XrefIndex::GetReferences(int map_id) const {
+	static const std::vector<Reference> empty;
+	std::map<int, std::vector<Reference> >::const_iterator it = files.find(map_id);
+	return it == files.end() ? empty : it->second;
+}
+
+uint64_t XrefIndex::Key(int kind, int id) {
+	return ((uint64_t) (uint32_t) kind << 32) | (uint32_t) id;
+}
+
+void XrefIndex::AddPostings(const std::vector<Reference>& refs) {
+	for (size_t i = 0; i < refs.size(); i++)
+		postings[Key(refs[i].kind, refs[i].id)].push_back(refs[i]);
+}
+
+void XrefIndex::RemovePostings(int map_id, const std::vector<Reference>& refs) {
+	// Only the lists the file contributed to need filtering
+	for (size_t i = 0; i < refs.size(); i++) {
+		std::unordered_map<uint64_t, std::vector<Reference> >::iterator it = postings.find(Key(refs[i].kind, refs[i].id));
+		if (it == postings.end())
+			continue;
+		std::vector<Reference>& list = it->second;
+		std::vector<Reference>::iterator last = list.begin();
+		for (std::vector<Reference>::iterator ref = list.begin(); ref != list.end(); ++ref) {
+			if (ref->map_id != map_id)
+				*last++ = *ref;
+		}
+		list.erase(last, list.end());
+		if (list.empty())
+			postings.erase(it);
+	}
+}
+
+bool XrefIndex::Save(const std::string& filename) const {
+	LcfWriter writer(filename, "");
+	if (!writer.IsOk()) {
+		LcfReader::SetError("Couldn't open %s index file.\n", filename.c_str());
+		return false;
+	}
+	writer.Write(xref_magic, 1, sizeof(xref_magic));
+	writer.Write<uint32_t>(xref_version);
+	writer.Write<int>((int) files.size());
+	std::map<int, std::vector<Reference> >::const_iterator it;
+	for (it = files.begin(); it != files.end(); ++it) {
+		const std::vector<Reference>& refs = it->second;
+		writer.Write<int>(it->first);
+		writer.Write<int>((int) refs.size());
+		for (size_t i = 0; i < refs.size(); i++) {
+			writer.Write<int>(refs[i].kind);
+			writer.Write<int>(refs[i].id);
+			writer.Write<int>(refs[i].access);
+			writer.Write<int>(refs[i].source);
+			writer.Write<int>(refs[i].event_id);
+			writer.Write<int>(refs[i].page_id);
+			writer.Write<int>(refs[i].command);
+		}
+	}
+	return true;
+}
+
+bool XrefIndex::Load(const std::string& filename) {
+	MappedFile file;
+	if (!file.Open(filename)) {
+		LcfReader::SetError("Couldn't find %s index file.\n", filename.c_str());
+		return false;
+	}
+	LcfReader reader(file.Data(), file.Size());
+	char magic[sizeof(xref_magic)];
+	uint32_t version = 0;
+	if (reader.Read0(magic, 1, sizeof(magic)) != sizeof(magic) ||
+		memcmp(magic, xref_magic, sizeof(magic)) != 0) {
+		LcfReader::SetError("%s is not a valid index file.\n", filename.c_str());
+		return false;
+	}
+	reader.Read(version);
+	if (version != xref_version) {
+		LcfReader::SetError("%s is an index of a different version.\n", filename.c_str());
+		return false;
+	}
+
+	Clear();
+	int count = reader.ReadInt();
+	for (int i = 0; i < count && !reader.Eof(); i++) {
+		int map_id = reader.ReadInt();
+		std::vector<Reference>& refs = files[map_id];
+		int size = reader.ReadInt();
+		for (int j = 0; j < size && !reader.Eof(); j++) {
+			Reference ref;
+			ref.kind = reader.ReadInt();
+			ref.id = reader.ReadInt();
+			ref.access = reader.ReadInt();
+			ref.source = reader.ReadInt();
+			ref.map_id = map_id;
+			ref.event_id = reader.ReadInt();
+			ref.page_id = reader.ReadInt();
+			ref.command = reader.ReadInt();
+			refs.push_back(ref);
+		}
+	}
+	if (reader.Eof()) {
+		LcfReader::SetError("%s is truncated.\n", filename.c_str());
+		Clear();
+		return false;
+	}
+
+	std::map<int, std::vector<Reference> >::const_iterator it;
+	for (it = files.begin(); it != files.end(); ++it)
+		AddPostings(it->second);
+	return true;
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2016 liblcf authors
+ * This file is released under the MIT License
+ * http://opensource.org/licenses/MIT
+ */
+
+#ifndef LCF_XREF_INDEX_H
+#define LCF_XREF_INDEX_H
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "reader_types.h"
+#include "rpg_database.h"
+#include "rpg_map.h"
+
+/**
+ * Finds where switches, variables, items, actors and common events are
+ * used.
+ *
+ * The index knows the parameter layout of the event commands touching
+ * them and the conditions of event pages, common events and troop
+ * pages. References are collected per file: the database has map ID 0,
+ * maps their own ID. A changed map is indexed again on its own with
+ * SetMap, without scanning the other files.
+ *
+ * Collect only reads the game data, so the files of a game can be
+ * collected on several threads at once and the results passed to
+ * SetReferences.
+ */
+class XrefIndex {
+public:
+	enum Kind {
+		Kind_switch = 0,
+		Kind_variable = 1,
+		Kind_item = 2,
+		Kind_actor = 3,
+		Kind_common_event = 4
+	};
+
+	enum Access {
+		/** Checked, read or called. */
+		Access_read = 0,
+		/** Changed. */
+		Access_write = 1
+	};
+
+	enum Source {
+		Source_map_event = 0,
+		Source_common_event = 1,
+		Source_troop = 2
+	};
+
+	/**
+	 * One use of a switch, variable, item, actor or common event.
+	 */
+	struct Reference {
+		int kind;
+		int id;
+		int access;
+		int source;
+		/** ID of the map, 0 for the database. */
+		int map_id;
+		/** ID of the map event, common event or troop. */
+		int event_id;
+		/** ID of the page, 0 for common events. */
+		int page_id;
+		/** Position of the command, -1 for the page condition. */
+		int command;
+	};
+
+	XrefIndex();
+
+	/**
+	 * Collects the references of the common events and troops of a
+	 * database.
+	 */
+	static void Collect(const RPG::Database& db, std::vector<Reference>& refs);
+
+	/**
+	 * Collects the references of the events of a map.
+	 */
+	static void Collect(int map_id, const RPG::Map& map, std::vector<Reference>& refs);
+
+	/**
+	 * Replaces the references of the database.
+	 */
+	void SetDatabase(const RPG::Database& db);
+
+	/**
+	 * Replaces the references of a map.
+	 */
+	void SetMap(int map_id, const RPG::Map& map);
+
+	/**
+	 * Replaces the references of a file with collected ones.
+	 *
+	 * @param map_id ID of the map, 0 for the database.
+	 * @param refs references, their map_id is ignored.
+	 */
+	void SetReferences(int map_id, const std::vector<Reference>& refs);
+
+	/**
+	 * Removes the references of a map, 0 for the database.
+	 */
+	void RemoveMap(int map_id);
+
+	void Clear();
+
+	/**
+	 * Returns all uses of a switch, variable, item, actor or common
+	 * event. Uses within a file are in file order, files are in no
+	 * particular order.
+	 */
+	const std::vector<Reference>& Find(Kind kind, int id) const;
+
+	/**
+	 * Returns the references of a file, empty if it was not indexed.
+	 */
+	const std::vector<Reference>& GetReferences(int map_id) const;
+
+	/**
+	 * Saves the index to a file.
+	 */
+	bool Save(const std::string& filename) const;
+
+	/**
+	 * Loads an index saved with Save, replacing the current one.
+	 */
+	bool Load(const std::string& filename);
+
+private:
+	static uint64_t Key(int kind, int id);
+	void AddPostings(const std::vector<Reference>& refs);
+	void RemovePostings(int map_id, const std::vector<Reference>& refs);
+
+	/** References per map ID, in file order. */
+	std::map<int, std::vector<Reference> > files;
+	/** References per kind and ID. */
+	std::unordered_map<uint64_t, std::vector<Reference> > postings;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include <cassert>
+#include <cstdlib>
+#include <vector>
+#include "area_index.h"
+
+static RPG::MapInfo MakeArea(int id, int parent, int l, int t, int r, int b, int troop_id) {
+	RPG::MapInfo area;
+	area.ID = id;
+	area.parent_map = parent;
+	area.type = 2;
+	area.area_rect.l = l;
+	area.area_rect.t = t;
+	area.area_rect.r = r;
+	area.area_rect.b = b;
+	area.encounters.resize(1);
+	area.encounters[0].troop_id = troop_id;
+	return area;
+}
+
+int main() {
+	RPG::TreeMap treemap;
+	treemap.maps.resize(3);
+	treemap.maps[0].ID = 0;
+	treemap.maps[0].type = 0;
+	treemap.maps[1].ID = 1;
+	treemap.maps[1].type = 1;
+	treemap.maps[1].encounters.resize(1);
+	treemap.maps[1].encounters[0].troop_id = 1;
+	treemap.maps[2].ID = 2;
+	treemap.maps[2].type = 1;
+	treemap.maps.push_back(MakeArea(3, 1, 0, 0, 10, 10, 3));
+	treemap.maps.push_back(MakeArea(4, 1, 5, 5, 20, 8, 4));
+	treemap.maps.push_back(MakeArea(5, 2, 0, 0, 30, 30, 5));
+	treemap.maps.push_back(MakeArea(6, 1, 4, 4, 4, 9, 6));
+	treemap.maps.push_back(MakeArea(7, 1, 600, 600, 700, 700, 7));
+
+	AreaIndex index(treemap);
+	std::vector<const RPG::MapInfo*> areas;
+	index.GetAreas(1, 6, 6, areas);
+	assert(areas.size() == 2 && areas[0]->ID == 3 && areas[1]->ID == 4);
+	// Right and bottom edges are outside
+	index.GetAreas(1, 10, 6, areas);
+	assert(areas.size() == 1 && areas[0]->ID == 4);
+	index.GetAreas(1, 6, 8, areas);
+	assert(areas.size() == 1 && areas[0]->ID == 3);
+	index.GetAreas(1, 25, 25, areas);
+	assert(areas.empty());
+	index.GetAreas(1, -1, 0, areas);
+	assert(areas.empty());
+	index.GetAreas(1, 650, 699, areas);
+	assert(areas.size() == 1 && areas[0]->ID == 7);
+	index.GetAreas(2, 6, 6, areas);
+	assert(areas.size() == 1 && areas[0]->ID == 5);
+	index.GetAreas(0, 6, 6, areas);
+	assert(areas.empty());
+
+	std::vector<int> troops;
+	index.GetTroops(1, 6, 6, troops);
+	assert(troops == std::vector<int>({ 1, 3, 4 }));
+	index.GetTroops(1, 30, 30, troops);
+	assert(troops == std::vector<int>({ 1 }));
+	index.GetTroops(9, 0, 0, troops);
+	assert(troops.empty());
+
+	// Same result as checking every area
+	srand(1);
+	RPG::TreeMap random;
+	random.maps.resize(1);
+	random.maps[0].ID = 1;
+	for (int i = 0; i < 200; i++) {
+		int l = rand() % 100;
+		int t = rand() % 100;
+		random.maps.push_back(MakeArea(i + 2, 1, l, t, l + rand() % 30, t + rand() % 30, i));
+	}
+	AreaIndex random_index(random);
+	for (int y = 0; y < 130; y += 3) {
+		for (int x = 0; x < 130; x += 3) {
+			random_index.GetAreas(1, x, y, areas);
+			std::vector<const RPG::MapInfo*> expected;
+			for (size_t i = 1; i < random.maps.size(); i++) {
+				const RPG::Rect& rect = random.maps[i].area_rect;
+				if ((uint32_t) x >= rect.l && (uint32_t) x < rect.r && (uint32_t) y >= rect.t && (uint32_t) y < rect.b)
+					expected.push_back(&random.maps[i]);
+			}
+			assert(areas == expected);
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
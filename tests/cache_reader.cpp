@@ -0,0 +1,64 @@
+#include <cassert>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include "cache_reader.h"
+#include "lmu_reader.h"
+#include "rpg_map.h"
+
+static RPG::Map MakeMap() {
+	RPG::Map map;
+	map.width = 30;
+	map.height = 20;
+	map.lower_layer.assign(30 * 20, 5000);
+	map.upper_layer.assign(30 * 20, 10000);
+	map.events.resize(2);
+	for (int i = 0; i < 2; i++) {
+		RPG::Event& event = map.events[i];
+		event.ID = i + 1;
+		event.name = "Ereignis \xc3\xa4\xc3\xb6\xc3\xbc";
+		event.pages.resize(1);
+		event.pages[0].event_commands.resize(1);
+		event.pages[0].event_commands[0].code = 10110;
+		event.pages[0].event_commands[0].string = "Hello";
+		event.pages[0].event_commands[0].parameters.assign(3, -7);
+	}
+	return map;
+}
+
+int main() {
+	const char* source = "test_cache_reader.lmu";
+	const char* cache = "test_cache_reader.cache";
+
+	RPG::Map map = MakeMap();
+	assert(LMU_Reader::Save(source, map, ""));
+	assert(Cache_Reader::SaveMap(cache, map, source));
+	assert(Cache_Reader::IsValid(cache, source));
+
+	std::unique_ptr<RPG::Map> loaded = Cache_Reader::LoadMap(cache, source);
+	assert(loaded);
+	assert(loaded->width == 30 && loaded->height == 20);
+	assert(loaded->lower_layer == map.lower_layer);
+	assert(loaded->upper_layer == map.upper_layer);
+	assert(loaded->events.size() == 2);
+	assert(loaded->events[1].ID == 2);
+	assert(loaded->events[1].name == map.events[1].name);
+	const RPG::EventCommand& cmd = loaded->events[1].pages[0].event_commands[0];
+	assert(cmd.code == 10110 && cmd.string == "Hello");
+	assert(cmd.parameters == map.events[1].pages[0].event_commands[0].parameters);
+
+	// Wrong kind
+	assert(!Cache_Reader::LoadTreeMap(cache, source));
+
+	// A changed source invalidates the cache
+	map.width = 31;
+	map.lower_layer.resize(31 * 20);
+	assert(LMU_Reader::Save(source, map, ""));
+	assert(!Cache_Reader::IsValid(cache, source));
+	assert(!Cache_Reader::LoadMap(cache, source));
+
+	remove(source);
+	remove(cache);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,130 @@
+#include <cassert>
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+#include "compiled_move_route.h"
+#include "lmu_chunks.h"
+#include "reader_struct.h"
+#include "writer_lcf.h"
+
+typedef RPG::MoveCommand::Code Code;
+
+static RPG::MoveCommand MakeCommand(int code, const std::string& string = "", int a = 0, int b = 0, int c = 0) {
+	RPG::MoveCommand command;
+	command.command_id = code;
+	command.parameter_string = string;
+	command.parameter_a = a;
+	command.parameter_b = b;
+	command.parameter_c = c;
+	return command;
+}
+
+static bool Equal(const std::vector<RPG::MoveCommand>& a, const std::vector<RPG::MoveCommand>& b) {
+	if (a.size() != b.size())
+		return false;
+	for (size_t i = 0; i < a.size(); i++) {
+		if (a[i].command_id != b[i].command_id || a[i].parameter_string != b[i].parameter_string ||
+			a[i].parameter_a != b[i].parameter_a || a[i].parameter_b != b[i].parameter_b ||
+			a[i].parameter_c != b[i].parameter_c)
+			return false;
+	}
+	return true;
+}
+
+int main() {
+	std::vector<RPG::MoveCommand> commands;
+	commands.push_back(MakeCommand(Code::move_up));
+	commands.push_back(MakeCommand(Code::switch_on, "", 300));
+	commands.push_back(MakeCommand(Code::change_graphic, "Hero", 3));
+	commands.push_back(MakeCommand(Code::play_sound_effect, "Step", 100, 150, 50));
+	commands.push_back(MakeCommand(Code::change_graphic, "Hero", 5));
+	commands.push_back(MakeCommand(Code::wait));
+	commands.push_back(MakeCommand(1000));
+	commands.push_back(MakeCommand(-1));
+
+	MoveRouteStrings strings;
+	CompiledMoveRoute route(commands, strings);
+	assert(route.Size() == 8 && !route.Empty());
+	assert(strings.Size() == 2 && strings.Get(0) == "Hero");
+
+	std::vector<RPG::MoveCommand> back;
+	route.ToVector(strings, back);
+	assert(Equal(back, commands));
+
+	// Stepping through the byte stream
+	CompiledMoveRoute::Command command;
+	size_t position = route.Step(0, command);
+	assert(command.code == Code::move_up && command.string_id == -1 && position == 1);
+	position = route.Step(position, command);
+	assert(command.code == Code::switch_on && command.parameter_a == 300);
+	position = route.Step(position, command);
+	assert(command.code == Code::change_graphic && strings.Get(command.string_id) == "Hero");
+	assert(route.GetPosition(3) == position);
+	assert(route.GetPosition(8) == route.CodeSize());
+	assert(route.GetPosition(20) == route.CodeSize());
+	position = route.Step(route.GetPosition(6), command);
+	assert(command.code == 1000);
+	position = route.Step(position, command);
+	assert(command.code == -1 && position == route.CodeSize());
+
+	// Same strings in a second route
+	CompiledMoveRoute other;
+	other.Add(MakeCommand(Code::play_sound_effect, "Step", 1, 2, 3), strings);
+	assert(strings.Size() == 2);
+	other.Clear();
+	assert(other.Empty() && other.CodeSize() == 0);
+
+	// Only the parameters used by a code are kept, as in LCF
+	commands.push_back(MakeCommand(Code::move_down, "unused", 1, 2, 3));
+	route.Assign(commands, strings);
+	route.ToVector(strings, back);
+	commands.back() = MakeCommand(Code::move_down);
+	assert(Equal(back, commands));
+
+	// LCF chunk read directly into the route
+	const char* file = "test_compiled_move_route.lcf";
+	{
+		RPG::MoveRoute move_route;
+		move_route.move_commands = commands;
+		LcfWriter writer(file, "");
+		assert(writer.IsOk());
+		Struct<RPG::MoveRoute>::WriteLcf(move_route, writer);
+	}
+	FILE* stream = fopen(file, "rb");
+	assert(stream != NULL);
+	std::vector<char> data;
+	for (int ch = fgetc(stream); ch != EOF; ch = fgetc(stream))
+		data.push_back((char) ch);
+	fclose(stream);
+	remove(file);
+
+	LcfReader reader(&data.front(), data.size());
+	CompiledMoveRoute read;
+	for (;;) {
+		int id = reader.ReadInt();
+		assert(id != 0);
+		uint32_t length = reader.ReadInt();
+		if (id == LMU_Reader::ChunkMoveRoute::move_commands) {
+			read.ReadLcf(reader, length, strings);
+			break;
+		}
+		reader.Seek(length, LcfReader::FromCurrent);
+	}
+	read.ToVector(strings, back);
+	assert(Equal(back, commands));
+
+	RPG::Map map;
+	map.events.resize(2);
+	map.events[0].pages.resize(1);
+	map.events[0].pages[0].move_route.move_commands = commands;
+	map.events[1].pages.resize(2);
+	map.events[1].pages[1].move_route.move_commands.push_back(MakeCommand(Code::change_graphic, "Monster", 0));
+	MoveRouteStrings map_strings;
+	std::vector<std::vector<CompiledMoveRoute> > routes = CompiledMoveRoute::Compile(map, map_strings);
+	assert(routes.size() == 2 && routes[0].size() == 1 && routes[1].size() == 2);
+	assert(routes[0][0].Size() == commands.size());
+	assert(routes[1][0].Empty() && routes[1][1].Size() == 1);
+	assert(map_strings.Size() == 3 && map_strings.Get(2) == "Monster");
+
+	return EXIT_SUCCESS;
+}
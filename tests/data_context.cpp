@@ -0,0 +1,94 @@
+#include <cassert>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include "data.h"
+#include "ldb_reader.h"
+#include "lmt_reader.h"
+#include "rpg_save.h"
+
+static void MakeGame(Data::Context& context, const std::string& name, int actors, int switches) {
+	RPG::Database& db = context.data;
+	db.system.ldb_id = 2003;
+	db.system.system_name = name;
+	db.system.party.push_back(1);
+	db.actors.resize(actors);
+	for (int i = 0; i < actors; i++) {
+		db.actors[i].ID = i + 1;
+		db.actors[i].name = name + " Actor";
+		db.actors[i].class_id = i + 1;
+	}
+	db.switches.resize(switches);
+	for (int i = 0; i < switches; i++)
+		db.switches[i].ID = i + 1;
+
+	context.treemap.maps.resize(1);
+	context.treemap.maps[0].name = name;
+	context.treemap.tree_order.push_back(0);
+}
+
+int main() {
+	const char* ldb_a = "test_data_context_a.ldb";
+	const char* ldb_b = "test_data_context_b.ldb";
+	const char* lmt_a = "test_data_context_a.lmt";
+
+	Data::Context game_a;
+	Data::Context game_b;
+	MakeGame(game_a, "Alpha", 2, 10);
+	MakeGame(game_b, "Beta", 3, 20);
+	assert(LDB_Reader::Save(ldb_a, game_a.data, ""));
+	assert(LDB_Reader::Save(ldb_b, game_b.data, ""));
+	assert(LMT_Reader::Save(lmt_a, game_a.treemap, ""));
+
+	// Loading into contexts leaves the default context alone
+	Data::Clear();
+	Data::Context loaded_a;
+	Data::Context loaded_b;
+	assert(LDB_Reader::Load(ldb_a, "", loaded_a.data));
+	assert(LDB_Reader::Load(ldb_b, "", loaded_b.data));
+	assert(LMT_Reader::Load(lmt_a, "", loaded_a.treemap));
+	assert(Data::actors.empty() && Data::treemap.maps.empty());
+	assert(loaded_a.data.actors.size() == 2 && loaded_b.data.actors.size() == 3);
+	assert(loaded_a.data.system.system_name == "Alpha");
+	assert(loaded_b.data.system.system_name == "Beta");
+	assert(loaded_a.treemap.maps.size() == 1 && loaded_a.treemap.maps[0].name == "Alpha");
+	// Actor defaults come from the engine of the loaded database
+	assert(loaded_a.data.actors[0].final_level == 99);
+
+	// Setup and fixup use the given database
+	RPG::Save save;
+	save.Setup(loaded_b.data);
+	assert(save.actors.size() == 3);
+	assert(save.actors[2].ID == 3 && save.actors[2].name == "Beta Actor");
+	assert(save.system.switches.size() == 20);
+	assert(save.system.graphics_name == "Beta");
+
+	save.system.graphics_name.clear();
+	save.system.switches.resize(5);
+	save.system.Fixup(loaded_a.data);
+	assert(save.system.graphics_name == "Alpha");
+	assert(save.system.switches.size() == 10);
+
+	save.actors[0].name = "\x1";
+	save.actors[0].class_id = -1;
+	save.actors[0].Fixup(loaded_a.data.actors[0]);
+	assert(save.actors[0].name == "Alpha Actor");
+	assert(save.actors[0].class_id == 1);
+
+	save.inventory.Setup(loaded_a.data.system);
+	assert(save.inventory.party_size == 1);
+
+	// The default context still works through the old interface
+	assert(LDB_Reader::Load(ldb_a, ""));
+	assert(&Data::data == &Data::context.data);
+	assert(Data::system.system_name == "Alpha");
+	save.Setup();
+	assert(save.actors.size() == 2);
+	Data::context.Clear();
+	assert(Data::actors.empty());
+
+	remove(ldb_a);
+	remove(ldb_b);
+	remove(lmt_a);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,78 @@
+#include <cassert>
+#include <cstdlib>
+#include <vector>
+#include "data.h"
+#include "data_index.h"
+#include "rpg_save.h"
+
+int main() {
+	// In ID order
+	std::vector<RPG::Item> items(10);
+	for (int i = 0; i < 10; i++)
+		items[i].ID = i + 1;
+	IDIndex<RPG::Item> item_index(items);
+	assert(item_index.Get(1) == &items[0]);
+	assert(item_index.Get(10) == &items[9]);
+	assert(item_index.Get(0) == NULL);
+	assert(item_index.Get(-1) == NULL);
+	assert(item_index.Get(11) == NULL);
+
+	// Sparse and reordered, with a duplicate and a huge ID
+	std::vector<RPG::Skill> skills(5);
+	skills[0].ID = 7;
+	skills[1].ID = 3;
+	skills[2].ID = 3;
+	skills[3].ID = 0;
+	skills[4].ID = 1000000;
+	IDIndex<RPG::Skill> skill_index(skills);
+	assert(skill_index.Get(7) == &skills[0]);
+	assert(skill_index.Get(3) == &skills[1]);
+	assert(skill_index.Get(1000000) == &skills[4]);
+	assert(!skill_index.Has(0));
+	assert(!skill_index.Has(1));
+	assert(!skill_index.Has(4));
+	assert(!skill_index.Has(999999));
+	assert(IDIndex<RPG::Skill>::Find(skills, 7) == &skills[0]);
+	assert(IDIndex<RPG::Skill>::Find(skills, 1000000) == &skills[4]);
+	assert(IDIndex<RPG::Skill>::Find(skills, 2) == NULL);
+
+	// Empty
+	IDIndex<RPG::Troop> troop_index;
+	assert(troop_index.Get(1) == NULL);
+	troop_index.Build(std::vector<RPG::Troop>());
+	assert(troop_index.Get(1) == NULL);
+
+	// Whole database
+	RPG::Database db;
+	db.actors.resize(2);
+	db.actors[0].ID = 2;
+	db.actors[0].name = "Second";
+	db.actors[1].ID = 1;
+	db.actors[1].name = "First";
+	db.switches.resize(3);
+	for (int i = 0; i < 3; i++)
+		db.switches[i].ID = i + 1;
+	DatabaseIndex index(db);
+	assert(index.actors.Get(1)->name == "First");
+	assert(index.actors.Get(2)->name == "Second");
+	assert(index.switches.Get(3) == &db.switches[2]);
+	assert(index.items.Get(1) == NULL);
+
+	// Setup and fixup look actors up by ID
+	Data::actors = db.actors;
+	RPG::SaveActor actor;
+	actor.Setup(1);
+	assert(actor.ID == 1 && actor.name == "First");
+	actor.name = "\x1";
+	actor.Fixup(2);
+	assert(actor.ID == 2 && actor.name == "Second");
+	// Missing actors do not read out of bounds
+	actor.Setup(5);
+	assert(actor.ID == 5 && actor.name.empty());
+	actor.name = "\x1";
+	actor.Fixup(6);
+	assert(actor.ID == 6 && actor.name == "\x1");
+	Data::Clear();
+
+	return EXIT_SUCCESS;
+}
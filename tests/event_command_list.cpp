@@ -0,0 +1,114 @@
+#include <cassert>
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+#include "event_command_list.h"
+#include "reader_lcf.h"
+#include "reader_struct.h"
+#include "rpg_commonevent.h"
+#include "writer_lcf.h"
+
+static std::vector<RPG::EventCommand> MakeCommands() {
+	std::vector<RPG::EventCommand> commands(4);
+	commands[0].code = RPG::EventCommand::Code::ShowMessage;
+	commands[0].string = "Hello \xc3\xa4";
+	commands[1].code = RPG::EventCommand::Code::ControlSwitches;
+	commands[1].indent = 1;
+	commands[1].parameters.push_back(0);
+	commands[1].parameters.push_back(-5);
+	commands[1].parameters.push_back(100000);
+	commands[2].code = RPG::EventCommand::Code::Wait;
+	commands[2].indent = 1;
+	commands[2].parameters.push_back(10);
+	commands[3].code = RPG::EventCommand::Code::END;
+	return commands;
+}
+
+/**
+ * Reads a whole file into memory.
+ */
+static std::vector<char> ReadFile(const char* file) {
+	FILE* stream = fopen(file, "rb");
+	assert(stream != NULL);
+	std::vector<char> data;
+	for (int ch = fgetc(stream); ch != EOF; ch = fgetc(stream))
+		data.push_back((char) ch);
+	fclose(stream);
+	return data;
+}
+
+static bool Equal(const std::vector<RPG::EventCommand>& a, const std::vector<RPG::EventCommand>& b) {
+	if (a.size() != b.size())
+		return false;
+	for (size_t i = 0; i < a.size(); i++) {
+		if (a[i].code != b[i].code || a[i].indent != b[i].indent ||
+			a[i].string != b[i].string || a[i].parameters != b[i].parameters)
+			return false;
+	}
+	return true;
+}
+
+int main() {
+	std::vector<RPG::EventCommand> commands = MakeCommands();
+	EventCommandList list(commands);
+	assert(list.Size() == 4);
+	assert(list.GetCode(1) == RPG::EventCommand::Code::ControlSwitches);
+	assert(list.GetIndent(1) == 1);
+	assert(list.GetString(0) == "Hello \xc3\xa4");
+	assert(list.GetStringSize(1) == 0);
+	assert(list.GetParameterCount(0) == 0);
+	assert(list.GetParameterCount(1) == 3);
+	assert(list.GetParameters(1)[2] == 100000);
+	assert(list.GetParameter(1, 1) == -5);
+	assert(list.GetParameter(2, 5, -1) == -1);
+	assert(Equal(list.ToVector(), commands));
+
+	EventCommandList empty;
+	assert(empty.Empty() && empty.ToVector().empty());
+
+	// LCF round trip, decoding straight into the list
+	const char* file = "test_event_command_list.lcf";
+	{
+		LcfWriter writer(file, "");
+		assert(writer.IsOk());
+		list.WriteLcf(writer);
+	}
+	std::vector<char> data = ReadFile(file);
+	remove(file);
+
+	LcfReader reader(&data.front(), data.size());
+	EventCommandList read;
+	read.Add(commands[0]);
+	read.ReadLcf(reader, data.size());
+	assert(reader.Tell() == data.size());
+	assert(Equal(read.ToVector(), commands));
+	size_t available;
+	assert(reader.Peek(available) == &data.front() + data.size() && available == 0);
+
+	// Vector form, scanned in memory and read from a file
+	RPG::CommonEvent event;
+	event.ID = 1;
+	for (int i = 0; i < 50; i++)
+		event.event_commands.insert(event.event_commands.end(), commands.begin(), commands.end());
+	{
+		LcfWriter writer(file, "");
+		Struct<RPG::CommonEvent>::WriteLcf(event, writer);
+	}
+	data = ReadFile(file);
+
+	LcfReader memory_reader(&data.front(), data.size());
+	assert(memory_reader.Peek(available) == &data.front() && available == data.size());
+	RPG::CommonEvent from_memory;
+	Struct<RPG::CommonEvent>::ReadLcf(from_memory, memory_reader);
+	assert(Equal(from_memory.event_commands, event.event_commands));
+	assert(from_memory.event_commands.capacity() == event.event_commands.size());
+
+	LcfReader file_reader(file, "");
+	assert(file_reader.Peek(available) == NULL && available == 0);
+	RPG::CommonEvent from_file;
+	Struct<RPG::CommonEvent>::ReadLcf(from_file, file_reader);
+	assert(Equal(from_file.event_commands, event.event_commands));
+	remove(file);
+
+	return EXIT_SUCCESS;
+}
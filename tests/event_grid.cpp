@@ -0,0 +1,127 @@
+#include <cassert>
+#include <climits>
+#include <cstdlib>
+#include <vector>
+#include "event_grid.h"
+
+int main() {
+	std::vector<RPG::Event> events(5);
+	int positions[5][2] = { { 3, 3 }, { 3, 3 }, { 10, 3 }, { 0, 0 }, { 40, 40 } };
+	for (int i = 0; i < 5; i++) {
+		events[i].ID = i + 1;
+		events[i].x = positions[i][0];
+		events[i].y = positions[i][1];
+	}
+
+	MapEventGrid grid(events);
+	std::vector<RPG::Event*> found;
+	grid.GetAt(3, 3, found);
+	assert(found.size() == 2 && found[0] == &events[0] && found[1] == &events[1]);
+	grid.GetAt(4, 3, found);
+	assert(found.empty());
+	grid.GetAt(-5, 100, found);
+	assert(found.empty());
+
+	grid.GetInRadius(3, 3, 7, found);
+	assert(found.size() == 4 && found[2] == &events[2] && found[3] == &events[3]);
+	grid.GetInRadius(3, 3, 5, found);
+	assert(found.size() == 3 && found[2] == &events[3]);
+	grid.GetInRadius(3, 3, 4, found);
+	assert(found.size() == 2);
+	grid.GetInRadius(3, 3, 0, found);
+	assert(found.size() == 2);
+	grid.GetInRadius(3, 3, -1, found);
+	assert(found.empty());
+
+	// Moving across cells
+	assert(grid.Move(5, 4, 3));
+	assert(events[4].x == 4 && events[4].y == 3);
+	grid.GetAt(4, 3, found);
+	assert(found.size() == 1 && found[0] == &events[4]);
+	grid.GetAt(40, 40, found);
+	assert(found.empty());
+	assert(!grid.Move(9, 0, 0));
+
+	// Positions changed directly
+	events[0].x = -3;
+	assert(grid.Update(1));
+	grid.GetAt(-3, 3, found);
+	assert(found.size() == 1 && found[0] == &events[0]);
+	grid.GetInRadius(-1, 3, 2, found);
+	assert(found.size() == 1 && found[0] == &events[0]);
+
+	// Huge radii only visit occupied cells
+	grid.GetInRadius(3, 3, INT_MAX, found);
+	assert(found.size() == 5);
+	grid.GetInRadius(0, 0, 1000000, found);
+	assert(found.size() == 5);
+	grid.GetInRadius(INT_MAX, INT_MIN, INT_MAX, found);
+	assert(found.empty());
+
+	// Positions near the ends of int
+	std::vector<RPG::Event> far(3);
+	int far_positions[3][2] = { { INT_MIN, INT_MIN + 5 }, { INT_MIN + 3, -4 }, { INT_MAX, INT_MAX } };
+	for (int i = 0; i < 3; i++) {
+		far[i].ID = i + 1;
+		far[i].x = far_positions[i][0];
+		far[i].y = far_positions[i][1];
+	}
+	MapEventGrid far_grid(far);
+	far_grid.GetAt(INT_MIN, INT_MIN + 5, found);
+	assert(found.size() == 1 && found[0] == &far[0]);
+	far_grid.GetInRadius(INT_MIN + 1, INT_MIN + 1, 5, found);
+	assert(found.size() == 1 && found[0] == &far[0]);
+	far_grid.GetInRadius(INT_MIN, INT_MIN, 3, found);
+	assert(found.empty());
+	far_grid.GetInRadius(INT_MIN, -4, 3, found);
+	assert(found.size() == 1 && found[0] == &far[1]);
+	far_grid.GetInRadius(INT_MAX - 2, INT_MAX, 2, found);
+	assert(found.size() == 1 && found[0] == &far[2]);
+	far_grid.GetInRadius(0, 0, INT_MAX, found);
+	assert(found.size() == 1 && found[0] == &far[1]);
+	far_grid.GetInRadius(INT_MIN, INT_MIN, INT_MAX, found);
+	assert(found.size() == 2 && found[0] == &far[0] && found[1] == &far[1]);
+
+	// Save events use position_x and position_y
+	std::vector<RPG::SaveMapEvent> save_events(2);
+	save_events[0].ID = 1;
+	save_events[0].position_x = 7;
+	save_events[0].position_y = 8;
+	save_events[1].ID = 2;
+	save_events[1].position_x = 100;
+	save_events[1].position_y = 8;
+	SaveEventGrid save_grid(save_events);
+	std::vector<RPG::SaveMapEvent*> save_found;
+	save_grid.GetAt(7, 8, save_found);
+	assert(save_found.size() == 1 && save_found[0] == &save_events[0]);
+	assert(save_grid.Move(2, 7, 8));
+	save_grid.GetAt(7, 8, save_found);
+	assert(save_found.size() == 2);
+
+	// Same result as checking every event
+	srand(1);
+	std::vector<RPG::Event> many(500);
+	for (int i = 0; i < 500; i++) {
+		many[i].ID = i + 1;
+		many[i].x = rand() % 100;
+		many[i].y = rand() % 100;
+	}
+	MapEventGrid many_grid(many);
+	for (int i = 0; i < 200; i++)
+		many_grid.Move(rand() % 500 + 1, rand() % 100, rand() % 100);
+	for (int y = 0; y < 100; y += 7) {
+		for (int x = 0; x < 100; x += 7) {
+			many_grid.GetInRadius(x, y, 9, found);
+			std::vector<RPG::Event*> expected;
+			for (size_t i = 0; i < many.size(); i++) {
+				int dx = many[i].x - x;
+				int dy = many[i].y - y;
+				if (dx * dx + dy * dy <= 81)
+					expected.push_back(&many[i]);
+			}
+			assert(found == expected);
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+#include <cassert>
+#include <cstdlib>
+#include <vector>
+#include "event_command_list.h"
+#include "event_jump_table.h"
+
+typedef RPG::EventCommand::Code Code;
+
+static void Add(std::vector<RPG::EventCommand>& commands, int code, int indent, int parameter = 0) {
+	RPG::EventCommand command;
+	command.code = code;
+	command.indent = indent;
+	command.parameters.push_back(parameter);
+	commands.push_back(command);
+}
+
+int main() {
+	std::vector<RPG::EventCommand> commands;
+	Add(commands, Code::Label, 0, 1);                // 0
+	Add(commands, Code::ConditionalBranch, 0);       // 1
+	Add(commands, Code::Loop, 1);                    // 2
+	Add(commands, Code::ConditionalBranch, 2);       // 3
+	Add(commands, Code::BreakLoop, 3);               // 4
+	Add(commands, Code::END, 3);                     // 5
+	Add(commands, Code::EndBranch, 2);               // 6
+	Add(commands, Code::END, 2);                     // 7
+	Add(commands, Code::EndLoop, 1);                 // 8
+	Add(commands, Code::END, 1);                     // 9
+	Add(commands, Code::ElseBranch, 0);              // 10
+	Add(commands, Code::ShowChoice, 1);              // 11
+	Add(commands, Code::ShowChoiceOption, 1);        // 12
+	Add(commands, Code::JumpToLabel, 2, 1);          // 13
+	Add(commands, Code::END, 2);                     // 14
+	Add(commands, Code::ShowChoiceOption, 1);        // 15
+	Add(commands, Code::JumpToLabel, 2, 7);          // 16
+	Add(commands, Code::END, 2);                     // 17
+	Add(commands, Code::ShowChoiceEnd, 1);           // 18
+	Add(commands, Code::END, 1);                     // 19
+	Add(commands, Code::EndBranch, 0);               // 20
+	Add(commands, Code::Label, 0, 1);                // 21
+	Add(commands, Code::END, 0);                     // 22
+
+	EventJumpTable table(commands);
+	assert(table.GetJump(1) == 10);
+	assert(table.GetJump(10) == 20);
+	assert(table.GetJump(2) == 8);
+	assert(table.GetJump(8) == 2);
+	assert(table.GetJump(3) == 6);
+	assert(table.GetJump(4) == 8);
+	assert(table.GetJump(11) == 12);
+	assert(table.GetJump(12) == 15);
+	assert(table.GetJump(15) == 18);
+	assert(table.GetJump(13) == 0);
+	assert(table.GetJump(16) == -1);
+	assert(table.GetJump(5) == -1);
+	assert(table.GetJump(100) == -1);
+	assert(table.GetNext(5) == -1);
+	assert(table.GetNext(0) == 1);
+	assert(table.GetLabel(1) == 0);
+	assert(table.GetLabel(7) == -1);
+
+	// Same result from the flat list
+	EventCommandList list(commands);
+	EventJumpTable flat(list);
+	for (size_t i = 0; i < commands.size(); i++) {
+		assert(flat.GetJump(i) == table.GetJump(i));
+		assert(flat.GetNext(i) == table.GetNext(i));
+	}
+
+	// Broken structure: loop without EndLoop
+	std::vector<RPG::EventCommand> broken;
+	Add(broken, Code::Loop, 0);
+	Add(broken, Code::BreakLoop, 1);
+	Add(broken, Code::END, 0);
+	EventJumpTable broken_table(broken);
+	assert(broken_table.GetJump(0) == 2);
+	assert(broken_table.GetJump(1) == -1);
+
+	// Whole map and common events
+	RPG::Map map;
+	map.events.resize(2);
+	map.events[1].pages.resize(2);
+	map.events[1].pages[1].event_commands = commands;
+	std::vector<std::vector<EventJumpTable> > map_tables = EventJumpTable::Build(map);
+	assert(map_tables.size() == 2 && map_tables[0].empty() && map_tables[1].size() == 2);
+	assert(map_tables[1][1].GetJump(1) == 10);
+	assert(map_tables[1][0].GetJump(1) == -1);
+
+	std::vector<RPG::CommonEvent> commonevents(1);
+	commonevents[0].event_commands = commands;
+	std::vector<EventJumpTable> common_tables = EventJumpTable::Build(commonevents);
+	assert(common_tables.size() == 1 && common_tables[0].GetJump(2) == 8);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,71 @@
+#include <cassert>
+#include <cstdlib>
+#include <string>
+#include "heap_usage.h"
+#include "rpg_database.h"
+#include "rpg_map.h"
+
+int main() {
+	RPG::Database db;
+	db.actors.resize(2);
+	db.actors.shrink_to_fit();
+	// Short names fit into the string object
+	db.actors[0].name = "Alex";
+	db.actors[1].name = std::string(100, 'x');
+	db.commonevents.resize(1);
+	db.commonevents.shrink_to_fit();
+	db.commonevents[0].event_commands.resize(3);
+	db.commonevents[0].event_commands.shrink_to_fit();
+	// Up to 4 parameters are stored inside the command
+	db.commonevents[0].event_commands[0].parameters.assign(4, 1);
+	db.commonevents[0].event_commands[1].parameters.assign(10, 1);
+	db.commonevents[0].event_commands[1].parameters.shrink_to_fit();
+
+	HeapUsage usage = HeapUsage::Of(db);
+
+	HeapUsage::Entry entry;
+	assert(usage.Get("Actor", entry));
+	assert(entry.objects == 2);
+	assert(entry.string_bytes == db.actors[1].name.capacity() + 1);
+	// Names and the vector of actors
+	assert(entry.allocations == 2);
+	assert(entry.bytes == entry.string_bytes + 2 * sizeof(RPG::Actor));
+
+	assert(usage.Get("EventCommand", entry));
+	assert(entry.objects == 3);
+	assert(entry.allocations == 2);
+	assert(entry.bytes == 3 * sizeof(RPG::EventCommand) + 10 * sizeof(int));
+
+	assert(usage.Get("Database", entry));
+	assert(entry.objects == 1);
+	assert(!usage.Get("Map", entry));
+
+	// Sections add up to the whole database
+	std::vector<HeapUsage::Entry> sections = HeapUsage::Sections(db);
+	unsigned long long bytes = 0;
+	uint32_t allocations = 0;
+	bool found = false;
+	for (size_t i = 0; i < sections.size(); i++) {
+		bytes += sections[i].bytes;
+		allocations += sections[i].allocations;
+		if (sections[i].name == "commonevents") {
+			found = true;
+			assert(sections[i].objects == 4);
+		}
+	}
+	assert(found);
+	assert(bytes == usage.Bytes());
+	assert(allocations == usage.Allocations());
+
+	// Largest first
+	std::vector<HeapUsage::Entry> types = usage.Get();
+	for (size_t i = 1; i < types.size(); i++)
+		assert(types[i - 1].bytes >= types[i].bytes);
+
+	RPG::Map map;
+	map.lower_layer.assign(100, 5000);
+	map.lower_layer.shrink_to_fit();
+	assert(HeapUsage::Of(map).Bytes() >= 100 * sizeof(int16_t));
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,158 @@
+#include <cassert>
+#include <cstdlib>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "lmt_reader.h"
+#include "lmu_reader.h"
+
+static std::vector<char> ReadFile(const char* file) {
+	FILE* stream = fopen(file, "rb");
+	assert(stream != NULL);
+	std::vector<char> data;
+	for (int ch = fgetc(stream); ch != EOF; ch = fgetc(stream))
+		data.push_back((char) ch);
+	fclose(stream);
+	return data;
+}
+
+static RPG::EventCommand MakeCommand(int code, const std::string& string, int parameters) {
+	RPG::EventCommand command;
+	command.code = code;
+	command.string = string;
+	for (int i = 0; i < parameters; i++)
+		command.parameters.push_back(i * 100);
+	return command;
+}
+
+/**
+ * A map with everything set away from the defaults.
+ */
+static RPG::Map MakeBigMap() {
+	RPG::Map map;
+	map.chipset_id = 3;
+	map.width = 40;
+	map.height = 30;
+	map.parallax_flag = true;
+	map.lower_layer.assign(40 * 30, 5);
+	map.upper_layer.assign(40 * 30, 10000);
+	map.events.resize(10);
+	for (size_t i = 0; i < map.events.size(); i++) {
+		RPG::Event& event = map.events[i];
+		event.ID = (int) i + 1;
+		event.name = "A rather long event name";
+		event.pages.resize(3);
+		for (size_t j = 0; j < event.pages.size(); j++) {
+			RPG::EventPage& page = event.pages[j];
+			page.ID = (int) j + 1;
+			page.character_name = "CharacterSheet";
+			page.condition.flags.switch_a = true;
+			page.condition.switch_a_id = 7;
+			page.move_route.repeat = false;
+			RPG::MoveCommand move;
+			move.command_id = RPG::MoveCommand::Code::change_graphic;
+			move.parameter_string = "Another graphic file";
+			move.parameter_a = 2;
+			page.move_route.move_commands.assign(4, move);
+			for (int k = 0; k < 20; k++)
+				page.event_commands.push_back(MakeCommand(10110, "A message longer than the inline buffer", k % 8));
+		}
+	}
+	return map;
+}
+
+/**
+ * A smaller map leaving most fields at their defaults.
+ */
+static RPG::Map MakeSmallMap() {
+	RPG::Map map;
+	map.lower_layer.assign(20 * 15, 1);
+	map.upper_layer.assign(20 * 15, 10000);
+	map.events.resize(4);
+	for (size_t i = 0; i < map.events.size(); i++) {
+		RPG::Event& event = map.events[i];
+		event.ID = (int) i + 1;
+		event.pages.resize(1);
+		event.pages[0].ID = 1;
+		RPG::MoveCommand move;
+		move.command_id = RPG::MoveCommand::Code::move_up;
+		event.pages[0].move_route.move_commands.push_back(move);
+		event.pages[0].event_commands.push_back(MakeCommand(10110, "Hi", 0));
+	}
+	return map;
+}
+
+/**
+ * Nested structs missing a field get the default their parent gives
+ * them, not the one of their own type.
+ */
+static void LoadParentDefaults() {
+	RPG::TreeMap treemap;
+	treemap.maps.resize(1);
+	treemap.maps[0].ID = 1;
+	treemap.maps[0].music.name = "";
+	treemap.maps[0].music.volume = 80;
+	const char* file = "test_lmu_load_into.lmt";
+	assert(LMT_Reader::Save(file, treemap, ""));
+
+	RPG::TreeMap loaded;
+	assert(LMT_Reader::Load(file, "", loaded));
+	assert(loaded.maps.size() == 1);
+	assert(loaded.maps[0].music.name == "(OFF)");
+	assert(loaded.maps[0].music.volume == 80);
+
+	// Also when reading into a used tree
+	loaded.maps[0].music.name = "Town";
+	loaded.maps[0].music.tempo = 150;
+	assert(LMT_Reader::Load(file, "", loaded));
+	assert(loaded.maps[0].music.name == "(OFF)");
+	assert(loaded.maps[0].music.tempo == 100);
+	remove(file);
+}
+
+int main() {
+	const char* big_file = "test_lmu_load_into_big.lmu";
+	const char* small_file = "test_lmu_load_into_small.lmu";
+	const char* out_file = "test_lmu_load_into_out.lmu";
+	assert(LMU_Reader::Save(big_file, MakeBigMap(), ""));
+	assert(LMU_Reader::Save(small_file, MakeSmallMap(), ""));
+
+	RPG::Map map;
+	assert(LMU_Reader::LoadInto(big_file, "", map));
+	assert(map.events.size() == 10 && map.events[9].pages[2].event_commands.size() == 20);
+
+	// Loading the same map again keeps all storage
+	const RPG::EventPage* pages = &map.events[0].pages.front();
+	const RPG::EventCommand* commands = &map.events[0].pages[0].event_commands.front();
+	const char* string = map.events[0].pages[0].event_commands[0].string.data();
+	const int16_t* layer = &map.lower_layer.front();
+	assert(LMU_Reader::LoadInto(big_file, "", map));
+	assert(&map.events[0].pages.front() == pages);
+	assert(&map.events[0].pages[0].event_commands.front() == commands);
+	assert(map.events[0].pages[0].event_commands[0].string.data() == string);
+	assert(&map.lower_layer.front() == layer);
+
+	// A different map reads the same as into a new object
+	assert(LMU_Reader::LoadInto(small_file, "", map));
+	assert(map.events.size() == 4 && map.events[0].pages.size() == 1);
+	assert(map.chipset_id == 1 && !map.parallax_flag);
+	assert(map.events[0].name.empty());
+	assert(map.events[0].pages[0].character_name.empty());
+	assert(!map.events[0].pages[0].condition.flags.switch_a);
+	assert(map.events[0].pages[0].move_route.repeat);
+	assert(map.events[0].pages[0].move_route.move_commands[0].parameter_string.empty());
+	assert(map.events[0].pages[0].event_commands[0].parameters.empty());
+	assert(LMU_Reader::Save(out_file, map, ""));
+	assert(ReadFile(out_file) == ReadFile(small_file));
+
+	std::unique_ptr<RPG::Map> loaded = LMU_Reader::Load(small_file, "");
+	assert(loaded && loaded->events.size() == 4);
+	assert(!LMU_Reader::LoadInto("missing_map.lmu", "", map));
+
+	remove(big_file);
+	remove(small_file);
+	remove(out_file);
+
+	LoadParentDefaults();
+	return EXIT_SUCCESS;
+}
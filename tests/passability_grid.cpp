@@ -0,0 +1,77 @@
+#include <cassert>
+#include <cstdlib>
+#include "passability_grid.h"
+
+int main() {
+	assert(PassabilityGrid::GetLowerIndex(0) == 0);
+	assert(PassabilityGrid::GetLowerIndex(2999) == 2);
+	assert(PassabilityGrid::GetLowerIndex(3050) == 4);
+	assert(PassabilityGrid::GetLowerIndex(4049) == 6);
+	assert(PassabilityGrid::GetLowerIndex(4599) == 17);
+	assert(PassabilityGrid::GetLowerIndex(5000) == 18);
+	assert(PassabilityGrid::GetLowerIndex(5143) == 161);
+	assert(PassabilityGrid::GetLowerIndex(5144) == -1);
+	assert(PassabilityGrid::GetLowerIndex(-1) == -1);
+	assert(PassabilityGrid::GetUpperIndex(10000) == 0);
+	assert(PassabilityGrid::GetUpperIndex(10143) == 143);
+	assert(PassabilityGrid::GetUpperIndex(10144) == -1);
+	assert(PassabilityGrid::GetUpperIndex(5000) == -1);
+
+	RPG::Chipset chipset;
+	chipset.Init();
+	// Deep water blocks everything, plain tile 1 only allows down and up
+	chipset.passable_data_lower[2] = 0;
+	chipset.passable_data_lower[19] = PassabilityGrid::Passable_down | PassabilityGrid::Passable_up;
+	// Plain tile 2 is drawn above the hero
+	chipset.passable_data_lower[20] = PassabilityGrid::Passable_above;
+	chipset.terrain_data[19] = 7;
+	// Upper tile 1 is a wall, tile 2 is drawn above the hero
+	chipset.passable_data_upper[1] = 0;
+	chipset.passable_data_upper[2] = PassabilityGrid::Passable_above;
+
+	RPG::Map map;
+	map.width = 5;
+	map.height = 3;
+	map.lower_layer.assign(15, 5000);
+	map.upper_layer.assign(15, 10000);
+	map.lower_layer[1] = 2000;
+	map.lower_layer[2] = 5001;
+	map.lower_layer[3] = 5002;
+	map.upper_layer[5] = 10001;
+	map.upper_layer[6] = 10002;
+	map.lower_layer[6] = 5001;
+
+	PassabilityGrid grid(map, chipset);
+	assert(grid.GetWidth() == 5 && grid.GetHeight() == 3);
+	assert(grid.GetPassable(0, 0) == PassabilityGrid::Passable_all);
+	assert(grid.GetPassable(1, 0) == 0);
+	assert(grid.GetPassable(2, 0) == (PassabilityGrid::Passable_down | PassabilityGrid::Passable_up));
+	assert(grid.IsPassable(2, 0, PassabilityGrid::Passable_up));
+	assert(!grid.IsPassable(2, 0, PassabilityGrid::Passable_left));
+	assert(grid.GetPassable(3, 0) == PassabilityGrid::Passable_all);
+	// Upper wall wins, upper tile above the hero falls back to the lower tile
+	assert(grid.GetPassable(0, 1) == 0);
+	assert(grid.GetPassable(1, 1) == (PassabilityGrid::Passable_down | PassabilityGrid::Passable_up));
+	assert(grid.GetPassable(-1, 0) == 0 && grid.GetPassable(5, 0) == 0 && grid.GetPassable(0, 3) == 0);
+
+	assert(grid.GetTerrain(0, 0) == 1);
+	assert(grid.GetTerrain(2, 0) == 7);
+	assert(grid.GetTerrain(9, 9) == 0);
+	assert(grid.GetTerrainData().size() == 15);
+	assert(grid.GetPassableData().size() == 8);
+	// Tile 1 in the high bits of the first byte, tile 2 in the low bits of the second
+	assert((grid.GetPassableData()[0] >> 4) == 0);
+	assert((grid.GetPassableData()[1] & 0x0F) == (PassabilityGrid::Passable_down | PassabilityGrid::Passable_up));
+
+	// Edits update map and grid
+	assert(grid.SetLowerTile(1, 0, 5000));
+	assert(map.lower_layer[1] == 5000);
+	assert(grid.GetPassable(1, 0) == PassabilityGrid::Passable_all);
+	assert(grid.GetPassable(0, 0) == PassabilityGrid::Passable_all);
+	assert(grid.SetUpperTile(4, 2, 10001));
+	assert(grid.GetPassable(4, 2) == 0);
+	assert(grid.GetPassable(3, 2) == PassabilityGrid::Passable_all);
+	assert(!grid.SetUpperTile(5, 2, 10001));
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,98 @@
+#include <cassert>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include "lmu_reader.h"
+#include "reader_stats.h"
+#include "rpg_map.h"
+
+static RPG::Map MakeMap() {
+	RPG::Map map;
+	map.width = 20;
+	map.height = 15;
+	map.lower_layer.assign(20 * 15, 5000);
+	map.upper_layer.assign(20 * 15, 10000);
+	map.events.resize(3);
+	for (int i = 0; i < 3; i++) {
+		RPG::Event& event = map.events[i];
+		event.ID = i + 1;
+		event.name = "EV000" + std::to_string(i + 1);
+		event.pages.resize(2);
+		event.pages[1].event_commands.resize(1);
+		event.pages[1].event_commands[0].code = 10110;
+		event.pages[1].event_commands[0].string = "Hello";
+	}
+	return map;
+}
+
+static long FileSize(const char* filename) {
+	FILE* f = fopen(filename, "rb");
+	assert(f != NULL);
+	fseek(f, 0, SEEK_END);
+	long size = ftell(f);
+	fclose(f);
+	return size;
+}
+
+int main() {
+	const char* filename = "test_reader_stats.lmu";
+	const char* tracefile = "test_reader_stats.json";
+
+	RPG::Map map = MakeMap();
+	assert(LMU_Reader::Save(filename, map, "1252"));
+
+	ReaderStats::Reset();
+	std::unique_ptr<RPG::Map> loaded = LMU_Reader::Load(filename, "1252");
+	assert(loaded);
+	assert(loaded->events.size() == 3);
+
+	if (!ReaderStats::IsEnabled()) {
+		// Built without LCF_INSTRUMENT: nothing is collected
+		assert(ReaderStats::Get().empty());
+		remove(filename);
+		return EXIT_SUCCESS;
+	}
+
+	ReaderStats::Stats stats;
+	assert(ReaderStats::Get("Map", ReaderStats::Read, stats));
+	assert(stats.calls == 1);
+	// Everything but the "LcfMapUnit" header belongs to the map
+	assert((long) stats.bytes == FileSize(filename) - 11);
+	assert(stats.nanoseconds >= stats.self_nanoseconds);
+
+	assert(ReaderStats::Get("Event", ReaderStats::Read, stats));
+	assert(stats.calls == 3);
+	// Event names
+	assert(stats.strings == 3);
+	assert(ReaderStats::Get("EventPage", ReaderStats::Read, stats));
+	assert(stats.calls == 6);
+	// Empty command lists are not written
+	assert(ReaderStats::Get("EventCommands", ReaderStats::Read, stats));
+	assert(stats.calls == 3);
+	assert(ReaderStats::Get("Recode", ReaderStats::Recode, stats));
+	assert(stats.calls >= 4);
+	assert(!ReaderStats::Get("Map", ReaderStats::Write, stats));
+
+	// The map contains everything else
+	std::vector<ReaderStats::Stats> all = ReaderStats::Get();
+	assert(!all.empty());
+	assert(all[0].name == "Map");
+
+	assert(ReaderStats::WriteTrace(tracefile));
+	FILE* f = fopen(tracefile, "r");
+	assert(f != NULL);
+	char head[16] = {};
+	assert(fread(head, 1, 15, f) == 15);
+	fclose(f);
+	assert(std::string(head) == "{\"traceEvents\":");
+
+	ReaderStats::Reset();
+	assert(ReaderStats::Get().empty());
+	assert(LMU_Reader::Save(filename, *loaded, "1252"));
+	assert(ReaderStats::Get("Map", ReaderStats::Write, stats));
+	assert((long) stats.bytes == FileSize(filename) - 11);
+
+	remove(filename);
+	remove(tracefile);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,76 @@
+#include <cassert>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+#include "small_vector.h"
+
+typedef SmallVector<int, 4> Vector;
+
+static bool Equal(const Vector& a, const std::vector<int>& b) {
+	return a.ToVector() == b;
+}
+
+int main() {
+	Vector v;
+	assert(v.empty() && v.IsInline() && v.capacity() == 4);
+	for (int i = 0; i < 4; i++)
+		v.push_back(i);
+	assert(v.IsInline() && v.size() == 4 && v.back() == 3);
+	v.push_back(4);
+	assert(!v.IsInline() && v.size() == 5);
+	assert(Equal(v, { 0, 1, 2, 3, 4 }));
+
+	// Growing from an element of the vector itself
+	v.push_back(v[0]);
+	v.insert(v.begin() + 1, v.begin() + 3, v.end());
+	assert(Equal(v, { 0, 3, 4, 0, 1, 2, 3, 4, 0 }));
+
+	v.erase(v.begin(), v.begin() + 6);
+	assert(Equal(v, { 3, 4, 0 }));
+	v.shrink_to_fit();
+	assert(v.IsInline() && Equal(v, { 3, 4, 0 }));
+
+	v.resize(6, 7);
+	assert(Equal(v, { 3, 4, 0, 7, 7, 7 }));
+	v.resize(2);
+	assert(Equal(v, { 3, 4 }));
+	v.insert(v.begin(), 2, 9);
+	assert(Equal(v, { 9, 9, 3, 4 }));
+
+	// Conversions from and to std::vector
+	std::vector<int> std_vector(10, 5);
+	Vector from_std = std_vector;
+	assert(from_std.size() == 10 && from_std == Vector(10, 5));
+	std::vector<int> back = from_std.ToVector();
+	assert(back == std_vector);
+	from_std = { 1, 2 };
+	assert(Equal(from_std, { 1, 2 }));
+	from_std.assign(std_vector.begin(), std_vector.begin() + 3);
+	assert(Equal(from_std, { 5, 5, 5 }));
+
+	// Copies and moves, inline and on the heap
+	Vector big(std_vector.begin(), std_vector.end());
+	Vector copy = big;
+	assert(copy == big && copy.data() != big.data());
+	Vector moved = std::move(copy);
+	assert(moved == big && copy.empty() && copy.IsInline());
+	Vector small = { 1, 2, 3 };
+	moved = std::move(small);
+	assert(Equal(moved, { 1, 2, 3 }) && moved.IsInline());
+	moved.swap(big);
+	assert(moved.size() == 10 && Equal(big, { 1, 2, 3 }));
+
+	assert(Vector({ 1, 2 }) < Vector({ 1, 3 }));
+	assert(Vector({ 1, 2 }) != Vector({ 1, 2, 0 }));
+	assert(Vector({ 1, 2 }) >= Vector({ 1, 2 }));
+
+	bool thrown = false;
+	try {
+		big.at(3);
+	} catch (const std::out_of_range&) {
+		thrown = true;
+	}
+	assert(thrown);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,100 @@
+#include <cassert>
+#include <cstdlib>
+#include <cstdio>
+#include "heap_usage.h"
+#include "ldb_reader.h"
+#include "reader_lcf.h"
+#include "shared_string.h"
+#include "string_pool.h"
+
+static void Shared() {
+	SharedString empty;
+	assert(empty.empty() && empty.UseCount() == 0 && empty == "");
+
+	SharedString a("Characters");
+	SharedString b = a;
+	assert(a.Shares(b) && a.UseCount() == 2 && b == "Characters");
+
+	// Assigning to a shared string leaves the others alone
+	b = "Faces";
+	assert(!a.Shares(b) && a == "Characters" && b == "Faces");
+	assert(a.UseCount() == 1 && b.UseCount() == 1);
+
+	// An unshared buffer is reused
+	const std::string* str = &b.str();
+	b = std::string("Monsters");
+	assert(&b.str() == str && b == "Monsters");
+
+	b = "";
+	assert(b.empty() && b.UseCount() == 0);
+}
+
+int main() {
+	Shared();
+
+	StringPool pool;
+	const SharedString& hero = pool.Intern("Hero", "");
+	assert(hero == "Hero");
+	assert(&pool.Intern("Hero", "") == &hero);
+	pool.Intern("Monster", "");
+	StringPool::Stats stats = pool.GetStats();
+	assert(stats.strings == 3 && stats.distinct == 2);
+	assert(stats.bytes == 15 && stats.distinct_bytes == 11);
+	assert(stats.saved_bytes == SharedString::NodeSize());
+	assert(stats.pool_bytes > 0);
+	pool.Clear();
+	assert(pool.GetStats().strings == 0 && pool.GetStats().distinct == 0);
+	assert(pool.GetStats().pool_bytes == 0);
+
+	RPG::Database db;
+	db.actors.resize(20);
+	for (size_t i = 0; i < db.actors.size(); i++) {
+		db.actors[i].ID = (int) i + 1;
+		db.actors[i].name = "Actor";
+		db.actors[i].character_name = "CharactersOfTheHeroes";
+		db.actors[i].face_name = i % 2 ? "FacesOfTheHeroes1" : "FacesOfTheHeroes2";
+	}
+	db.actors[3].title = "A title longer than sixteen bytes";
+
+	const char* file = "test_string_pool.ldb";
+	assert(LDB_Reader::Save(file, db, ""));
+
+	RPG::Database plain;
+	assert(LDB_Reader::Load(file, "", plain));
+	assert(!plain.actors[0].character_name.Shares(plain.actors[1].character_name));
+
+	LcfReader::SetStringPool(&pool);
+	assert(LcfReader::GetStringPool() == &pool);
+	RPG::Database pooled;
+	assert(LDB_Reader::Load(file, "", pooled));
+	LcfReader::SetStringPool(NULL);
+	remove(file);
+
+	// Pooled strings read the same as without pool
+	assert(pooled.actors.size() == plain.actors.size());
+	for (size_t i = 0; i < pooled.actors.size(); i++) {
+		assert(pooled.actors[i].name == plain.actors[i].name);
+		assert(pooled.actors[i].title == plain.actors[i].title);
+		assert(pooled.actors[i].character_name == "CharactersOfTheHeroes");
+		assert(pooled.actors[i].face_name == plain.actors[i].face_name);
+	}
+	assert(pooled.actors[3].title == "A title longer than sixteen bytes");
+
+	// Equal file names share one buffer
+	for (size_t i = 1; i < pooled.actors.size(); i++) {
+		assert(pooled.actors[i].character_name.Shares(pooled.actors[0].character_name));
+		assert(pooled.actors[i].face_name.Shares(pooled.actors[i % 2].face_name));
+	}
+
+	stats = pool.GetStats();
+	assert(stats.strings > stats.distinct);
+	assert(stats.saved_bytes >= 19 * SharedString::NodeSize() + 18 * SharedString::NodeSize());
+
+	// The fields keep sharing after the pool is cleared
+	pool.Clear();
+	assert(pool.GetStats().pool_bytes == 0);
+	assert(pooled.actors[0].character_name.UseCount() == 20);
+	assert(HeapUsage::Of(pooled).Bytes() + stats.saved_bytes == HeapUsage::Of(plain).Bytes());
+
+	return EXIT_SUCCESS;
+}
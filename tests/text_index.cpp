@@ -0,0 +1,124 @@
+#include <cassert>
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+#include "text_index.h"
+
+typedef RPG::EventCommand::Code Code;
+
+static RPG::EventCommand MakeCommand(int code, const std::string& string) {
+	RPG::EventCommand command;
+	command.code = code;
+	command.string = string;
+	return command;
+}
+
+static RPG::Map MakeMap(const std::string& message) {
+	RPG::Map map;
+	map.events.resize(1);
+	map.events[0].ID = 4;
+	map.events[0].pages.resize(1);
+	RPG::EventPage& page = map.events[0].pages[0];
+	page.ID = 2;
+	page.event_commands.push_back(MakeCommand(Code::Wait, "ignored text"));
+	page.event_commands.push_back(MakeCommand(Code::ShowMessage, message));
+	page.event_commands.push_back(MakeCommand(Code::ShowChoiceOption, "Yes"));
+	return map;
+}
+
+/**
+ * Compares a search with checking every string.
+ */
+static void CheckAgainstScan(const TextIndex& index, const std::vector<int>& map_ids, const std::string& text) {
+	std::vector<const TextIndex::Entry*> results;
+	index.Find(text, results);
+	size_t expected = 0;
+	for (size_t i = 0; i < map_ids.size(); i++) {
+		const std::vector<TextIndex::Entry>& entries = index.GetEntries(map_ids[i]);
+		for (size_t j = 0; j < entries.size(); j++) {
+			std::string lower = entries[j].text;
+			for (size_t k = 0; k < lower.size(); k++)
+				lower[k] = (lower[k] >= 'A' && lower[k] <= 'Z') ? lower[k] - 'A' + 'a' : lower[k];
+			if (lower.find(text) != std::string::npos)
+				expected++;
+		}
+	}
+	assert(results.size() == expected);
+}
+
+int main() {
+	RPG::Database db;
+	db.terms.gold = "Gold";
+	db.terms.new_game = "New Game";
+	db.items.resize(1);
+	db.items[0].ID = 45;
+	db.items[0].name = "Potion";
+	db.items[0].description = "Restores some gold colored hp";
+	db.commonevents.resize(1);
+	db.commonevents[0].ID = 7;
+	db.commonevents[0].event_commands.push_back(MakeCommand(Code::ShowMessage_2, "The golden gate opens."));
+
+	TextIndex index;
+	index.SetDatabase(db);
+	index.SetMap(1, MakeMap("You found 10 Gold!"));
+	index.SetMap(2, MakeMap("\xe3\x81\x93\xe3\x82\x93\xe3\x81\xab\xe3\x81\xa1\xe3\x81\xaf gold"));
+
+	std::vector<const TextIndex::Entry*> results;
+	index.Find("gold", results);
+	assert(results.size() == 5);
+	assert(results[0]->source == TextIndex::Source_terms && results[0]->text == "Gold");
+	assert(results[1]->source == TextIndex::Source_item && results[1]->event_id == 45 && results[1]->position == 0x02);
+	assert(results[2]->source == TextIndex::Source_common_event && results[2]->position == 0);
+	assert(results[3]->map_id == 1 && results[3]->event_id == 4 && results[3]->page_id == 2 && results[3]->position == 1);
+	assert(results[4]->map_id == 2);
+
+	results.clear();
+	index.FindWord("GOLD", results);
+	assert(results.size() == 4);
+
+	results.clear();
+	index.Find("\xe3\x82\x93\xe3\x81\xab", results);
+	assert(results.size() == 1 && results[0]->map_id == 2);
+
+	results.clear();
+	index.Find("ye", results);
+	assert(results.size() == 2 && results[0]->position == 2);
+
+	results.clear();
+	index.Find("ignored", results);
+	assert(results.empty());
+
+	std::vector<int> map_ids;
+	map_ids.push_back(0);
+	map_ids.push_back(1);
+	map_ids.push_back(2);
+	const char* queries[] = { "g", "ol", "old", "the golden", "xyz", "game", "s, " };
+	for (size_t i = 0; i < sizeof(queries) / sizeof(queries[0]); i++)
+		CheckAgainstScan(index, map_ids, queries[i]);
+
+	// Re-indexing one map only replaces its strings
+	index.SetMap(1, MakeMap("Nothing here"));
+	results.clear();
+	index.Find("gold", results);
+	assert(results.size() == 4);
+
+	// Save and load
+	const char* file = "test_text_index.bin";
+	assert(index.Save(file));
+	TextIndex loaded;
+	assert(loaded.Load(file));
+	remove(file);
+	results.clear();
+	loaded.Find("gold", results);
+	assert(results.size() == 4 && results[3]->map_id == 2);
+	for (size_t i = 0; i < sizeof(queries) / sizeof(queries[0]); i++)
+		CheckAgainstScan(loaded, map_ids, queries[i]);
+
+	loaded.RemoveMap(0);
+	results.clear();
+	loaded.Find("gold", results);
+	assert(results.size() == 1);
+	assert(!loaded.Load("missing_text_index.bin"));
+
+	return EXIT_SUCCESS;
+}
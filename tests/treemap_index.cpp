@@ -0,0 +1,107 @@
+#include <cassert>
+#include <cstdlib>
+#include <vector>
+#include "treemap_index.h"
+
+static void AddInfo(RPG::TreeMap& treemap, int id, int parent) {
+	RPG::MapInfo info;
+	info.ID = id;
+	info.parent_map = parent;
+	info.type = id == 0 ? 0 : 1;
+	treemap.maps.push_back(info);
+	treemap.tree_order.push_back(id);
+}
+
+int main() {
+	// 0
+	// +- 1
+	// |  +- 2
+	// |  |  +- 4
+	// |  +- 3
+	// +- 5
+	RPG::TreeMap treemap;
+	AddInfo(treemap, 0, 0);
+	AddInfo(treemap, 1, 0);
+	AddInfo(treemap, 2, 1);
+	AddInfo(treemap, 4, 2);
+	AddInfo(treemap, 3, 1);
+	AddInfo(treemap, 5, 0);
+
+	TreeMapIndex index(treemap);
+	assert(index.Get(4) == &treemap.maps[3]);
+	assert(index.Get(6) == NULL);
+	assert(index.GetParent(0) == -1);
+	assert(index.GetParent(4) == 2);
+	assert(index.GetDepth(0) == 0);
+	assert(index.GetDepth(4) == 3);
+	assert(index.GetChildren(1) == std::vector<int>({ 2, 3 }));
+	assert(index.GetChildren(0) == std::vector<int>({ 1, 5 }));
+	assert(index.GetChildren(6).empty());
+	assert(index.GetAncestors(4) == std::vector<int>({ 2, 1, 0 }));
+	assert(index.IsAncestor(1, 4));
+	assert(index.IsAncestor(0, 3));
+	assert(!index.IsAncestor(5, 4));
+	assert(!index.IsAncestor(4, 4));
+
+	// Inherited settings
+	treemap.maps[0].teleport = RPG::MapInfo::TriState_allow;
+	treemap.maps[1].music_type = RPG::MapInfo::MusicType_specific;
+	treemap.maps[1].music.name = "Town";
+	treemap.maps[1].save = RPG::MapInfo::TriState_forbid;
+	treemap.maps[2].teleport = RPG::MapInfo::TriState_forbid;
+	treemap.maps[2].background_type = RPG::MapInfo::BGMType_terrain;
+	assert(index.GetMusicInfo(4)->music.name == "Town");
+	assert(index.GetMusicInfo(5) == NULL);
+	assert(index.GetBackgroundInfo(4) == &treemap.maps[2]);
+	assert(index.GetBackgroundInfo(3) == NULL);
+	assert(index.GetTeleport(4) == RPG::MapInfo::TriState_forbid);
+	assert(index.GetTeleport(3) == RPG::MapInfo::TriState_allow);
+	assert(index.GetSave(4) == RPG::MapInfo::TriState_forbid);
+	assert(index.GetSave(5) == RPG::MapInfo::TriState_allow);
+	assert(index.GetEscape(4) == RPG::MapInfo::TriState_allow);
+
+	// Adding goes after the last descendant of the parent
+	RPG::MapInfo info;
+	info.ID = 6;
+	info.parent_map = 1;
+	RPG::MapInfo* added = index.AddMap(info);
+	assert(added != NULL && added->ID == 6 && added->indentation == 2);
+	assert(treemap.tree_order == std::vector<int>({ 0, 1, 2, 4, 3, 6, 5 }));
+	assert(index.GetChildren(1) == std::vector<int>({ 2, 3, 6 }));
+	assert(index.GetMusicInfo(6)->music.name == "Town");
+	assert(index.AddMap(info) == NULL);
+	info.ID = 7;
+	info.parent_map = 99;
+	assert(index.AddMap(info) == NULL);
+
+	// Moving takes the descendants along
+	assert(!index.SetParent(1, 4));
+	assert(!index.SetParent(0, 5));
+	assert(index.SetParent(2, 5));
+	assert(treemap.tree_order == std::vector<int>({ 0, 1, 3, 6, 5, 2, 4 }));
+	assert(index.GetAncestors(4) == std::vector<int>({ 2, 5, 0 }));
+	assert(index.Get(2)->indentation == 2 && index.Get(4)->indentation == 3);
+	assert(index.GetSave(4) == RPG::MapInfo::TriState_allow);
+	assert(index.GetMusicInfo(4) == NULL);
+
+	// Removing takes the descendants along
+	treemap.active_node = 4;
+	assert(!index.RemoveMap(0));
+	assert(index.RemoveMap(2));
+	assert(index.Get(2) == NULL && index.Get(4) == NULL);
+	assert(treemap.maps.size() == 5);
+	assert(treemap.tree_order == std::vector<int>({ 0, 1, 3, 6, 5 }));
+	assert(index.GetChildren(5).empty());
+	assert(treemap.active_node == 5);
+
+	// Cycles in broken files do not hang
+	RPG::TreeMap broken;
+	AddInfo(broken, 0, 0);
+	AddInfo(broken, 1, 2);
+	AddInfo(broken, 2, 1);
+	TreeMapIndex broken_index(broken);
+	assert(broken_index.GetDepth(1) >= 0 && broken_index.GetDepth(2) >= 0);
+	assert(broken_index.GetAncestors(1).size() <= 1);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,213 @@
+#include <cassert>
+#include <cfloat>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "reader_xml.h"
+#include "writer_xml.h"
+
+static void ReadIntegers() {
+	int i = -1;
+	XmlReader::Read<int>(i, "42");
+	assert(i == 42);
+	XmlReader::Read<int>(i, "\n  -17 \n");
+	assert(i == -17);
+	XmlReader::Read<int>(i, "+8abc");
+	assert(i == 8);
+	XmlReader::Read<int>(i, "");
+	assert(i == 0);
+	XmlReader::Read<int>(i, "99999999999");
+	assert(i == 2147483647);
+	XmlReader::Read<int>(i, "-2147483648");
+	assert(i == -2147483647 - 1);
+
+	int16_t s = 0;
+	XmlReader::Read<int16_t>(s, "-40000");
+	assert(s == -32768);
+	XmlReader::Read<int16_t>(s, "10000");
+	assert(s == 10000);
+
+	uint8_t b = 0;
+	XmlReader::Read<uint8_t>(b, "200");
+	assert(b == 200);
+
+	uint32_t u = 0;
+	XmlReader::Read<uint32_t>(u, "4294967295");
+	assert(u == 4294967295U);
+
+	bool t = false;
+	XmlReader::Read<bool>(t, " T ");
+	assert(t);
+	XmlReader::Read<bool>(t, "TF");
+	assert(!t);
+}
+
+static void ReadDoubles() {
+	const char* values[] = {
+		"0", "-0.5", "42000.6875", "0.1", "3.141592653589793",
+		"1e22", "1.5e-7", "123456789012345678", "2.2250738585072014e-308", "1e300"
+	};
+	for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+		double d = -1.0;
+		XmlReader::Read<double>(d, values[i]);
+		assert(d == strtod(values[i], NULL));
+	}
+}
+
+/**
+ * Writes doubles with XmlWriter and reads them back with XmlReader.
+ */
+static void RoundTripDoubles() {
+	std::vector<double> values;
+	for (int i = 1; i < 2000; i++) {
+		// Up to 15 digits, read by the fast path
+		values.push_back(i / 8.0);
+		values.push_back(-i * 0.25 + 1e6);
+		// Long mantissas, written with 16 or 17 digits
+		values.push_back(i / 7.0 * (i % 2 ? 1e-5 : 1e5));
+		// Exponents outside of the exact powers of ten up to 1e22
+		values.push_back(i / 3.0 * 1e30);
+		values.push_back(-i / 11.0 * 1e-40);
+		values.push_back(i * 1e23);
+	}
+	values.push_back(0.0);
+	values.push_back(DBL_MAX);
+	values.push_back(DBL_MIN);
+	values.push_back(4.9406564584124654e-324);
+
+	const char* file = "test_xml_reader_doubles.xml";
+	{
+		XmlWriter writer(file);
+		assert(writer.IsOk());
+		for (size_t i = 0; i < values.size(); i++)
+			writer.WriteNode<double>("d", values[i]);
+	}
+
+	std::string text;
+	FILE* stream = fopen(file, "rb");
+	assert(stream != NULL);
+	char buf[4096];
+	for (size_t n; (n = fread(buf, 1, sizeof(buf), stream)) > 0; )
+		text.append(buf, n);
+	fclose(stream);
+	remove(file);
+
+	size_t pos = 0;
+	for (size_t i = 0; i < values.size(); i++) {
+		size_t begin = text.find("<d>", pos);
+		assert(begin != std::string::npos);
+		begin += 3;
+		size_t end = text.find("</d>", begin);
+		assert(end != std::string::npos);
+		double r = -1.0;
+		XmlReader::Read<double>(r, text.substr(begin, end - begin));
+		assert(r == values[i]);
+		pos = end;
+	}
+}
+
+static void ReadVectors() {
+	std::vector<int16_t> v;
+	XmlReader::Read<std::vector<int16_t> >(v, " 1 -2\n3\t 4000  ");
+	assert(v.size() == 4);
+	assert(v[0] == 1 && v[1] == -2 && v[2] == 3 && v[3] == 4000);
+	XmlReader::Read<std::vector<int16_t> >(v, "");
+	assert(v.empty());
+
+	std::vector<bool> flags;
+	XmlReader::Read<std::vector<bool> >(flags, "T F T");
+	assert(flags.size() == 3 && flags[0] && !flags[1] && flags[2]);
+}
+
+#if defined(LCF_SUPPORT_XML)
+class CountXmlHandler : public XmlHandler {
+public:
+	CountXmlHandler(int& elements, std::string& text) : elements(elements), text(text) {}
+
+	void StartElement(XmlReader& /* stream */, const char* /* name */, const char** /* atts */) {
+		elements++;
+	}
+	void CharacterData(XmlReader& /* stream */, const std::string& data) {
+		text += data;
+	}
+private:
+	int& elements;
+	std::string& text;
+};
+
+/** Counts its destructions. */
+class OwnedXmlHandler : public XmlHandler {
+public:
+	OwnedXmlHandler(int& destroyed) : destroyed(destroyed) {}
+	~OwnedXmlHandler() {
+		destroyed++;
+	}
+
+	void StartElement(XmlReader& /* stream */, const char* /* name */, const char** /* atts */) {
+		elements++;
+	}
+
+	int elements = 0;
+private:
+	int& destroyed;
+};
+
+static void ParseCallerHandlers() {
+	const char doc[] = "<LMU><a>1</a><b><c/></b></LMU>";
+	int destroyed = 0;
+	{
+		// A handler not made by MakeHandler stays the caller's
+		OwnedXmlHandler root(destroyed);
+		OwnedXmlHandler* child = new OwnedXmlHandler(destroyed);
+		{
+			XmlReader reader(doc, strlen(doc));
+			reader.SetHandler(&root);
+			reader.Parse();
+			assert(root.elements == 4);
+			reader.SetHandler(child);
+		}
+		assert(destroyed == 0);
+		delete child;
+		assert(destroyed == 1);
+	}
+	assert(destroyed == 2);
+}
+
+static void ParseMemory() {
+	const char doc[] = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+		"<LMU><a>1</a><b>two &amp; three</b><c><d>4</d></c></LMU>";
+
+	// Slicing the document must not change what the handlers see
+	std::string expected;
+	const size_t chunk_sizes[] = { 0, 1, 7, 4096 };
+	for (size_t i = 0; i < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); i++) {
+		int elements = 0;
+		std::string text;
+		XmlReader reader(doc, strlen(doc));
+		assert(reader.IsOk());
+		reader.SetChunkSize(chunk_sizes[i]);
+		reader.SetHandler(reader.MakeHandler<CountXmlHandler>(elements, text));
+		reader.Parse();
+		assert(elements == 5);
+		assert(text.find("two & three") != std::string::npos);
+		if (i == 0)
+			expected = text;
+		assert(text == expected);
+	}
+}
+#endif
+
+int main() {
+	ReadIntegers();
+	ReadDoubles();
+	RoundTripDoubles();
+	ReadVectors();
+#if defined(LCF_SUPPORT_XML)
+	ParseMemory();
+	ParseCallerHandlers();
+#endif
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+#include <cassert>
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+#include "xref_index.h"
+
+typedef RPG::EventCommand::Code Code;
+
+static RPG::EventCommand MakeCommand(int code, int p0 = 0, int p1 = 0, int p2 = 0, int p3 = 0, int p4 = 0, int p5 = 0) {
+	RPG::EventCommand command;
+	command.code = code;
+	int params[] = { p0, p1, p2, p3, p4, p5 };
+	command.parameters.assign(params, params + 6);
+	return command;
+}
+
+static RPG::Map MakeMap(int switch_id) {
+	RPG::Map map;
+	map.events.resize(1);
+	map.events[0].ID = 3;
+	map.events[0].pages.resize(1);
+	RPG::EventPage& page = map.events[0].pages[0];
+	page.ID = 1;
+	page.condition.flags.switch_a = true;
+	page.condition.switch_a_id = switch_id;
+	page.event_commands.push_back(MakeCommand(Code::ControlSwitches, 1, 10, 12));
+	page.event_commands.push_back(MakeCommand(Code::ChangeItems, 0, 0, 45, 1, 7));
+	page.event_commands.push_back(MakeCommand(Code::CallEvent, 0, 7));
+	RPG::EventCommand message;
+	message.code = Code::ShowMessage;
+	message.string = "Gold: \\V[8] \\V[x]";
+	page.event_commands.push_back(message);
+	return map;
+}
+
+int main() {
+	RPG::Database db;
+	db.commonevents.resize(1);
+	db.commonevents[0].ID = 7;
+	db.commonevents[0].switch_flag = true;
+	db.commonevents[0].switch_id = 123;
+	db.commonevents[0].event_commands.push_back(MakeCommand(Code::ConditionalBranch, 0, 123));
+	db.commonevents[0].event_commands.push_back(MakeCommand(Code::ControlVars, 0, 5, 0, 0, 4, 45));
+	db.commonevents[0].event_commands.push_back(MakeCommand(Code::ChangeEventLocation, 10001, 1, 20, 21, 22));
+	db.commonevents[0].event_commands.push_back(MakeCommand(Code::SetVehicleLocation, 0, 1, 30, 31, 32));
+
+	XrefIndex index;
+	index.SetDatabase(db);
+	index.SetMap(1, MakeMap(123));
+	index.SetMap(2, MakeMap(200));
+
+	const std::vector<XrefIndex::Reference>& switch_123 = index.Find(XrefIndex::Kind_switch, 123);
+	assert(switch_123.size() == 3);
+	assert(switch_123[0].source == XrefIndex::Source_common_event && switch_123[0].event_id == 7);
+	assert(switch_123[0].command == -1 && switch_123[1].command == 0);
+	assert(switch_123[2].map_id == 1 && switch_123[2].event_id == 3 && switch_123[2].page_id == 1);
+
+	assert(index.Find(XrefIndex::Kind_switch, 11).size() == 2);
+	assert(index.Find(XrefIndex::Kind_switch, 11)[0].access == XrefIndex::Access_write);
+	assert(index.Find(XrefIndex::Kind_switch, 13).empty());
+
+	const std::vector<XrefIndex::Reference>& item_45 = index.Find(XrefIndex::Kind_item, 45);
+	assert(item_45.size() == 3);
+	assert(item_45[0].access == XrefIndex::Access_read && item_45[1].access == XrefIndex::Access_write);
+	assert(index.Find(XrefIndex::Kind_variable, 7).size() == 2);
+	assert(index.Find(XrefIndex::Kind_variable, 8).size() == 2);
+	assert(index.Find(XrefIndex::Kind_common_event, 7).size() == 2);
+	assert(index.Find(XrefIndex::Kind_common_event, 7)[0].command == 2);
+
+	// Event locations read x and y from variables, not the direction
+	assert(index.Find(XrefIndex::Kind_variable, 20).size() == 1);
+	assert(index.Find(XrefIndex::Kind_variable, 21).size() == 1);
+	assert(index.Find(XrefIndex::Kind_variable, 22).empty());
+	assert(index.Find(XrefIndex::Kind_variable, 32).size() == 1);
+	assert(index.Find(XrefIndex::Kind_variable, 32)[0].access == XrefIndex::Access_read);
+
+	// Re-indexing one map only replaces its references
+	index.SetMap(1, MakeMap(200));
+	assert(index.Find(XrefIndex::Kind_switch, 123).size() == 2);
+	assert(index.Find(XrefIndex::Kind_switch, 200).size() == 2);
+	assert(index.Find(XrefIndex::Kind_item, 45).size() == 3);
+
+	// Save and load
+	const char* file = "test_xref_index.bin";
+	assert(index.Save(file));
+	XrefIndex loaded;
+	assert(loaded.Load(file));
+	remove(file);
+	assert(loaded.GetReferences(2).size() == index.GetReferences(2).size());
+	assert(loaded.Find(XrefIndex::Kind_switch, 200).size() == 2);
+	assert(loaded.Find(XrefIndex::Kind_common_event, 7)[0].command == 2);
+	assert(loaded.Find(XrefIndex::Kind_switch, 123)[0].command == -1);
+
+	loaded.RemoveMap(2);
+	assert(loaded.Find(XrefIndex::Kind_switch, 200).size() == 1);
+	loaded.RemoveMap(0);
+	assert(loaded.Find(XrefIndex::Kind_switch, 123).empty());
+	assert(!loaded.Load("missing_xref_index.bin"));
+
+	return EXIT_SUCCESS;
+}